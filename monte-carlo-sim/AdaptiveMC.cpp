@@ -0,0 +1,156 @@
+#include "AdaptiveMC.hpp"
+#include "Range.cpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+
+// parameter constructor
+AdaptiveMC::AdaptiveMC(OptionData& option, double spot, long nSteps, double (*driftFunction)(double, double), double (*diffusionFunction)(double, double), NormalGenerator& generator)
+{
+	data = &option;
+	S0 = spot;
+	N = nSteps;
+	drift = driftFunction;
+	diffusion = diffusionFunction;
+	normal = &generator;
+	batch = 5000;
+	minPaths = 1000;
+	progress = nullptr;
+	cancelled = nullptr;
+}
+
+// destructor
+AdaptiveMC::~AdaptiveMC() { }
+
+void AdaptiveMC::batchSize(long paths)
+{
+	batch = (paths > 0) ? paths : 1;
+}
+
+void AdaptiveMC::minimumPaths(long paths)
+{
+	minPaths = paths;
+}
+
+void AdaptiveMC::progressCallback(std::function<void(const MCResult&)> callback)
+{
+	progress = callback;
+}
+
+void AdaptiveMC::cancelWhen(std::function<bool()> check)
+{
+	cancelled = check;
+}
+
+MCStatistics AdaptiveMC::runPaths(long nPaths) const
+{ // same scheme as TestMC, explicit Euler on the time mesh of [0, T]
+	Range<double> range(0.0, data->T);
+	RangeMesh<double> x = range.meshView(N);
+	double k = x.step();
+	double sqrk = sqrt(k);
+
+	MCStatistics stats;
+
+	for (long i = 0; i < nPaths; ++i)
+	{
+		double VOld = S0;
+		double VNew = S0;
+
+		for (long index = 1; index < x.size(); ++index)
+		{
+			double dW = normal->getNormal();
+			VNew = VOld + (k * drift(x[index-1], VOld)) + (sqrk * diffusion(x[index-1], VOld) * dW);
+			VOld = VNew;
+		}
+
+		stats.add(data->myPayOffFunction(VNew));
+	}
+
+	return stats;
+}
+
+MCResult AdaptiveMC::run(double targetSE, double targetRel, long maxPaths, double maxSeconds)
+{ // batches until a target is met, the error is checked on the merged statistics after every batch
+	typedef std::chrono::steady_clock clock;
+	clock::time_point start = clock::now();
+
+	const long pilotPaths = 100;
+	double discount = exp(-data->r * data->T);
+	MCStatistics total;
+	MCResult result;
+	result.reason = MC_MAX_PATHS;
+
+	while (total.count() < maxPaths)
+	{
+		// cancellation and the budget are checked before any work, a job cancelled while queued runs no paths
+		if (cancelled && cancelled())
+		{
+			result.reason = MC_CANCELLED;
+			break;
+		}
+
+		double elapsed = std::chrono::duration<double>(clock::now() - start).count();
+		if (elapsed >= maxSeconds)
+		{
+			result.reason = MC_TIME_BUDGET;
+			break;
+		}
+
+		// short pilot batch first to time a path, later batches end on multiples of the batch size
+		long paths = (total.count() == 0) ? std::min(batch, pilotPaths) : batch - total.count() % batch;
+		paths = std::min(paths, maxPaths - total.count());
+
+		if (total.count() > 0)
+		{ // predictable latency, shrink the batch to the paths expected to fit in the rest of the budget
+			double perPath = elapsed / double(total.count());
+			double fit = std::floor((maxSeconds - elapsed) / perPath);
+			if (fit < 1.0)
+			{
+				result.reason = MC_TIME_BUDGET;
+				break;
+			}
+			if (fit < double(paths)) { paths = long(fit); }
+		}
+
+		total.merge(runPaths(paths));
+
+		elapsed = std::chrono::duration<double>(clock::now() - start).count();
+		double price = total.mean() * discount;
+		double se = total.standardError() * discount;
+
+		if (progress)
+		{
+			MCResult partial = { price, se, total.count(), elapsed, MC_MAX_PATHS };
+			progress(partial);
+		}
+
+		if (total.count() >= minPaths && (se <= targetSE || (price != 0.0 && se <= targetRel * std::abs(price))))
+		{
+			result.reason = MC_TARGET_MET;
+			break;
+		}
+	}
+
+	result.price = total.mean() * discount;
+	result.standardError = total.standardError() * discount;
+	result.paths = total.count();
+	result.seconds = std::chrono::duration<double>(clock::now() - start).count();
+
+	return result;
+}
+
+MCResult AdaptiveMC::runToError(double targetSE, long maxPaths, double maxSeconds)
+{
+	return run(targetSE, -1.0, maxPaths, maxSeconds);
+}
+
+MCResult AdaptiveMC::runToRelativeError(double targetRel, long maxPaths, double maxSeconds)
+{
+	return run(-1.0, targetRel, maxPaths, maxSeconds);
+}
+
+MCResult AdaptiveMC::runForTime(double maxSeconds)
+{
+	return run(-1.0, -1.0, std::numeric_limits<long>::max(), maxSeconds);
+}
\ No newline at end of file
@@ -0,0 +1,60 @@
+#ifndef AdaptiveMC_HPP
+#define AdaptiveMC_HPP
+
+#include "OptionData.hpp"
+#include "NormalGenerator.hpp"
+#include "MCStatistics.hpp"
+#include <functional>
+
+// why an adaptive run stopped
+enum MCStopReason
+{
+	MC_TARGET_MET,		// standard error (or relative error) target reached
+	MC_MAX_PATHS,		// path limit reached first
+	MC_TIME_BUDGET,		// not even one more path would fit in the time budget
+	MC_CANCELLED		// the cancellation check returned true
+};
+
+struct MCResult
+{ // discounted price and its error, with how the run ended
+
+	double price;
+	double standardError;
+	long paths;
+	double seconds;
+	MCStopReason reason;
+};
+
+class AdaptiveMC
+{ // 1 factor explicit Euler MC run in batches of paths until an error target or a time budget is met
+	private:
+		OptionData* data;
+		double S0;
+		long N;										// number of subintervals in time
+		double (*drift)(double t, double X);
+		double (*diffusion)(double t, double X);
+		NormalGenerator* normal;
+		long batch;									// paths between convergence checks
+		long minPaths;								// never stop on the error target before this many paths
+		std::function<void(const MCResult&)> progress;	// called after every batch with the result so far
+		std::function<bool()> cancelled;			// polled before every batch, true stops the run
+
+		MCResult run(double targetSE, double targetRel, long maxPaths, double maxSeconds);
+
+	public:
+		AdaptiveMC(OptionData& option, double spot, long nSteps, double (*driftFunction)(double, double), double (*diffusionFunction)(double, double), NormalGenerator& generator);	// parameter constructor
+		virtual ~AdaptiveMC();						// destructor
+
+		void batchSize(long paths);					// paths per batch, default 5000, the first batch is a short pilot that times the paths
+		void minimumPaths(long paths);				// default 1000, guards against a lucky early variance estimate
+		void progressCallback(std::function<void(const MCResult&)> callback);	// replaces printing progress from inside the run
+		void cancelWhen(std::function<bool()> check);	// e.g. a cancellation token of the job running this simulation
+
+		MCStatistics runPaths(long nPaths) const;	// one batch, statistics of the undiscounted payoffs
+
+		MCResult runToError(double targetSE, long maxPaths, double maxSeconds);				// stop once the price standard error <= targetSE
+		MCResult runToRelativeError(double targetRel, long maxPaths, double maxSeconds);	// stop once standard error / price <= targetRel
+		MCResult runForTime(double maxSeconds);												// as many paths as fit in the budget
+};
+
+#endif // AdaptiveMC_HPP
\ No newline at end of file
@@ -0,0 +1,81 @@
+#include "OptionData.hpp"
+#include "NormalGenerator.hpp"
+#include "AdaptiveMC.hpp"
+#include "../option-pricing-boost-cpp/JobExecutor.hpp"
+#include <cmath>
+#include <future>
+#include <iostream>
+
+/*
+Adaptive MC runs as batch jobs on the pricing engine's JobExecutor, with progress reports and cancellation.
+A separate driver so TestMC stays a standalone build, this one also links ../option-pricing-boost-cpp/JobExecutor.cpp.
+
+	BackgroundMC		run one job cancelled after three batches and one cancelled while still queued
+
+The option is the TestMC one: K = 100, T = 1, r = 0, sig = 0.2, S_0 = 100, call, 100 time steps.
+*/
+
+namespace
+{
+	const double S_0 = 100.0;
+	const long N = 100;
+
+	OptionData* data;
+
+	double drift(double t, double X)
+	{ // drift term
+		return (data->r)*X;
+	}
+
+	double diffusion(double t, double X)
+	{ // diffusion term, GBM
+		return data->sig * X;
+	}
+}
+
+int main()
+{
+	using namespace AidanRicher::Engine;
+
+	OptionData myOption;
+	myOption.K = 100.0;
+	myOption.T = 1.0;
+	myOption.r = 0.0;
+	myOption.sig = 0.2;
+	myOption.D = 0.0;
+	myOption.H = 0.0;
+	myOption.type = 1;
+	data = &myOption;
+
+	BoostNormal normal;
+	JobExecutor executor(1);
+
+	// the job reports after every batch and is cancelled through its token after the third one
+	CancellationToken token;
+	long batches = 0;
+
+	AdaptiveMC background(myOption, S_0, N, drift, diffusion, normal);
+	background.progressCallback([&batches, token](const MCResult& partial) mutable {
+		std::cout << "Paths: " << partial.paths << ", price so far: " << partial.price << ", Standard Error: " << partial.standardError << std::endl;
+		if (++batches == 3) { token.Cancel(); }
+	});
+	background.cancelWhen([token]() { return token.IsCancelled(); });
+
+	std::future<MCResult> job = executor.Submit(PRIORITY_BATCH, [&background]() { return background.runToError(0.0, 1000000, 60.0); });
+	MCResult stopped = job.get();
+
+	std::cout << "Background job " << (stopped.reason == MC_CANCELLED ? "cancelled" : "finished") << " after " << stopped.paths
+		<< " paths, price so far: " << stopped.price << std::endl;
+
+	// cancelled before a worker picks it up, no paths are simulated
+	CancellationToken early;
+	early.Cancel();
+
+	AdaptiveMC queued(myOption, S_0, N, drift, diffusion, normal);
+	queued.cancelWhen([early]() { return early.IsCancelled(); });
+
+	MCResult skipped = executor.Submit(PRIORITY_BATCH, [&queued]() { return queued.runToError(0.0, 1000000, 60.0); }).get();
+	std::cout << "Job cancelled while queued: " << (skipped.reason == MC_CANCELLED ? "cancelled" : "finished") << " after " << skipped.paths << " paths" << std::endl;
+
+	return 0;
+}
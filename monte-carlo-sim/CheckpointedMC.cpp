@@ -0,0 +1,119 @@
+#include "CheckpointedMC.hpp"
+#include "Range.cpp"
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+// parameter constructor
+CheckpointedMC::CheckpointedMC(OptionData& option, double spot, long nSteps, double (*driftFunction)(double, double), double (*diffusionFunction)(double, double), uint64_t seed, const std::string& checkpointFile) : normal(seed)
+{
+	data = &option;
+	S0 = spot;
+	N = nSteps;
+	drift = driftFunction;
+	diffusion = diffusionFunction;
+	file = checkpointFile;
+	every = 10000;
+	state.seed = seed;
+	state.settings = runSettings(option, spot, nSteps);
+}
+
+// destructor
+CheckpointedMC::~CheckpointedMC() { }
+
+void CheckpointedMC::checkpointEvery(long paths)
+{
+	every = (paths > 0) ? paths : 1;
+}
+
+bool CheckpointedMC::resume()
+{
+	if (file.empty() || !std::ifstream(file.c_str()).good())
+	{
+		return false;
+	}
+
+	PartialResult saved = readPartial(file);
+	if (saved.seed != state.seed || saved.settings != runSettings(*data, S0, N) || saved.firstPath != 0)
+	{ // a different run, starting over is the only consistent choice
+		return false;
+	}
+
+	state = saved;
+	return true;
+}
+
+void CheckpointedMC::checkpoint() const
+{
+	if (!file.empty())
+	{
+		writePartial(file, state);
+	}
+}
+
+MCResult CheckpointedMC::run(long totalPaths)
+{
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	double before = state.seconds;
+
+	uint64_t settings = runSettings(*data, S0, N);
+	if (state.nPaths > 0 && state.settings != settings)
+	{ // the option is held by reference and was changed after the first paths
+		throw std::logic_error("Run settings changed since the checkpointed paths were simulated.");
+	}
+	state.settings = settings;
+
+	Range<double> range(0.0, data->T);
+	RangeMesh<double> x = range.meshView(N);
+	double k = x.step();
+	double sqrk = sqrt(k);
+	std::vector<double> dW(N);
+
+	for (uint64_t p = state.nPaths; p < uint64_t(totalPaths); ++p)
+	{
+		normal.normals(p, 0, N, dW.data());
+
+		double VOld = S0;
+		double VNew = S0;
+		for (long index = 1; index < x.size(); ++index)
+		{
+			VNew = VOld + (k * drift(x[index-1], VOld)) + (sqrk * diffusion(x[index-1], VOld) * dW[index-1]);
+			VOld = VNew;
+		}
+
+		state.payoff.add(data->myPayOffFunction(VNew));
+		state.nPaths = p + 1;
+
+		if (state.nPaths % uint64_t(every) == 0)
+		{
+			state.seconds = before + std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+			checkpoint();
+		}
+	}
+
+	state.seconds = before + std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	checkpoint();
+
+	return result();
+}
+
+long CheckpointedMC::pathsDone() const
+{
+	return long(state.nPaths);
+}
+
+MCResult CheckpointedMC::result() const
+{
+	double discount = exp(-data->r * data->T);
+
+	MCResult r;
+	r.price = state.payoff.mean() * discount;
+	r.standardError = state.payoff.standardError() * discount;
+	r.paths = long(state.nPaths);
+	r.seconds = state.seconds;		// total over all sessions
+	r.reason = MC_MAX_PATHS;
+
+	return r;
+}
\ No newline at end of file
@@ -0,0 +1,39 @@
+#ifndef CheckpointedMC_HPP
+#define CheckpointedMC_HPP
+
+#include "OptionData.hpp"
+#include "NormalGenerator.hpp"
+#include "PartialResult.hpp"
+#include "AdaptiveMC.hpp"
+#include <string>
+
+class CheckpointedMC
+{ // 1 factor explicit Euler MC that can be interrupted and resumed, or extended with more paths
+  // path p always uses the Philox normals (p, 0 .. N-1), so the generator state is just the next path index,
+  // and a checkpoint is a PartialResult file: seed, run settings, paths done and the running payoff statistics
+	private:
+		OptionData* data;
+		double S0;
+		long N;
+		double (*drift)(double t, double X);
+		double (*diffusion)(double t, double X);
+		PhiloxNormal normal;
+		std::string file;					// checkpoint file, empty for none
+		long every;							// paths between checkpoints
+		PartialResult state;				// everything simulated so far
+
+	public:
+		CheckpointedMC(OptionData& option, double spot, long nSteps, double (*driftFunction)(double, double), double (*diffusionFunction)(double, double), uint64_t seed, const std::string& checkpointFile);	// parameter constructor
+		virtual ~CheckpointedMC();			// destructor
+
+		void checkpointEvery(long paths);	// default 10000
+		bool resume();						// load the checkpoint file if it exists and has the same seed and run settings, true if loaded
+		void checkpoint() const;			// write the current state now
+
+		MCResult run(long totalPaths);		// simulate until totalPaths paths are done, starting from the current state
+											// throws std::logic_error if the option, spot or steps changed since those paths
+		long pathsDone() const;
+		MCResult result() const;			// discounted price and standard error of the paths done
+};
+
+#endif // CheckpointedMC_HPP
\ No newline at end of file
@@ -0,0 +1,173 @@
+#include "OptionData.hpp"
+#include "NormalGenerator.hpp"
+#include "PartialResult.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <sys/wait.h>
+#include <unistd.h>
+
+/*
+Multi-process MC, every worker prices a disjoint range of paths and writes a 128 byte partial result.
+Paths are drawn from PhiloxNormal keyed on (path, step), so any split over processes or hosts gives the
+same paths as one serial run.
+
+	DistributedMC worker <seed> <firstPath> <nPaths> <steps> <file>	one worker, e.g. started by a scheduler on any host
+	DistributedMC merge <file> [<file> ...]						final price, standard error and greeks
+	DistributedMC launch <workers> <nPaths> <steps> <dir>			fork local workers, wait, merge (scaling check)
+
+The option is the TestMC one: K = 100, T = 1, r = 0, sig = 0.2, S_0 = 100, call.
+*/
+
+namespace
+{
+	const double S_0 = 100.0;
+
+	OptionData defaultOption()
+	{
+		OptionData myOption;
+		myOption.K = 100.0;
+		myOption.T = 1.0;
+		myOption.r = 0.0;
+		myOption.sig = 0.2;
+		myOption.D = 0.0;
+		myOption.H = 0.0;
+		myOption.type = 1;
+		return myOption;
+	}
+
+	PartialResult runWorker(uint64_t seed, uint64_t firstPath, uint64_t nPaths, long steps)
+	{ // exact GBM steps, pathwise delta S_T / S_0 * 1{in the money} and vega dS_T/dsig * 1{in the money}
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+		OptionData myOption = defaultOption();
+		PhiloxNormal normal(seed);
+
+		double k = myOption.T / double(steps);
+		double mu = (myOption.r - 0.5 * myOption.sig * myOption.sig) * k;
+		std::vector<double> z(steps);
+
+		PartialResult result;
+		result.seed = seed;
+		result.settings = runSettings(myOption, S_0, steps);
+		result.firstPath = firstPath;
+		result.nPaths = nPaths;
+
+		for (uint64_t p = firstPath; p < firstPath + nPaths; ++p)
+		{
+			normal.normals(p, 0, steps, z.data());
+
+			double W = 0.0;
+			for (long i = 0; i < steps; ++i)
+			{
+				W += sqrt(k) * z[i];
+			}
+			double ST = S_0 * exp(mu * double(steps) + myOption.sig * W);
+
+			double itm = (myOption.type * (ST - myOption.K) > 0.0) ? double(myOption.type) : 0.0;
+			result.payoff.add(myOption.myPayOffFunction(ST));
+			result.delta.add(itm * ST / S_0);
+			result.vega.add(itm * ST * (W - myOption.sig * myOption.T));
+		}
+
+		result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		return result;
+	}
+
+	void report(const PartialResult& total)
+	{
+		OptionData myOption = defaultOption();
+		double discount = exp(-myOption.r * myOption.T);
+
+		std::cout << "Paths: " << total.nPaths << std::endl;
+		std::cout << "Price, after discounting: " << total.payoff.mean() * discount << std::endl;
+		std::cout << "Standard Error: " << total.payoff.standardError() * discount << std::endl;
+		std::cout << "Delta: " << total.delta.mean() * discount << " (" << total.delta.standardError() * discount << ")" << std::endl;
+		std::cout << "Vega: " << total.vega.mean() * discount << " (" << total.vega.standardError() * discount << ")" << std::endl;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	std::string mode = (argc > 1) ? argv[1] : "";
+
+	try
+	{
+		if (mode == "worker" && argc == 7)
+		{
+			PartialResult result = runWorker(std::strtoull(argv[2], 0, 10), std::strtoull(argv[3], 0, 10), std::strtoull(argv[4], 0, 10), std::atol(argv[5]));
+			writePartial(argv[6], result);
+			return 0;
+		}
+
+		if (mode == "merge" && argc > 2)
+		{
+			report(mergePartials(std::vector<std::string>(argv + 2, argv + argc)));
+			return 0;
+		}
+
+		if (mode == "launch" && argc == 6 && std::atol(argv[2]) > 0)
+		{
+			long workers = std::atol(argv[2]);
+			uint64_t nPaths = std::strtoull(argv[3], 0, 10);
+			long steps = std::atol(argv[4]);
+			std::string dir = argv[5];
+			std::vector<std::string> files;
+
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+			for (long w = 0; w < workers; ++w)
+			{ // even split, the first workers take the remainder
+				uint64_t share = nPaths / workers + (uint64_t(w) < nPaths % workers ? 1 : 0);
+				uint64_t first = uint64_t(w) * (nPaths / workers) + std::min<uint64_t>(w, nPaths % workers);
+				files.push_back(dir + "/part" + std::to_string(w) + ".mcp");
+
+				pid_t pid = fork();
+				if (pid == 0)
+				{
+					writePartial(files.back(), runWorker(2025, first, share, steps));
+					_exit(0);
+				}
+				if (pid < 0)
+				{
+					std::cout << "Cannot start worker " << w << std::endl;
+					return 1;
+				}
+			}
+
+			int status;
+			int failed = 0;
+			while (wait(&status) > 0)
+			{
+				if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+				{
+					failed++;
+				}
+			}
+			if (failed > 0)
+			{
+				std::cout << failed << " worker(s) failed." << std::endl;
+				return 1;
+			}
+
+			double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+			PartialResult total = mergePartials(files);
+			report(total);
+			std::cout << "Workers: " << workers << ", wall time: " << seconds << " s, slowest worker: " << total.seconds << " s" << std::endl;
+			return 0;
+		}
+	}
+	catch (const std::exception& e)
+	{
+		std::cout << "Error: " << e.what() << std::endl;
+		return 1;
+	}
+
+	std::cout << "Usage: DistributedMC worker <seed> <firstPath> <nPaths> <steps> <file>\n"
+		<< "       DistributedMC merge <file> [<file> ...]\n"
+		<< "       DistributedMC launch <workers> <nPaths> <steps> <dir>" << std::endl;
+	return 1;
+}
\ No newline at end of file
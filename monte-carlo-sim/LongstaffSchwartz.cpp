@@ -0,0 +1,318 @@
+#include "LongstaffSchwartz.hpp"
+#include "NormalGenerator.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <thread>
+
+namespace
+{
+	const int BASIS = 4;	// 1, x, x^2, x^3
+
+	struct NormalEquations
+	{ // A^T A and A^T y over the in the money paths of one chunk
+		double ata[BASIS][BASIS];
+		double aty[BASIS];
+
+		void clear()
+		{
+			std::fill(&ata[0][0], &ata[0][0] + BASIS * BASIS, 0.0);
+			std::fill(aty, aty + BASIS, 0.0);
+		}
+	};
+
+	void solve(NormalEquations& eq, double* beta)
+	{ // Gaussian elimination with partial pivoting, a singular system gives beta = 0 (never exercise early)
+		double a[BASIS][BASIS + 1];
+		for (int i = 0; i < BASIS; ++i)
+		{
+			for (int j = 0; j < BASIS; ++j)
+			{
+				a[i][j] = eq.ata[i][j];
+			}
+			a[i][BASIS] = eq.aty[i];
+		}
+
+		for (int c = 0; c < BASIS; ++c)
+		{
+			int pivot = c;
+			for (int i = c + 1; i < BASIS; ++i)
+			{
+				if (std::abs(a[i][c]) > std::abs(a[pivot][c]))
+				{
+					pivot = i;
+				}
+			}
+			if (std::abs(a[pivot][c]) < 1e-12)
+			{
+				std::fill(beta, beta + BASIS, 0.0);
+				return;
+			}
+			for (int j = 0; j <= BASIS; ++j)
+			{
+				std::swap(a[c][j], a[pivot][j]);
+			}
+			for (int i = c + 1; i < BASIS; ++i)
+			{
+				double f = a[i][c] / a[c][c];
+				for (int j = c; j <= BASIS; ++j)
+				{
+					a[i][j] -= f * a[c][j];
+				}
+			}
+		}
+
+		for (int i = BASIS - 1; i >= 0; --i)
+		{
+			double sum = a[i][BASIS];
+			for (int j = i + 1; j < BASIS; ++j)
+			{
+				sum -= a[i][j] * beta[j];
+			}
+			beta[i] = sum / a[i][i];
+		}
+	}
+
+	void parallelFor(long nChunks, unsigned threads, const std::function<void(long)>& body)
+	{ // chunks handed out by an atomic counter, the work per chunk does not depend on which thread runs it
+		std::atomic<long> next(0);
+		std::vector<std::thread> pool;
+
+		for (unsigned t = 0; t < threads; ++t)
+		{
+			pool.push_back(std::thread([&]()
+			{
+				for (long c = next++; c < nChunks; c = next++)
+				{
+					body(c);
+				}
+			}));
+		}
+		for (size_t t = 0; t < pool.size(); ++t)
+		{
+			pool[t].join();
+		}
+	}
+}
+
+// parameter constructor
+LongstaffSchwartz::LongstaffSchwartz(const OptionData& option, double spot, long dates, long paths, LSMPathStorage mode)
+{
+	data = option;
+	S0 = spot;
+	M = (dates > 0) ? dates : 1;
+	P = (paths > 0) ? paths : 1;
+	storage = mode;
+	seed = 5489;
+	chunk = 16384;
+	threads = 0;
+}
+
+// destructor
+LongstaffSchwartz::~LongstaffSchwartz() { }
+
+void LongstaffSchwartz::randomSeed(unsigned long s)
+{
+	seed = s;
+}
+
+void LongstaffSchwartz::threadCount(unsigned n)
+{
+	threads = n;
+}
+
+void LongstaffSchwartz::chunkSize(long paths)
+{
+	chunk = (paths > 0) ? paths : 1;
+}
+
+double LongstaffSchwartz::exercise(double S) const
+{
+	return (data.type == 1) ? std::max(S - data.K, 0.0) : std::max(data.K - S, 0.0);
+}
+
+double LongstaffSchwartz::pathMemory() const
+{
+	double perPath = 2.0 * sizeof(double);		// cashflow + current spot (or Brownian state)
+	if (storage == LSM_FLOAT)
+	{
+		perPath += double(M) * sizeof(float);
+	}
+	return perPath * double(P);
+}
+
+MCResult LongstaffSchwartz::price() const
+{
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	const double dt = data.T / double(M);
+	const double drift = data.r - data.D - 0.5 * data.sig * data.sig;
+	const double df = exp(-data.r * dt);
+	const long nChunks = (P + chunk - 1) / chunk;
+	unsigned nThreads = threads ? threads : std::max(1u, std::thread::hardware_concurrency());
+	nThreads = unsigned(std::min<long>(nThreads, nChunks));
+
+	std::vector<double> cash(P);		// cashflow of each path discounted to the current date
+	std::vector<double> state(P);		// LSM_BRIDGE: Brownian motion W(t_m), LSM_FLOAT: unused
+	std::vector<float> paths;			// LSM_FLOAT: S(t_m) for date m at [(m - 1) * P + p]
+	std::vector<NormalEquations> equations(nChunks);
+	PhiloxNormal normal(seed);			// variate (p, k) depends only on the seed, path p and draw k
+
+	// terminal date, plus the forward pass when the paths are stored
+	if (storage == LSM_FLOAT)
+	{
+		paths.resize(size_t(P) * size_t(M));
+	}
+
+	parallelFor(nChunks, nThreads, [&](long c)
+	{
+		long first = c * chunk;
+		long last = std::min(P, first + chunk);
+
+		for (long p = first; p < last; ++p)
+		{
+			double S;
+			if (storage == LSM_FLOAT)
+			{
+				double logS = log(S0);
+				for (long m = 1; m <= M; ++m)
+				{
+					logS += drift * dt + data.sig * sqrt(dt) * normal.normalAt(p, m - 1);
+					paths[size_t(m - 1) * P + p] = float(exp(logS));
+				}
+				S = exp(logS);
+			}
+			else
+			{
+				state[p] = sqrt(data.T) * normal.normalAt(p, 0);
+				S = S0 * exp(drift * data.T + data.sig * state[p]);
+			}
+			cash[p] = exercise(S);
+		}
+	});
+
+	// backward induction over the early exercise dates
+	for (long m = M - 1; m >= 1; --m)
+	{
+		const double t = dt * double(m);
+		const double tNext = t + dt;
+
+		// S(t_m), discount the cashflows one step and accumulate the regression
+		parallelFor(nChunks, nThreads, [&](long c)
+		{
+			NormalEquations& eq = equations[c];
+			eq.clear();
+
+			long first = c * chunk;
+			long last = std::min(P, first + chunk);
+
+			for (long p = first; p < last; ++p)
+			{
+				double S;
+				if (storage == LSM_FLOAT)
+				{
+					S = paths[size_t(m - 1) * P + p];
+				}
+				else
+				{ // W(t) given W(t + dt) is normal with mean W(t + dt) * t / (t + dt) and variance t * dt / (t + dt)
+					state[p] = state[p] * (t / tNext) + sqrt(t * dt / tNext) * normal.normalAt(p, M - m);
+					S = S0 * exp(drift * t + data.sig * state[p]);
+				}
+
+				cash[p] *= df;
+
+				if (exercise(S) > 0.0)
+				{
+					double x = S / data.K;
+					double basis[BASIS] = { 1.0, x, x * x, x * x * x };
+					for (int i = 0; i < BASIS; ++i)
+					{
+						for (int j = 0; j <= i; ++j)
+						{
+							eq.ata[i][j] += basis[i] * basis[j];
+						}
+						eq.aty[i] += basis[i] * cash[p];
+					}
+				}
+			}
+		});
+
+		// sum the chunks in a fixed order, then solve the small system once
+		NormalEquations total;
+		total.clear();
+		for (long c = 0; c < nChunks; ++c)
+		{
+			for (int i = 0; i < BASIS; ++i)
+			{
+				for (int j = 0; j <= i; ++j)
+				{
+					total.ata[i][j] += equations[c].ata[i][j];
+				}
+				total.aty[i] += equations[c].aty[i];
+			}
+		}
+		for (int i = 0; i < BASIS; ++i)
+		{
+			for (int j = i + 1; j < BASIS; ++j)
+			{
+				total.ata[i][j] = total.ata[j][i];
+			}
+		}
+
+		double beta[BASIS];
+		solve(total, beta);
+
+		// exercise where the intrinsic value beats the estimated continuation value
+		parallelFor(nChunks, nThreads, [&](long c)
+		{
+			long first = c * chunk;
+			long last = std::min(P, first + chunk);
+
+			for (long p = first; p < last; ++p)
+			{
+				double S = (storage == LSM_FLOAT) ? double(paths[size_t(m - 1) * P + p]) : S0 * exp(drift * t + data.sig * state[p]);
+				double value = exercise(S);
+				if (value <= 0.0)
+				{
+					continue;
+				}
+
+				double x = S / data.K;
+				double continuation = beta[0] + x * (beta[1] + x * (beta[2] + x * beta[3]));
+				if (value > continuation)
+				{
+					cash[p] = value;
+				}
+			}
+		});
+	}
+
+	// discount to t = 0, merged statistics per chunk
+	std::vector<MCStatistics> chunkStats(nChunks);
+	parallelFor(nChunks, nThreads, [&](long c)
+	{
+		long first = c * chunk;
+		long last = std::min(P, first + chunk);
+		for (long p = first; p < last; ++p)
+		{
+			chunkStats[c].add(cash[p] * df);
+		}
+	});
+
+	MCStatistics stats;
+	for (long c = 0; c < nChunks; ++c)
+	{
+		stats.merge(chunkStats[c]);
+	}
+
+	MCResult result;
+	result.price = std::max(stats.mean(), exercise(S0));		// exercise at t = 0 if it is worth more
+	result.standardError = stats.standardError();
+	result.paths = stats.count();
+	result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	result.reason = MC_MAX_PATHS;
+
+	return result;
+}
\ No newline at end of file
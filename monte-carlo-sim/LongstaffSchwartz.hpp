@@ -0,0 +1,46 @@
+#ifndef LongstaffSchwartz_HPP
+#define LongstaffSchwartz_HPP
+
+#include "OptionData.hpp"
+#include "MCStatistics.hpp"
+#include "AdaptiveMC.hpp"
+#include <vector>
+
+// how paths are kept between the forward and the backward pass
+enum LSMPathStorage
+{
+	LSM_BRIDGE,			// no path storage, each date is generated backwards from the next with a Brownian bridge, O(paths) memory
+	LSM_FLOAT			// paths simulated forward and stored as float, paths x dates x 4 bytes
+};
+
+class LongstaffSchwartz
+{ // least-squares MC for american exercise on a GBM underlying, Bermudan on M equally spaced dates
+  // continuation values are regressed on 1, x, x^2, x^3 with x = S / K over in the money paths,
+  // the 4 x 4 normal equations are accumulated per chunk of paths and summed, so both the path
+  // generation and the regression run in parallel, the normals come from a counter-based generator
+  // keyed on (path, draw), so the result does not depend on the thread count or chunk size
+	private:
+		OptionData data;
+		double S0;
+		long M;						// exercise dates
+		long P;						// paths
+		LSMPathStorage storage;
+		unsigned long seed;
+		long chunk;					// paths per chunk
+		unsigned threads;
+
+		double exercise(double S) const;	// intrinsic value
+
+	public:
+		LongstaffSchwartz(const OptionData& option, double spot, long dates, long paths, LSMPathStorage mode = LSM_BRIDGE);	// parameter constructor
+		virtual ~LongstaffSchwartz();		// destructor
+
+		void randomSeed(unsigned long s);	// Philox key, default 5489
+		void threadCount(unsigned n);		// 0 = hardware concurrency
+		void chunkSize(long paths);			// default 16384
+
+		MCResult price() const;				// american (Bermudan) price and standard error at t = 0
+		double pathMemory() const;			// bytes of path and cashflow storage the run needs
+};
+
+#endif // LongstaffSchwartz_HPP
\ No newline at end of file
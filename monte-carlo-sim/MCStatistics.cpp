@@ -0,0 +1,112 @@
+#include "MCStatistics.hpp"
+#include <cmath>
+
+// default constructor
+MCStatistics::MCStatistics()
+{
+	n = 0;
+	mu = 0.0;
+	m2 = 0.0;
+}
+
+// parameter constructor
+MCStatistics::MCStatistics(long count, double mean, double sumSquares)
+{
+	n = count;
+	mu = mean;
+	m2 = sumSquares;
+}
+
+// copy constructor
+MCStatistics::MCStatistics(const MCStatistics& stats2)
+{
+	n = stats2.n;
+	mu = stats2.mu;
+	m2 = stats2.m2;
+}
+
+// destructor
+MCStatistics::~MCStatistics() { }
+
+void MCStatistics::add(double x)
+{ // Welford update, no cancellation between large sums as in sum_squared - mean_squared
+	n++;
+	double delta = x - mu;
+	mu += delta / double(n);
+	m2 += delta * (x - mu);
+}
+
+void MCStatistics::merge(const MCStatistics& stats2)
+{ // pairwise combination (Chan et al.)
+	if (stats2.n == 0)
+	{
+		return;
+	}
+	if (n == 0)
+	{
+		*this = stats2;
+		return;
+	}
+
+	long total = n + stats2.n;
+	double delta = stats2.mu - mu;
+
+	mu += delta * double(stats2.n) / double(total);
+	m2 += stats2.m2 + delta * delta * double(n) * double(stats2.n) / double(total);
+	n = total;
+}
+
+void MCStatistics::reset()
+{
+	n = 0;
+	mu = 0.0;
+	m2 = 0.0;
+}
+
+long MCStatistics::count() const
+{
+	return n;
+}
+
+double MCStatistics::mean() const
+{
+	return mu;
+}
+
+double MCStatistics::sumSquares() const
+{
+	return m2;
+}
+
+double MCStatistics::variance() const
+{
+	if (n < 2)
+	{
+		return 0.0;
+	}
+	return m2 / double(n - 1);
+}
+
+double MCStatistics::standardDeviation() const
+{
+	return sqrt(variance());
+}
+
+double MCStatistics::standardError() const
+{
+	if (n == 0)
+	{
+		return 0.0;
+	}
+	return standardDeviation() / sqrt(double(n));
+}
+
+// operator overloading
+MCStatistics& MCStatistics::operator = (const MCStatistics& stats2)
+{ // assignment operator
+	n = stats2.n;
+	mu = stats2.mu;
+	m2 = stats2.m2;
+
+	return *this;
+}
\ No newline at end of file
@@ -0,0 +1,32 @@
+#ifndef MCStatistics_HPP
+#define MCStatistics_HPP
+
+class MCStatistics
+{ // running mean and variance of simulated payoffs (Welford), mergeable so batches, threads and runs can be combined
+	private:
+		long n;			// number of samples
+		double mu;		// running mean
+		double m2;		// sum of squared deviations from the mean
+
+	public:
+		MCStatistics();										// default constructor
+		MCStatistics(long count, double mean, double sumSquares);	// parameter constructor, restores saved statistics
+		MCStatistics(const MCStatistics& stats2);			// copy constructor
+		virtual ~MCStatistics();							// destructor
+
+		void add(double x);									// add one sample
+		void merge(const MCStatistics& stats2);				// combine with statistics of an independent sample
+		void reset();
+
+		long count() const;
+		double mean() const;
+		double sumSquares() const;							// m2, together with count and mean this is the full state
+		double variance() const;							// unbiased sample variance
+		double standardDeviation() const;
+		double standardError() const;						// standard deviation / sqrt(n)
+
+		// operator overloading
+		MCStatistics& operator = (const MCStatistics& stats2);
+};
+
+#endif // MCStatistics_HPP
\ No newline at end of file
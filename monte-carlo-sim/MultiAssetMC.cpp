@@ -0,0 +1,226 @@
+#include "MultiAssetMC.hpp"
+#include <algorithm>
+#include <cmath>
+#include <chrono>
+#include <stdexcept>
+
+// parameter constructor
+MultiAssetMC::MultiAssetMC(const MultiAssetData& option, long nSteps, NormalGenerator& generator)
+{
+	data = option;
+	N = (nSteps > 0) ? nSteps : 1;
+	normal = &generator;
+	block = 256;
+
+	size_t n = data.S0.size();
+	if (n == 0 || data.sig.size() != n || data.correlation.size() != n)
+	{
+		throw std::invalid_argument("Multi-asset data sizes do not match.");
+	}
+	if (data.D.size() != n)
+	{
+		data.D.assign(n, 0.0);
+	}
+	if (data.weights.size() != n)
+	{
+		data.weights.assign(n, 1.0 / double(n));
+	}
+	if ((data.payoff == SPREAD_CALL) && n < 2)
+	{
+		throw std::invalid_argument("Spread option needs two assets.");
+	}
+
+	factor();
+}
+
+// destructor
+MultiAssetMC::~MultiAssetMC() { }
+
+void MultiAssetMC::factor()
+{ // Cholesky-Banachiewicz, rho = L L^T
+	size_t n = data.S0.size();
+	chol.assign(n * n, 0.0);
+
+	for (size_t i = 0; i < n; ++i)
+	{
+		if (data.correlation[i].size() != n)
+		{
+			throw std::invalid_argument("Correlation matrix must be square.");
+		}
+
+		for (size_t j = 0; j <= i; ++j)
+		{
+			double sum = data.correlation[i][j];
+			for (size_t k = 0; k < j; ++k)
+			{
+				sum -= chol[i * n + k] * chol[j * n + k];
+			}
+
+			if (i == j)
+			{
+				if (sum <= 0.0)
+				{
+					throw std::invalid_argument("Correlation matrix is not positive definite.");
+				}
+				chol[i * n + i] = sqrt(sum);
+			}
+			else
+			{
+				chol[i * n + j] = sum / chol[j * n + j];
+			}
+		}
+	}
+}
+
+void MultiAssetMC::blockSize(long paths)
+{
+	block = (paths > 0) ? paths : 1;
+}
+
+long MultiAssetMC::assets() const
+{
+	return long(data.S0.size());
+}
+
+const std::vector<double>& MultiAssetMC::cholesky() const
+{
+	return chol;
+}
+
+double MultiAssetMC::payoff(const double* S, long stride) const
+{ // S[i * stride] is asset i on this path
+	size_t n = data.S0.size();
+
+	switch (data.payoff)
+	{
+		case BASKET_CALL:
+		case BASKET_PUT:
+		{
+			double basket = 0.0;
+			for (size_t i = 0; i < n; ++i)
+			{
+				basket += data.weights[i] * S[i * stride];
+			}
+			return (data.payoff == BASKET_CALL) ? std::max(basket - data.K, 0.0) : std::max(data.K - basket, 0.0);
+		}
+		case SPREAD_CALL:
+			return std::max(S[0] - S[stride] - data.K, 0.0);
+		case BEST_OF_CALL:
+		{
+			double best = S[0];
+			for (size_t i = 1; i < n; ++i)
+			{
+				best = std::max(best, S[i * stride]);
+			}
+			return std::max(best - data.K, 0.0);
+		}
+		case WORST_OF_PUT:
+		{
+			double worst = S[0];
+			for (size_t i = 1; i < n; ++i)
+			{
+				worst = std::min(worst, S[i * stride]);
+			}
+			return std::max(data.K - worst, 0.0);
+		}
+	}
+
+	return 0.0;
+}
+
+MCStatistics MultiAssetMC::runPaths(long nPaths) const
+{
+	size_t n = data.S0.size();
+	double k = data.T / double(N);
+	double sqrk = sqrt(k);
+
+	// per asset drift and vol over one step, hoisted out of the path loops
+	std::vector<double> mu(n), vol(n);
+	for (size_t i = 0; i < n; ++i)
+	{
+		mu[i] = (data.r - data.D[i] - 0.5 * data.sig[i] * data.sig[i]) * k;
+		vol[i] = data.sig[i] * sqrk;
+	}
+
+	// asset-major block buffers, element (asset i, path p) at i * P + p
+	long P = block;
+	std::vector<double> logS(n * P), Z(n * P), W(n * P), S(n * P);
+	MCStatistics stats;
+
+	for (long first = 0; first < nPaths; first += P)
+	{
+		long m = std::min(P, nPaths - first);
+
+		for (size_t i = 0; i < n; ++i)
+		{
+			std::fill(logS.begin() + i * P, logS.begin() + i * P + m, log(data.S0[i]));
+		}
+
+		for (long step = 0; step < N; ++step)
+		{
+			for (size_t i = 0; i < n; ++i)
+			{
+				double* z = &Z[i * P];
+				for (long p = 0; p < m; ++p)
+				{
+					z[p] = normal->getNormal();
+				}
+			}
+
+			// W = L Z, one row of L at a time, unit stride over the paths of the block
+			for (size_t i = 0; i < n; ++i)
+			{
+				double* w = &W[i * P];
+				std::fill(w, w + m, 0.0);
+
+				for (size_t j = 0; j <= i; ++j)
+				{
+					const double l = chol[i * n + j];
+					const double* z = &Z[j * P];
+					for (long p = 0; p < m; ++p)
+					{
+						w[p] += l * z[p];
+					}
+				}
+
+				double* x = &logS[i * P];
+				for (long p = 0; p < m; ++p)
+				{
+					x[p] += mu[i] + vol[i] * w[p];
+				}
+			}
+		}
+
+		for (size_t i = 0; i < n; ++i)
+		{
+			for (long p = 0; p < m; ++p)
+			{
+				S[i * P + p] = exp(logS[i * P + p]);
+			}
+		}
+
+		for (long p = 0; p < m; ++p)
+		{
+			stats.add(payoff(&S[p], P));
+		}
+	}
+
+	return stats;
+}
+
+MCResult MultiAssetMC::run(long nPaths) const
+{
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	MCStatistics stats = runPaths(nPaths);
+	double discount = exp(-data.r * data.T);
+
+	MCResult result;
+	result.price = stats.mean() * discount;
+	result.standardError = stats.standardError() * discount;
+	result.paths = stats.count();
+	result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	result.reason = MC_MAX_PATHS;
+
+	return result;
+}
\ No newline at end of file
@@ -0,0 +1,59 @@
+#ifndef MultiAssetMC_HPP
+#define MultiAssetMC_HPP
+
+#include "NormalGenerator.hpp"
+#include "MCStatistics.hpp"
+#include "AdaptiveMC.hpp"
+#include <vector>
+
+enum MultiAssetPayoff
+{
+	BASKET_CALL,		// max(sum w_i S_i - K, 0)
+	BASKET_PUT,			// max(K - sum w_i S_i, 0)
+	SPREAD_CALL,		// max(S_0 - S_1 - K, 0), first two assets
+	BEST_OF_CALL,		// max(max_i S_i - K, 0)
+	WORST_OF_PUT		// max(K - min_i S_i, 0)
+};
+
+struct MultiAssetData
+{ // option data for several correlated GBM underlyings
+
+	std::vector<double> S0;				// spot per asset
+	std::vector<double> sig;			// volatility per asset
+	std::vector<double> D;				// dividend yield per asset
+	std::vector<double> weights;		// basket weights
+	std::vector<std::vector<double>> correlation;	// symmetric, positive definite, ones on the diagonal
+
+	double K;
+	double T;
+	double r;
+	MultiAssetPayoff payoff;
+};
+
+class MultiAssetMC
+{ // correlated multi-asset MC, exact GBM steps in log space
+  // paths are simulated in blocks, state is stored asset by asset with the paths of a block contiguous,
+  // so the correlation (a lower triangular matrix-vector product per step) runs as unit stride loops over paths
+	private:
+		MultiAssetData data;
+		long N;								// time steps
+		NormalGenerator* normal;
+		long block;							// paths per block
+		std::vector<double> chol;			// Cholesky factor of the correlation, row major n x n, factored once
+
+		void factor();						// throws std::invalid_argument if the correlation is not positive definite
+		double payoff(const double* S, long stride) const;
+
+	public:
+		MultiAssetMC(const MultiAssetData& option, long nSteps, NormalGenerator& generator);	// parameter constructor
+		virtual ~MultiAssetMC();			// destructor
+
+		void blockSize(long paths);			// paths per block, default 256
+		long assets() const;
+		const std::vector<double>& cholesky() const;
+
+		MCStatistics runPaths(long nPaths) const;	// statistics of the undiscounted payoffs
+		MCResult run(long nPaths) const;			// discounted price and standard error
+};
+
+#endif // MultiAssetMC_HPP
\ No newline at end of file
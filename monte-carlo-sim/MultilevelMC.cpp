@@ -0,0 +1,194 @@
+#include "MultilevelMC.hpp"
+#include <algorithm>
+#include <cmath>
+
+// parameter constructor
+MultilevelMC::MultilevelMC(OptionData& option, double spot, long baseSteps, double (*driftFunction)(double, double), double (*diffusionFunction)(double, double), NormalGenerator& generator)
+{
+	data = &option;
+	S0 = spot;
+	N0 = (baseSteps > 0) ? baseSteps : 1;
+	drift = driftFunction;
+	diffusion = diffusionFunction;
+	slope = 0;
+	normal = &generator;
+	scheme = MLMC_EULER;
+	payoffType = MLMC_EUROPEAN;
+	maxLevel = 10;
+	warmup = 2000;
+}
+
+// destructor
+MultilevelMC::~MultilevelMC() { }
+
+void MultilevelMC::milstein(double (*slopeFunction)(double, double))
+{
+	slope = slopeFunction;
+	scheme = MLMC_MILSTEIN;
+}
+
+void MultilevelMC::payoffKind(MLMCPayoff kind)
+{
+	payoffType = kind;
+}
+
+void MultilevelMC::maximumLevel(int level)
+{
+	maxLevel = std::max(level, 1);
+}
+
+void MultilevelMC::warmupPaths(long paths)
+{
+	warmup = std::max(paths, 2L);
+}
+
+double MultilevelMC::payoff(double ST, double average, bool knockedOut) const
+{
+	switch (payoffType)
+	{
+		case MLMC_ASIAN:
+			return data->myPayOffFunction(average);
+		case MLMC_DOWN_AND_OUT:
+			return knockedOut ? 0.0 : data->myPayOffFunction(ST);
+		default:
+			return data->myPayOffFunction(ST);
+	}
+}
+
+void MultilevelMC::runLevel(int level, long nPaths, MCStatistics& correction, MCStatistics& fine) const
+{
+	const long nf = N0 << level;			// fine steps
+	const double hf = data->T / double(nf);
+	const double hc = 2.0 * hf;
+	const double sqrhf = sqrt(hf);
+
+	for (long i = 0; i < nPaths; ++i)
+	{
+		double Xf = S0, Xc = S0;
+		double sumf = 0.5 * S0, sumc = 0.5 * S0;	// trapezoidal sums for the average
+		bool outf = false, outc = false;
+		double dWc = 0.0;
+
+		for (long n = 0; n < nf; ++n)
+		{
+			double t = hf * double(n);
+			double dW = sqrhf * normal->getNormal();
+
+			double b = diffusion(t, Xf);
+			double Xnew = Xf + drift(t, Xf) * hf + b * dW;
+			if (scheme == MLMC_MILSTEIN)
+			{
+				Xnew += 0.5 * b * slope(t, Xf) * (dW * dW - hf);
+			}
+			Xf = Xnew;
+			sumf += Xf;
+			outf = outf || (Xf <= data->H);
+
+			// coarse path takes one step for every two fine steps, with the summed increment
+			dWc += dW;
+			if (level > 0 && (n % 2) == 1)
+			{
+				double tc = hf * double(n - 1);
+				double bc = diffusion(tc, Xc);
+				double Xcnew = Xc + drift(tc, Xc) * hc + bc * dWc;
+				if (scheme == MLMC_MILSTEIN)
+				{
+					Xcnew += 0.5 * bc * slope(tc, Xc) * (dWc * dWc - hc);
+				}
+				Xc = Xcnew;
+				sumc += Xc;
+				outc = outc || (Xc <= data->H);
+				dWc = 0.0;
+			}
+		}
+
+		double Pf = payoff(Xf, (sumf - 0.5 * Xf) / double(nf), outf);
+		fine.add(Pf);
+
+		if (level == 0)
+		{
+			correction.add(Pf);
+		}
+		else
+		{
+			double Pc = payoff(Xc, (sumc - 0.5 * Xc) / double(nf / 2), outc);
+			correction.add(Pf - Pc);
+		}
+	}
+}
+
+MLMCResult MultilevelMC::run(double eps) const
+{
+	std::vector<MCStatistics> Y;		// level corrections
+	std::vector<MCStatistics> F;		// fine payoffs per level, for the single level comparison
+	std::vector<double> C;				// cost per path on each level, in time steps
+	double cost = 0.0;
+
+	int L = 2;
+	for (int l = 0; l <= L; ++l)
+	{
+		Y.push_back(MCStatistics());
+		F.push_back(MCStatistics());
+		C.push_back(double(N0 << l) * (l > 0 ? 1.5 : 1.0));
+		runLevel(l, warmup, Y[l], F[l]);
+		cost += double(warmup) * C[l];
+	}
+
+	while (true)
+	{
+		// optimal paths per level, N_l = 2 eps^-2 sqrt(V_l / C_l) sum_k sqrt(V_k C_k)
+		double sum = 0.0;
+		for (int l = 0; l <= L; ++l)
+		{
+			sum += sqrt(Y[l].variance() * C[l]);
+		}
+
+		for (int l = 0; l <= L; ++l)
+		{
+			long target = long(ceil(2.0 / (eps * eps) * sqrt(Y[l].variance() / C[l]) * sum));
+			long extra = target - Y[l].count();
+			if (extra > 0)
+			{
+				runLevel(l, extra, Y[l], F[l]);
+				cost += double(extra) * C[l];
+			}
+		}
+
+		// weak error of order 1 in h, the remaining bias is about |E[Y_L]| / (2 - 1)
+		double bias = std::max(std::abs(Y[L].mean()), 0.5 * std::abs(Y[L - 1].mean()));
+		if (bias <= eps / sqrt(2.0) || L >= maxLevel)
+		{
+			break;
+		}
+
+		L++;
+		Y.push_back(MCStatistics());
+		F.push_back(MCStatistics());
+		C.push_back(double(N0 << L) * 1.5);
+		runLevel(L, warmup, Y[L], F[L]);
+		cost += double(warmup) * C[L];
+	}
+
+	double discount = exp(-data->r * data->T);
+	MLMCResult result;
+	result.price = 0.0;
+	result.levels = L;
+	result.cost = cost;
+
+	double variance = 0.0;
+	for (int l = 0; l <= L; ++l)
+	{
+		result.price += Y[l].mean();
+		variance += Y[l].variance() / double(Y[l].count());
+		result.paths.push_back(Y[l].count());
+		result.variances.push_back(Y[l].variance());
+	}
+
+	result.price *= discount;
+	result.standardError = sqrt(variance) * discount;
+
+	// plain MC on the finest grid needs 2 eps^-2 V[P_L] paths of N0 * 2^L steps for the same error
+	result.singleLevelCost = 2.0 / (eps * eps) * F[L].variance() * double(N0 << L);
+
+	return result;
+}
\ No newline at end of file
@@ -0,0 +1,67 @@
+#ifndef MultilevelMC_HPP
+#define MultilevelMC_HPP
+
+#include "OptionData.hpp"
+#include "NormalGenerator.hpp"
+#include "MCStatistics.hpp"
+#include <vector>
+
+enum MLMCScheme
+{
+	MLMC_EULER,			// explicit Euler, as in TestMC
+	MLMC_MILSTEIN		// Milstein, needs the slope of the diffusion
+};
+
+enum MLMCPayoff
+{
+	MLMC_EUROPEAN,		// payoff of S(T)
+	MLMC_ASIAN,			// payoff of the arithmetic average of S over the time grid (trapezoidal)
+	MLMC_DOWN_AND_OUT	// payoff of S(T), zero if S falls below data.H on the time grid
+};
+
+struct MLMCResult
+{ // discounted price with the work spent, and the work a single level run at the same accuracy would need
+
+	double price;
+	double standardError;
+	int levels;							// finest level used, level l has N0 * 2^l time steps
+	std::vector<long> paths;			// paths per level
+	std::vector<double> variances;		// variance of the level corrections
+	double cost;						// time steps simulated, coarse and fine
+	double singleLevelCost;				// estimated time steps for plain MC on the finest grid with the same variance
+};
+
+class MultilevelMC
+{ // multilevel MC (Giles 2008), level l uses N0 * 2^l steps and is coupled to level l - 1 by summing
+  // pairs of fine Brownian increments, the paths per level are chosen from the observed variances
+  // so that the mean square error is eps^2, and levels are added until the bias estimate is below eps / sqrt(2)
+	private:
+		OptionData* data;
+		double S0;
+		long N0;							// steps on level 0
+		double (*drift)(double t, double X);
+		double (*diffusion)(double t, double X);
+		double (*slope)(double t, double X);	// d diffusion / dX, Milstein only
+		NormalGenerator* normal;
+		MLMCScheme scheme;
+		MLMCPayoff payoffType;
+		int maxLevel;
+		long warmup;						// paths on a new level before its variance is trusted
+
+		// correction P_l - P_{l-1} (or P_0 on level 0) for nPaths coupled paths, fine payoffs go into fine
+		void runLevel(int level, long nPaths, MCStatistics& correction, MCStatistics& fine) const;
+		double payoff(double ST, double average, bool knockedOut) const;
+
+	public:
+		MultilevelMC(OptionData& option, double spot, long baseSteps, double (*driftFunction)(double, double), double (*diffusionFunction)(double, double), NormalGenerator& generator);	// parameter constructor
+		virtual ~MultilevelMC();			// destructor
+
+		void milstein(double (*slopeFunction)(double, double));		// switch to the Milstein scheme
+		void payoffKind(MLMCPayoff kind);	// default MLMC_EUROPEAN
+		void maximumLevel(int level);		// default 10
+		void warmupPaths(long paths);		// default 2000
+
+		MLMCResult run(double eps) const;	// root mean square error target
+};
+
+#endif // MultilevelMC_HPP
\ No newline at end of file
@@ -8,6 +8,13 @@ BoostNormal::BoostNormal() : NormalGenerator ()
 	myRandom = new boost::variate_generator<boost::lagged_fibonacci607&, boost::normal_distribution<>>(rng, nor);
 }
 
+BoostNormal::BoostNormal(unsigned int seed) : NormalGenerator ()
+{
+	rng = boost::lagged_fibonacci607(seed);
+	nor = boost::normal_distribution<>(0,1);
+	myRandom = new boost::variate_generator<boost::lagged_fibonacci607&, boost::normal_distribution<>>(rng, nor);
+}
+
 double BoostNormal::getNormal() const
 {
 	return (*myRandom)();
@@ -16,4 +23,122 @@ double BoostNormal::getNormal() const
 BoostNormal::~BoostNormal() 
 {
 	delete myRandom;
-}
\ No newline at end of file
+}
+
+namespace
+{
+	const uint32_t PHILOX_M0 = 0xD2511F53;
+	const uint32_t PHILOX_M1 = 0xCD9E8D57;
+	const uint32_t PHILOX_W0 = 0x9E3779B9;		// golden ratio
+	const uint32_t PHILOX_W1 = 0xBB67AE85;		// sqrt(3) - 1
+	const double TWO_PI = 6.28318530717958647692;
+
+	inline void philoxRound(uint32_t* ctr, const uint32_t* key)
+	{
+		uint64_t p0 = uint64_t(PHILOX_M0) * ctr[0];
+		uint64_t p1 = uint64_t(PHILOX_M1) * ctr[2];
+
+		uint32_t out0 = uint32_t(p1 >> 32) ^ ctr[1] ^ key[0];
+		uint32_t out1 = uint32_t(p1);
+		uint32_t out2 = uint32_t(p0 >> 32) ^ ctr[3] ^ key[1];
+		uint32_t out3 = uint32_t(p0);
+
+		ctr[0] = out0;
+		ctr[1] = out1;
+		ctr[2] = out2;
+		ctr[3] = out3;
+	}
+
+	inline double toUniform(uint32_t hi, uint32_t lo)
+	{ // 53 random bits mapped to (0, 1], never 0 so the log in Box-Muller is finite
+		uint64_t bits = ((uint64_t(hi) << 32) | lo) >> 11;
+		return (double(bits) + 1.0) * (1.0 / 9007199254740992.0);
+	}
+}
+
+PhiloxNormal::PhiloxNormal() : NormalGenerator ()
+{
+	key[0] = 0;
+	key[1] = 0;
+	path = 0;
+	step = 0;
+}
+
+PhiloxNormal::PhiloxNormal(uint64_t seed) : NormalGenerator ()
+{
+	key[0] = uint32_t(seed);
+	key[1] = uint32_t(seed >> 32);
+	path = 0;
+	step = 0;
+}
+
+void PhiloxNormal::block(uint64_t pathIndex, uint64_t pair, double* z) const
+{ // counter = (pair, path), 10 rounds with a bumped key
+	uint32_t ctr[4] = { uint32_t(pair), uint32_t(pair >> 32), uint32_t(pathIndex), uint32_t(pathIndex >> 32) };
+	uint32_t k[2] = { key[0], key[1] };
+
+	for (int round = 0; round < 10; ++round)
+	{
+		philoxRound(ctr, k);
+		k[0] += PHILOX_W0;
+		k[1] += PHILOX_W1;
+	}
+
+	double u1 = toUniform(ctr[0], ctr[1]);
+	double u2 = toUniform(ctr[2], ctr[3]);
+	double r = sqrt(-2.0 * log(u1));
+
+	z[0] = r * cos(TWO_PI * u2);
+	z[1] = r * sin(TWO_PI * u2);
+}
+
+double PhiloxNormal::getNormal() const
+{
+	double z = normalAt(path, step);
+	step++;
+	return z;
+}
+
+void PhiloxNormal::setPosition(uint64_t pathIndex, uint64_t stepIndex)
+{
+	path = pathIndex;
+	step = stepIndex;
+}
+
+double PhiloxNormal::normalAt(uint64_t pathIndex, uint64_t stepIndex) const
+{
+	double z[2];
+	block(pathIndex, stepIndex >> 1, z);
+	return z[stepIndex & 1];
+}
+
+void PhiloxNormal::normals(uint64_t pathIndex, uint64_t firstStep, long n, double* out) const
+{ // one block per pair of steps, an odd start or end uses half a block
+	long i = 0;
+	double z[2];
+
+	if ((firstStep & 1) && n > 0)
+	{
+		block(pathIndex, firstStep >> 1, z);
+		out[i++] = z[1];
+	}
+	for (; i + 1 < n; i += 2)
+	{
+		block(pathIndex, (firstStep + uint64_t(i)) >> 1, &out[i]);
+	}
+	if (i < n)
+	{
+		block(pathIndex, (firstStep + uint64_t(i)) >> 1, z);
+		out[i] = z[0];
+	}
+}
+
+void PhiloxNormal::normalsAcross(uint64_t firstPath, long nPaths, uint64_t stepIndex, double* out) const
+{ // independent blocks per path, no loop carried state
+	for (long i = 0; i < nPaths; ++i)
+	{
+		out[i] = normalAt(firstPath + uint64_t(i), stepIndex);
+	}
+}
+
+PhiloxNormal::~PhiloxNormal() { }
\ No newline at end of file
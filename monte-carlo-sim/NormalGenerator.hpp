@@ -5,6 +5,7 @@
 #include <boost/random/mersenne_twister.hpp>
 #include <boost/random/normal_distribution.hpp>
 #include <boost/random/variate_generator.hpp>
+#include <cstdint>
 
 class NormalGenerator
 {
@@ -23,10 +24,40 @@ class BoostNormal : public NormalGenerator
 	
 	public:
 		BoostNormal();
+		BoostNormal(unsigned int seed);		// explicit seed
 
 		double getNormal() const;
 
 		~BoostNormal();
 };
 
+class PhiloxNormal : public NormalGenerator
+{ // counter-based generator (Philox4x32-10, Salmon et al. 2011) with Box-Muller
+  // the variate for (path, step) is a pure function of the seed and that counter, so any partition of the
+  // paths over threads or processes reproduces a serial run exactly, and there is no state beyond the key
+	private:
+		uint32_t key[2];					// from the seed
+		mutable uint64_t path;				// sequential position used by getNormal()
+		mutable uint64_t step;
+
+		void block(uint64_t path, uint64_t pair, double* z) const;	// two normals for steps 2 * pair and 2 * pair + 1
+
+	public:
+		PhiloxNormal();						// seed 0
+		PhiloxNormal(uint64_t seed);
+
+		double getNormal() const;			// next variate of the current path, then moves to the next step
+
+		void setPosition(uint64_t pathIndex, uint64_t stepIndex);		// where getNormal() continues from
+		double normalAt(uint64_t pathIndex, uint64_t stepIndex) const;	// random access
+
+		// bulk generation, out[i] = normalAt(pathIndex, firstStep + i)
+		void normals(uint64_t pathIndex, uint64_t firstStep, long n, double* out) const;
+
+		// one step across many paths, out[i] = normalAt(firstPath + i, stepIndex)
+		void normalsAcross(uint64_t firstPath, long nPaths, uint64_t stepIndex, double* out) const;
+
+		~PhiloxNormal();
+};
+
 #endif // NormalGenerator_HPP
\ No newline at end of file
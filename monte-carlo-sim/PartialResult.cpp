@@ -0,0 +1,191 @@
+#include "PartialResult.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace
+{
+	const char PARTIAL_MAGIC[8] = { 'M', 'C', 'P', 'A', 'R', 'T', '1', '\0' };
+	const uint32_t PARTIAL_VERSION = 1;
+	const uint32_t PARTIAL_BYTE_ORDER = 0x01020304;
+
+	struct StatsRecord
+	{
+		int64_t count;
+		double mean;
+		double m2;
+	};
+
+	struct PartialFile
+	{ // on-disk layout, 128 bytes
+		char magic[8];
+		uint32_t version;
+		uint32_t byteOrder;
+		uint64_t seed;
+		uint64_t settings;
+		uint64_t firstPath;
+		uint64_t nPaths;
+		double seconds;
+		StatsRecord stats[3];		// payoff, delta, vega
+	};
+
+	static_assert(sizeof(PartialFile) == 128, "partial result files are 128 bytes");
+
+	StatsRecord toRecord(const MCStatistics& s)
+	{
+		StatsRecord r;
+		r.count = s.count();
+		r.mean = s.mean();
+		r.m2 = s.sumSquares();
+		return r;
+	}
+
+	MCStatistics fromRecord(const StatsRecord& r)
+	{
+		return MCStatistics(long(r.count), r.mean, r.m2);
+	}
+
+	void hashBytes(uint64_t& h, const void* bytes, size_t n)
+	{ // FNV-1a
+		const unsigned char* p = static_cast<const unsigned char*>(bytes);
+		for (size_t i = 0; i < n; ++i)
+		{
+			h = (h ^ p[i]) * 0x100000001B3ULL;
+		}
+	}
+}
+
+PartialResult::PartialResult()
+{
+	seed = 0;
+	settings = 0;
+	firstPath = 0;
+	nPaths = 0;
+	seconds = 0.0;
+}
+
+void PartialResult::merge(const PartialResult& other)
+{
+	if (nPaths == 0)
+	{
+		*this = other;
+		return;
+	}
+	if (other.seed != seed)
+	{
+		throw std::invalid_argument("Partial results come from different seeds.");
+	}
+	if (other.settings != settings)
+	{
+		throw std::invalid_argument("Partial results come from different run settings.");
+	}
+
+	firstPath = std::min(firstPath, other.firstPath);
+	nPaths += other.nPaths;
+	seconds = std::max(seconds, other.seconds);		// workers run concurrently
+	payoff.merge(other.payoff);
+	delta.merge(other.delta);
+	vega.merge(other.vega);
+}
+
+uint64_t runSettings(const OptionData& option, double spot, long steps)
+{ // hashes the bit patterns, the fields are listed one by one so padding and unused fields never enter
+	uint64_t h = 0xCBF29CE484222325ULL;
+	int64_t n = steps;
+	int32_t type = option.type;
+
+	hashBytes(h, &n, sizeof(n));
+	hashBytes(h, &spot, sizeof(spot));
+	hashBytes(h, &option.K, sizeof(option.K));
+	hashBytes(h, &option.T, sizeof(option.T));
+	hashBytes(h, &option.r, sizeof(option.r));
+	hashBytes(h, &option.sig, sizeof(option.sig));
+	hashBytes(h, &type, sizeof(type));
+
+	return h;
+}
+
+void writePartial(const std::string& fileName, const PartialResult& result)
+{ // written to a temporary name and renamed, a reader never sees half a file
+	PartialFile f;
+	std::memset(&f, 0, sizeof(f));
+	std::memcpy(f.magic, PARTIAL_MAGIC, sizeof(f.magic));
+	f.version = PARTIAL_VERSION;
+	f.byteOrder = PARTIAL_BYTE_ORDER;
+	f.seed = result.seed;
+	f.settings = result.settings;
+	f.firstPath = result.firstPath;
+	f.nPaths = result.nPaths;
+	f.seconds = result.seconds;
+	f.stats[0] = toRecord(result.payoff);
+	f.stats[1] = toRecord(result.delta);
+	f.stats[2] = toRecord(result.vega);
+
+	std::string tmp = fileName + ".tmp";
+	{
+		std::ofstream out(tmp.c_str(), std::ios::binary | std::ios::trunc);
+		out.write(reinterpret_cast<const char*>(&f), sizeof(f));
+		if (!out)
+		{
+			throw std::runtime_error("Cannot write partial result " + tmp);
+		}
+	}
+
+	if (std::rename(tmp.c_str(), fileName.c_str()) != 0)
+	{
+		throw std::runtime_error("Cannot rename partial result to " + fileName);
+	}
+}
+
+PartialResult readPartial(const std::string& fileName)
+{
+	PartialFile f;
+	std::ifstream in(fileName.c_str(), std::ios::binary);
+	in.read(reinterpret_cast<char*>(&f), sizeof(f));
+
+	if (!in || std::memcmp(f.magic, PARTIAL_MAGIC, sizeof(f.magic)) != 0)
+	{
+		throw std::runtime_error("Not a partial result file: " + fileName);
+	}
+	if (f.version != PARTIAL_VERSION || f.byteOrder != PARTIAL_BYTE_ORDER)
+	{
+		throw std::runtime_error("Unsupported version or byte order: " + fileName);
+	}
+
+	PartialResult result;
+	result.seed = f.seed;
+	result.settings = f.settings;
+	result.firstPath = f.firstPath;
+	result.nPaths = f.nPaths;
+	result.seconds = f.seconds;
+	result.payoff = fromRecord(f.stats[0]);
+	result.delta = fromRecord(f.stats[1]);
+	result.vega = fromRecord(f.stats[2]);
+
+	return result;
+}
+
+PartialResult mergePartials(const std::vector<std::string>& fileNames)
+{
+	std::vector<PartialResult> parts;
+	for (size_t i = 0; i < fileNames.size(); ++i)
+	{
+		parts.push_back(readPartial(fileNames[i]));
+	}
+
+	// sort by range start so overlaps are adjacent, merging in a fixed order also makes the result independent of the file order
+	std::sort(parts.begin(), parts.end(), [](const PartialResult& a, const PartialResult& b) { return a.firstPath < b.firstPath; });
+
+	PartialResult total;
+	for (size_t i = 0; i < parts.size(); ++i)
+	{
+		if (i > 0 && parts[i - 1].firstPath + parts[i - 1].nPaths > parts[i].firstPath)
+		{
+			throw std::runtime_error("Partial results have overlapping path ranges.");
+		}
+		total.merge(parts[i]);
+	}
+
+	return total;
+}
\ No newline at end of file
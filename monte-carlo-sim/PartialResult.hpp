@@ -0,0 +1,38 @@
+#ifndef PartialResult_HPP
+#define PartialResult_HPP
+
+#include "MCStatistics.hpp"
+#include "OptionData.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct PartialResult
+{ // statistics of one worker's disjoint path range, all accumulators are mergeable
+
+	uint64_t seed;				// generator key, partials only merge with the same seed
+	uint64_t settings;			// runSettings() fingerprint, partials only merge with the same settings
+	uint64_t firstPath;
+	uint64_t nPaths;
+	double seconds;				// worker wall time
+
+	MCStatistics payoff;		// undiscounted payoff
+	MCStatistics delta;			// undiscounted pathwise delta
+	MCStatistics vega;			// undiscounted pathwise vega
+
+	PartialResult();
+	void merge(const PartialResult& other);		// throws std::invalid_argument for a different seed or different settings
+};
+
+// fingerprint of the run settings: time steps, spot and the option terms K, T, r, sig and type
+// the drift and diffusion functions are code, not data, and are not part of it
+uint64_t runSettings(const OptionData& option, double spot, long steps);
+
+// small fixed-size binary file, 128 bytes, magic "MCPART1" and a byte order mark
+void writePartial(const std::string& fileName, const PartialResult& result);
+PartialResult readPartial(const std::string& fileName);		// throws std::runtime_error for a bad or foreign file
+
+// merge partials, checks that the path ranges do not overlap
+PartialResult mergePartials(const std::vector<std::string>& fileNames);
+
+#endif // PartialResult_HPP
\ No newline at end of file
@@ -4,6 +4,34 @@
 #include "Range.hpp"
 #include <vector>
 
+// parameter constructor
+template <class Type> RangeMesh<Type>::RangeMesh(const Type& low, const Type& high, long nSteps)
+{
+	lo = low;
+	hi = high;
+	n = nSteps;
+	h = (high - low) / Type (nSteps);
+}
+
+template <class Type> Type RangeMesh<Type>::operator [] (long index) const
+{ // exact grid point rather than an accumulated sum
+	if (index == n)
+	{
+		return hi;
+	}
+	return lo + Type (index) * h;
+}
+
+template <class Type> long RangeMesh<Type>::size() const
+{
+	return n + 1;
+}
+
+template <class Type> Type RangeMesh<Type>::step() const
+{
+	return h;
+}
+
 // default constructor
 template <class Type> Range<Type>::Range()
 {
@@ -105,19 +133,21 @@ template <class Type> Range<Type>& Range<Type>::operator = (const Range<Type>& r
 template <class Type> std::vector<Type> Range<Type>::mesh(long nSteps) const
 { //  create a discrete mesh
 
-	Type h = (hi - lo) / Type (nSteps);
-
-	std::vector<Type>result(nSteps + 1);
+	RangeMesh<Type> view(lo, hi, nSteps);
 
-	Type val = lo;
+	std::vector<Type>result(view.size());
 
-	for (long i = 0; i < nSteps + 1; i++)	
+	for (long i = 0; i < view.size(); i++)
 	{
-		result[i] = val;
-		val += h;
+		result[i] = view[i];
 	}
 
 	return result;
 }
 
+template <class Type> RangeMesh<Type> Range<Type>::meshView(long nSteps) const
+{ // lazy mesh, nothing is allocated
+	return RangeMesh<Type>(lo, hi, nSteps);
+}
+
 #endif //Range_CPP
\ No newline at end of file
@@ -3,6 +3,22 @@
 
 #include <vector>
 
+template <class Type> class RangeMesh
+{ // lazy uniform mesh over a range, point i is computed as lo + i * h so there is no drift and no allocation
+	private:
+		Type lo;
+		Type hi;
+		Type h;
+		long n;
+
+	public:
+		RangeMesh(const Type& low, const Type& high, long nSteps);	// parameter constructor
+
+		Type operator [] (long index) const;		// mesh point, index 0 .. nSteps, the last point is exactly high
+		long size() const;							// number of points, nSteps + 1
+		Type step() const;							// mesh size h
+};
+
 template <class Type> class Range
 {
 	private:
@@ -29,6 +45,7 @@ template <class Type> class Range
 		
 		// utility functions
 		std::vector<Type> mesh(long nSteps) const;	// create a discrete mesh
+		RangeMesh<Type> meshView(long nSteps) const;	// same mesh without materializing it
 
 		// operator overloading
 		Range<Type>& operator = (const Range<Type>& ran2);
@@ -1,7 +1,14 @@
 #include "OptionData.hpp" 
 #include "NormalGenerator.hpp"
+#include "AdaptiveMC.hpp"
+#include "MultiAssetMC.hpp"
+#include "LongstaffSchwartz.hpp"
+#include "MultilevelMC.hpp"
+#include "CheckpointedMC.hpp"
 #include "Range.cpp"
 #include <cmath>
+#include <cstdio>
+#include <functional>
 #include <vector>
 #include <iostream>
 
@@ -38,6 +45,12 @@ namespace SDEDefinition
 		return data->sig * pow(X, betaCEV);
 	}
 
+	double diffusionSlope(double t, double X)
+	{ // d diffusion / dX, needed by the multilevel Milstein scheme
+		double betaCEV = 1.0;
+		return data->sig * betaCEV * pow(X, betaCEV - 1.0);
+	}
+
 	double diffusionDerivative(double t, double X)
 	{ // diffusion term, needed for the Milstein method
 		double betaCEV = 1.0;
@@ -78,6 +91,52 @@ double StandardError(const std::vector<double>& NSIM, double r, double T)
     return sd / sqrt(static_cast<double>(NSIM.size()));
 }
 
+int EulerPaths(OptionData& option, double S0, long N, long NSim, NormalGenerator& normal, std::vector<double>& payoffs, const std::function<void(long, long)>& progress)
+{ // NSim explicit Euler paths of the SDE on N subintervals of [0, T], payoffs appended in path order
+  // progress(done, NSim) after every 10000th path, returns the number of times S hits origin
+
+	// create the basic SDE (Context class)
+	Range<double> range (0.0, option.T);
+	RangeMesh<double> x = range.meshView(N);	// time points computed on demand
+
+	double k = x.step();
+	double sqrk = sqrt(k);
+
+	double VOld = S0;
+	double VNew = S0;
+	int coun = 0;
+
+	for (long i = 1; i <= NSim; ++i)
+	{ // calculate a path at each iteration
+
+		if ((i/10000) * 10000 == i)
+		{ // give status after each 10000th iteration
+			progress(i, NSim);
+		}
+
+		VOld = S0;
+		for (long index = 1; index < x.size(); ++index)
+		{
+			// create a random number
+			double dW = normal.getNormal();
+
+			// the FDM (in this case explicit Euler)
+			VNew = VOld  + (k * SDEDefinition::drift(x[index-1], VOld)) + (sqrk * SDEDefinition::diffusion(x[index-1], VOld) * dW);
+			VOld = VNew;
+
+			// spurious values
+			if (VNew <= 0.0)
+			{
+				coun++;
+			}
+		}
+
+		payoffs.push_back(option.myPayOffFunction(VNew));
+	}
+
+	return coun;
+}
+
 int main()
 {
 	std::cout << "1 factor MC with explicit Euler\n";
@@ -99,78 +158,156 @@ int main()
 	std::cout << "Number of subintervals in time: ";
 	std::cin >> N;
 
-	// create the basic SDE (Context class)
-	Range<double> range (0.0, myOption.T);
-	double VOld = S_0;
-	double VNew;
-
-	std::vector<double> x = range.mesh(N);
-	
 	// V2 mediator stuff
 	long NSim = 50000;
 	std::cout << "Number of simulations: ";
 	std::cin >> NSim;
 
-	double k = myOption.T / double (N);
-	double sqrk = sqrt(k);
-
-	// normal random number
-	double dW;
-	double price = 0.0;	// option price
-	std::vector<double> payoffs;
-
 	// normalGenerator is a base class
 	NormalGenerator* myNormal = new BoostNormal();
 
 	using namespace SDEDefinition;
 	SDEDefinition::data = &myOption;
 
-	std::vector<double> res;
-	int coun = 0; // number of times S hits origin
-
-	for (long i = 1; i <= NSim; ++i)
-	{ // calculate a path at each iteration
-			
-		if ((i/10000) * 10000 == i)
-		{ // give status after each 1000th iteration
-			std::cout << i << std::endl;
-		}
-
-		VOld = S_0;
-		for (unsigned long index = 1; index < x.size(); ++index)
-		{
-			// create a random number
-			dW = myNormal->getNormal();
-				
-			// the FDM (in this case explicit Euler)
-			VNew = VOld  + (k * drift(x[index-1], VOld)) + (sqrk * diffusion(x[index-1], VOld) * dW);
-			VOld = VNew;
+	// the simulation reports its status through the callback, printing is left to the caller
+	std::vector<double> payoffs;
+	int coun = EulerPaths(myOption, S_0, N, NSim, *myNormal, payoffs, [](long done, long total) { (void)total; std::cout << done << std::endl; });
 
-			// spurious values
-			if (VNew <= 0.0) 
-			{
-				coun++;
-			}
-		}
-			
-		double tmp = myOption.myPayOffFunction(VNew);
-		payoffs.push_back(tmp);
-		price += (tmp)/double(NSim);
+	double price = 0.0;	// option price
+	for (std::vector<double>::const_iterator itr = payoffs.begin(); itr != payoffs.end(); ++itr)
+	{
+		price += (*itr)/double(NSim);
 	}
-	
+
 	// finally, discounting the average price
 	price *= exp(-myOption.r * myOption.T);
 	double sd = StandardDeviation(payoffs, myOption.r, myOption.T);
 	double se = StandardError(payoffs, myOption.r, myOption.T);
 
-	// cleanup; V2 use scoped pointer
-	delete myNormal;
-
 	// output MC results
 	std::cout << "Price, after discounting: " << price << std::endl;
 	std::cout << "Standard Deviation: " << sd << std::endl;
 	std::cout << "Standard Error: " << se << std::endl;
 	std::cout << "Number of times origin is hit: " << coun << std::endl;
 
+	// adaptive runs on the same SDE and time mesh, paths in batches until the error target or the time budget is met
+	AdaptiveMC adaptive(myOption, S_0, N, drift, diffusion, *myNormal);
+
+	MCResult target = adaptive.runToError(se, 10 * NSim, 60.0);
+	std::cout << "\nAdaptive MC to the standard error above: " << std::endl;
+	std::cout << "Price: " << target.price << ", Standard Error: " << target.standardError << ", Paths: " << target.paths
+		<< (target.reason == MC_TARGET_MET ? " (target met)" : " (stopped early)") << std::endl;
+
+	MCResult relative = adaptive.runToRelativeError(0.01, 10 * NSim, 60.0);
+	std::cout << "Adaptive MC to 1% relative error: " << std::endl;
+	std::cout << "Price: " << relative.price << ", Standard Error: " << relative.standardError << ", Paths: " << relative.paths << std::endl;
+
+	MCResult budget = adaptive.runForTime(0.5);
+	std::cout << "Adaptive MC for 0.5 seconds: " << std::endl;
+	std::cout << "Price: " << budget.price << ", Standard Error: " << budget.standardError << ", Paths: " << budget.paths
+		<< ", Seconds: " << budget.seconds << std::endl;
+
+	// budget shorter than one full batch, the pilot times the paths and the next batch shrinks to fit
+	MCResult tight = adaptive.runForTime(0.002);
+	std::cout << "Adaptive MC for 0.002 seconds: Paths: " << tight.paths << ", Seconds: " << tight.seconds << std::endl;
+
+	// correlated multi-asset runs, one time step since the GBM step is exact for european payoffs
+	MultiAssetData spread;
+	spread.S0 = { 100.0, 95.0 };
+	spread.sig = { 0.2, 0.25 };
+	spread.correlation = { { 1.0, 0.6 }, { 0.6, 1.0 } };
+	spread.K = 5.0;
+	spread.T = 1.0;
+	spread.r = 0.05;
+	spread.payoff = SPREAD_CALL;
+
+	MCResult spreadResult = MultiAssetMC(spread, 1, *myNormal).run(NSim);
+	std::cout << "\nSpread call (rho = 0.6): " << spreadResult.price << ", Standard Error: " << spreadResult.standardError << std::endl;
+
+	// equally weighted basket call on 50 names, pairwise correlation 0.3
+	MultiAssetData basket;
+	basket.S0.assign(50, 100.0);
+	basket.sig.assign(50, 0.3);
+	basket.correlation.assign(50, std::vector<double>(50, 0.3));
+	for (size_t i = 0; i < 50; ++i)
+	{
+		basket.correlation[i][i] = 1.0;
+	}
+	basket.K = 100.0;
+	basket.T = 1.0;
+	basket.r = 0.05;
+	basket.payoff = BASKET_CALL;
+
+	MCResult basketResult = MultiAssetMC(basket, 1, *myNormal).run(NSim);
+	std::cout << "Basket call on 50 names: " << basketResult.price << ", Standard Error: " << basketResult.standardError
+		<< ", Seconds: " << basketResult.seconds << std::endl;
+
+	// american put by least squares MC, Longstaff and Schwartz (2001) table 1: S = 36, K = 40, sig = 0.2, r = 0.06, T = 1 gives 4.478
+	OptionData american;
+	american.K = 40.0;
+	american.T = 1.0;
+	american.r = 0.06;
+	american.sig = 0.2;
+	american.D = 0.0;
+	american.type = -1;
+
+	LongstaffSchwartz lsm(american, 36.0, 50, 10 * NSim);
+	MCResult lsmResult = lsm.price();
+	std::cout << "\nAmerican put (LSM, 50 dates): " << lsmResult.price << ", Standard Error: " << lsmResult.standardError
+		<< ", Paths: " << lsmResult.paths << ", Path memory (MB): " << lsm.pathMemory() / 1.0e6 << std::endl;
+
+	// multilevel MC on the same SDE, levels of 4 * 2^l steps, paths per level chosen for a root mean square error of 0.02
+	myOption.H = 0.0;
+	MultilevelMC mlmc(myOption, S_0, 4, drift, diffusion, *myNormal);
+	MLMCResult mlmcEuler = mlmc.run(0.02);
+	std::cout << "\nMultilevel MC (Euler): " << mlmcEuler.price << ", Standard Error: " << mlmcEuler.standardError
+		<< ", Levels: " << mlmcEuler.levels << ", Cost saving vs single level: " << mlmcEuler.singleLevelCost / mlmcEuler.cost << "x" << std::endl;
+
+	mlmc.milstein(diffusionSlope);
+	mlmc.payoffKind(MLMC_ASIAN);
+	MLMCResult mlmcAsian = mlmc.run(0.02);
+	std::cout << "Multilevel MC (Milstein, Asian): " << mlmcAsian.price << ", Standard Error: " << mlmcAsian.standardError
+		<< ", Levels: " << mlmcAsian.levels << ", Cost saving vs single level: " << mlmcAsian.singleLevelCost / mlmcAsian.cost << "x" << std::endl;
+
+	// counter-based generator, the same paths in any order, here every other path first
+	PhiloxNormal philox(2025);
+	MCStatistics forward, interleaved;
+	for (int pass = 0; pass < 2; ++pass)
+	{
+		for (long i = 0; i < NSim; ++i)
+		{
+			long p = (pass == 0) ? i : ((i < (NSim + 1) / 2) ? 2 * i : 2 * (i - (NSim + 1) / 2) + 1);
+			double ST = S_0 * exp((myOption.r - 0.5 * myOption.sig * myOption.sig) * myOption.T + myOption.sig * sqrt(myOption.T) * philox.normalAt(p, 0));
+			(pass == 0 ? forward : interleaved).add(myOption.myPayOffFunction(ST));
+		}
+	}
+	std::cout << "\nPhilox price, path order: " << forward.mean() * exp(-myOption.r * myOption.T)
+		<< ", interleaved order: " << interleaved.mean() * exp(-myOption.r * myOption.T) << std::endl;
+
+	// checkpointed run: half the paths, "interrupted", then resumed from the file and extended to the full count
+	std::remove("TestMC.ckpt");
+	CheckpointedMC first(myOption, S_0, N, drift, diffusion, 2025, "TestMC.ckpt");
+	first.run(NSim / 2);
+
+	CheckpointedMC resumed(myOption, S_0, N, drift, diffusion, 2025, "TestMC.ckpt");
+	bool loaded = resumed.resume();
+	MCResult extended = resumed.run(NSim);
+
+	// same seed and file but a different time mesh, the checkpoint belongs to another simulation
+	CheckpointedMC other(myOption, S_0, 2 * N, drift, diffusion, 2025, "TestMC.ckpt");
+	bool mixed = other.resume();
+
+	CheckpointedMC uninterrupted(myOption, S_0, N, drift, diffusion, 2025, "");
+	MCResult straight = uninterrupted.run(NSim);
+
+	std::cout << "\nCheckpoint resumed: " << (loaded ? "yes" : "no") << ", paths: " << extended.paths << std::endl;
+	std::cout << "Checkpoint resumed with twice the time steps: " << (mixed ? "yes" : "no") << std::endl;
+	std::cout << "Resumed price: " << extended.price << ", Standard Error: " << extended.standardError << std::endl;
+	std::cout << "Uninterrupted price: " << straight.price << ", Standard Error: " << straight.standardError << std::endl;
+	std::remove("TestMC.ckpt");
+
+	// cleanup; V2 use scoped pointer
+	delete myNormal;
+
 	return 0;
 }
\ No newline at end of file
@@ -0,0 +1,288 @@
+#include "BaroneAdesiWhaley.hpp"
+#include <boost/math/distributions/normal.hpp>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+
+using namespace boost::math;
+
+namespace AidanRicher {
+namespace Engine {
+
+namespace {
+
+const size_t MAX_ITERATIONS = 100;      // Newton steps before giving up on the critical price
+const double TOLERANCE = 1e-10;         // relative residual of the critical price equation
+
+} // namespace
+
+// default constructor
+BaroneAdesiWhaley::BaroneAdesiWhaley() : m_data(), m_call(true) { }
+
+// parameter constructor
+BaroneAdesiWhaley::BaroneAdesiWhaley(const OptionData& data, const bool call) : m_data(data), m_call(call) { }
+
+// copy constructor
+BaroneAdesiWhaley::BaroneAdesiWhaley(const BaroneAdesiWhaley& other) : m_data(other.m_data), m_call(other.m_call) { }
+
+// virtual destructor
+BaroneAdesiWhaley::~BaroneAdesiWhaley() { }
+
+// assignment operator
+BaroneAdesiWhaley& BaroneAdesiWhaley::operator = (const BaroneAdesiWhaley& other)
+{
+    if (this == &other) { return *this; }   // self-assignment
+
+    m_data = other.m_data;
+    m_call = other.m_call;
+
+    return *this;
+}
+
+// getter functions
+const OptionData& BaroneAdesiWhaley::GetData() const
+{
+    return m_data;
+}
+
+bool BaroneAdesiWhaley::IsCall() const
+{
+    return m_call;
+}
+
+bool BaroneAdesiWhaley::EarlyExercise() const
+{
+    return m_call ? (m_data.B() < m_data.R()) : (m_data.R() > 0.0);
+}
+
+double BaroneAdesiWhaley::Exponent() const
+{ // q2 (call) or q1 (put) of the quadratic approximation
+    double sigma_squared = m_data.Sig() * m_data.Sig();
+    double M = 2.0 * m_data.R() / sigma_squared;
+    double N = 2.0 * m_data.B() / sigma_squared;
+    double K = 1.0 - std::exp(-m_data.R() * m_data.T());
+    double root = std::sqrt((N - 1.0) * (N - 1.0) + 4.0 * M / K);
+
+    return m_call ? 0.5 * (-(N - 1.0) + root) : 0.5 * (-(N - 1.0) - root);
+}
+
+void BaroneAdesiWhaley::European(const double U, double& price, double& delta, double& gamma) const
+{ // generalized black-scholes price, delta and gamma in one pass
+    normal_distribution<> myNormal;
+    double sigRootT = m_data.Sig() * std::sqrt(m_data.T());
+    double d1 = (std::log(U / m_data.K()) + (m_data.B() + 0.5 * m_data.Sig() * m_data.Sig()) * m_data.T()) / sigRootT;
+    double d2 = d1 - sigRootT;
+    double carry = std::exp((m_data.B() - m_data.R()) * m_data.T());
+    double discount = std::exp(-m_data.R() * m_data.T());
+
+    if (m_call)
+    {
+        price = U * carry * cdf(myNormal, d1) - m_data.K() * discount * cdf(myNormal, d2);
+        delta = carry * cdf(myNormal, d1);
+    }
+    else
+    {
+        price = m_data.K() * discount * cdf(myNormal, -d2) - U * carry * cdf(myNormal, -d1);
+        delta = carry * (cdf(myNormal, d1) - 1.0);
+    }
+
+    gamma = carry * pdf(myNormal, d1) / (U * sigRootT);
+}
+
+double BaroneAdesiWhaley::SeedPrice() const
+{ // perpetual (T -> infinity) critical price pulled back towards K for a finite maturity
+    if (!EarlyExercise())
+    {
+        return m_call ? std::numeric_limits<double>::infinity() : 0.0;
+    }
+
+    double sigma_squared = m_data.Sig() * m_data.Sig();
+    double sigRootT = m_data.Sig() * std::sqrt(m_data.T());
+    double N = 2.0 * m_data.B() / sigma_squared;
+    double M = 2.0 * m_data.R() / sigma_squared;
+    double K = m_data.K();
+    double seed;
+
+    if (m_call)
+    {
+        double qInf = 0.5 * (-(N - 1.0) + std::sqrt((N - 1.0) * (N - 1.0) + 4.0 * M));
+        double SInf = K / (1.0 - 1.0 / qInf);
+        double h2 = -(m_data.B() * m_data.T() + 2.0 * sigRootT) * K / (SInf - K);
+        seed = K + (SInf - K) * (1.0 - std::exp(h2));
+    }
+    else
+    {
+        double qInf = 0.5 * (-(N - 1.0) - std::sqrt((N - 1.0) * (N - 1.0) + 4.0 * M));
+        double SInf = K / (1.0 - 1.0 / qInf);
+        double h1 = (m_data.B() * m_data.T() - 2.0 * sigRootT) * K / (K - SInf);
+        seed = SInf + (K - SInf) * std::exp(h1);
+    }
+
+    return seed;
+}
+
+double BaroneAdesiWhaley::CriticalPrice() const
+{
+    size_t iterations = 0;
+    return CriticalPrice(SeedPrice(), iterations);
+}
+
+double BaroneAdesiWhaley::CriticalPrice(const double guess, size_t& iterations) const
+{ // Newton iteration on S - K = c(S) + (1 - e^{(b-r)T} N(d1)) S / q2 (call), K - S = p(S) - (1 - e^{(b-r)T} N(-d1)) S / q1 (put)
+    iterations = 0;
+
+    if (!EarlyExercise())
+    {
+        return m_call ? std::numeric_limits<double>::infinity() : 0.0;
+    }
+
+    normal_distribution<> myNormal;
+    double q = Exponent();
+    double K = m_data.K();
+    double sigRootT = m_data.Sig() * std::sqrt(m_data.T());
+    double carry = std::exp((m_data.B() - m_data.R()) * m_data.T());
+    double S = guess;
+
+    for (; iterations < MAX_ITERATIONS; ++iterations)
+    {
+        double price, delta, gamma;
+        European(S, price, delta, gamma);
+
+        double d1 = (std::log(S / K) + (m_data.B() + 0.5 * m_data.Sig() * m_data.Sig()) * m_data.T()) / sigRootT;
+        double Nd1 = cdf(myNormal, d1);
+        double nd1 = pdf(myNormal, d1);
+        double lhs, rhs, slope;
+
+        if (m_call)
+        {
+            lhs = S - K;
+            rhs = price + (1.0 - carry * Nd1) * S / q;
+            slope = carry * Nd1 * (1.0 - 1.0 / q) + (1.0 - carry * nd1 / sigRootT) / q;
+        }
+        else
+        {
+            lhs = K - S;
+            rhs = price - (1.0 - carry * (1.0 - Nd1)) * S / q;
+            slope = -carry * (1.0 - Nd1) * (1.0 - 1.0 / q) - (1.0 + carry * nd1 / sigRootT) / q;
+        }
+
+        if (std::abs(lhs - rhs) <= TOLERANCE * K) { break; }
+
+        // tangent of the right hand side, intersected with the intrinsic value line
+        S = m_call ? (K + rhs - slope * S) / (1.0 - slope) : (K - rhs + slope * S) / (1.0 + slope);
+
+        if (!(S > 0.0)) { S = 0.5 * K; }        // keep the iterate in the domain of the log
+    }
+
+    return S;
+}
+
+void BaroneAdesiWhaley::Value(const double U, const double critical, double& price, double& delta, double& gamma) const
+{ // european part plus the early exercise premium, intrinsic value past the critical price
+    if (U <= 0.0)
+    {
+        throw std::invalid_argument("Underlying spot price U must be positive.");
+    }
+
+    if (!EarlyExercise())
+    {
+        European(U, price, delta, gamma);
+        return;
+    }
+
+    if (m_call ? (U >= critical) : (U <= critical))
+    {
+        price = m_call ? U - m_data.K() : m_data.K() - U;
+        delta = m_call ? 1.0 : -1.0;
+        gamma = 0.0;
+        return;
+    }
+
+    normal_distribution<> myNormal;
+    double q = Exponent();
+    double d1 = (std::log(critical / m_data.K()) + (m_data.B() + 0.5 * m_data.Sig() * m_data.Sig()) * m_data.T()) / (m_data.Sig() * std::sqrt(m_data.T()));
+    double carry = std::exp((m_data.B() - m_data.R()) * m_data.T());
+
+    // A2 = (S* / q2)(1 - e^{(b-r)T} N(d1(S*))), A1 = -(S** / q1)(1 - e^{(b-r)T} N(-d1(S**)))
+    double A = m_call ? (critical / q) * (1.0 - carry * cdf(myNormal, d1)) : -(critical / q) * (1.0 - carry * cdf(myNormal, -d1));
+    double premium = A * std::pow(U / critical, q);
+
+    European(U, price, delta, gamma);
+    price += premium;
+    delta += q * premium / U;
+    gamma += q * (q - 1.0) * premium / (U * U);
+}
+
+double BaroneAdesiWhaley::Price(const double U) const
+{ // return the price of the american option
+    double price, delta, gamma;
+    Value(U, CriticalPrice(), price, delta, gamma);
+
+    return price;
+}
+
+double BaroneAdesiWhaley::Delta(const double U) const
+{ // return the delta of the american option, analytic in U for a fixed critical price
+    double price, delta, gamma;
+    Value(U, CriticalPrice(), price, delta, gamma);
+
+    return delta;
+}
+
+double BaroneAdesiWhaley::Gamma(const double U) const
+{ // return the gamma of the american option
+    double price, delta, gamma;
+    Value(U, CriticalPrice(), price, delta, gamma);
+
+    return gamma;
+}
+
+void BaroneAdesiWhaley::PriceBatch(const double* U, const size_t n, double* prices, double* deltas, double* gammas) const
+{ // the critical price does not depend on the spot, so it is solved once for the whole array
+    const double critical = CriticalPrice();
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        double price = nan, delta = nan, gamma = nan;
+        if (U[i] > 0.0) { Value(U[i], critical, price, delta, gamma); }
+
+        if (prices) { prices[i] = price; }
+        if (deltas) { deltas[i] = delta; }
+        if (gammas) { gammas[i] = gamma; }
+    }
+}
+
+std::ostream& operator << (std::ostream& os, const BaroneAdesiWhaley& source)
+{ // ostream << operator for option properties
+    os << std::endl;
+    os << "Barone-Adesi-Whaley American " << (source.m_call ? "Call" : "Put") << " Option:\n" <<
+        "K: " << source.m_data.K() << "\n" <<
+        "R: " << source.m_data.R() << "\n" <<
+        "Sig: " << source.m_data.Sig() << "\n" <<
+        "T: " << source.m_data.T() << "\n" <<
+        "B: " << source.m_data.B() << std::endl;
+
+    // return description
+    return os;
+}
+
+// overrides
+std::string BaroneAdesiWhaley::Type() const
+{
+    return m_call ? "Barone-Adesi-Whaley American Call Option" : "Barone-Adesi-Whaley American Put Option";
+}
+
+Option* BaroneAdesiWhaley::Clone() const
+{
+    return new BaroneAdesiWhaley(*this);
+}
+
+Option* BaroneAdesiWhaley::Clone(const OptionData& data) const
+{
+    return new BaroneAdesiWhaley(data, m_call);
+}
+
+} // namespace Engine
+} // namespace AidanRicher
@@ -0,0 +1,79 @@
+#ifndef BaroneAdesiWhaley_HPP
+#define BaroneAdesiWhaley_HPP
+
+#include "Option.hpp"
+#include "OptionData.hpp"
+#include <cstddef>
+#include <string>
+#include <iostream>
+
+namespace AidanRicher {
+namespace Engine {
+
+// finite maturity american option, Barone-Adesi and Whaley (1987) quadratic approximation
+// price = european + A * (U / S*)^q below the critical price S* (above it for puts), intrinsic value past it
+class BaroneAdesiWhaley : public Option {
+    private:
+        OptionData m_data;          // holds fixed contract params (k, r, sig, t, b)
+        bool m_call;                // call (true) or put (false)
+
+        double Exponent() const;                                                    // q2 for calls, q1 for puts
+        void European(const double U, double& price, double& delta, double& gamma) const;     // black-scholes-merton price and greeks
+
+    public:
+        // default constructor, american call
+        BaroneAdesiWhaley();
+
+        // parameter constructor
+        BaroneAdesiWhaley(const OptionData& data, const bool call);
+
+        // copy constructor
+        BaroneAdesiWhaley(const BaroneAdesiWhaley& other);
+
+        // destructor
+        virtual ~BaroneAdesiWhaley();
+
+        // assignment operator
+        BaroneAdesiWhaley& operator = (const BaroneAdesiWhaley& other);
+
+        // getter for const reference to option data
+        const OptionData& GetData() const;
+        bool IsCall() const;
+
+        // false when early exercise is never optimal (calls with b >= r, puts with r <= 0), the price is then the european one
+        bool EarlyExercise() const;
+
+        // starting guess for the critical price, interpolated between K and the perpetual critical price
+        double SeedPrice() const;
+
+        // critical spot price S*, solved by Newton iteration on the smooth pasting condition
+        // the first form starts from SeedPrice(), the second from a caller supplied guess
+        // (e.g. the critical price of a neighbouring contract), iterations receives the Newton steps taken
+        double CriticalPrice() const;
+        double CriticalPrice(const double guess, size_t& iterations) const;
+
+        // price, delta and gamma for a given critical price, no iteration
+        void Value(const double U, const double critical, double& price, double& delta, double& gamma) const;
+
+        // core methods
+        double Price(const double U) const override;                            // return the price of the option
+        double Delta(const double U) const override;                            // return the delta of the option
+        double Gamma(const double U) const override;                            // return the gamma of the option
+
+        // price, delta and gamma over an array of spots with the critical price solved once, any output pointer may be nullptr
+        // spots that are not positive give NaN instead of throwing
+        void PriceBatch(const double* U, const size_t n, double* prices, double* deltas, double* gammas) const;
+
+        // ostream << operator
+        friend std::ostream& operator << (std::ostream& os, const BaroneAdesiWhaley& source);
+
+        // overrides of pure virtual methods from Option base class
+        virtual std::string Type() const override;
+        virtual Option* Clone() const override;
+        virtual Option* Clone(const OptionData& data) const override;
+};
+
+} // namespace Engine
+} // namespace AidanRicher
+
+#endif // BaroneAdesiWhaley_HPP
@@ -0,0 +1,299 @@
+#include "BatchPricer.hpp"
+#include "BaroneAdesiWhaley.hpp"
+#include "BjerksundStensland.hpp"
+#include "ArrayException.hpp"
+#include <cmath>
+#include <limits>
+#include <vector>
+
+using namespace AidanRicher::Containers;
+
+namespace AidanRicher {
+namespace Engine {
+
+namespace {
+
+const double INV_SQRT_2 = 0.70710678118654752440;      // 1 / sqrt(2)
+const double INV_SQRT_2PI = 0.39894228040143267794;    // 1 / sqrt(2 pi)
+
+// standard normal cdf and pdf, erfc keeps full precision in both tails
+inline double NormalCdf(const double x) { return 0.5 * std::erfc(-x * INV_SQRT_2); }
+inline double NormalPdf(const double x) { return INV_SQRT_2PI * std::exp(-0.5 * x * x); }
+
+// perpetual american price for a given exponent y (y1 for calls, y2 for puts)
+inline double PerpetualPrice(const bool call, const double y, const double K, const double U)
+{
+    double rhs = ((y - 1.0) / y) * (U / K);
+    return (call ? K / (y - 1.0) : K / (1.0 - y)) * std::pow(rhs, y);
+}
+
+// perpetual american exponent, y1 for calls and y2 for puts
+inline double PerpetualExponent(const bool call, const double r, const double sig, const double b)
+{
+    double sigma_squared = sig * sig;
+    double root = std::sqrt(std::pow((b / sigma_squared - 0.5), 2.0) + (2.0 * r / sigma_squared));
+    return call ? 0.5 - (b / sigma_squared) + root : 0.5 - (b / sigma_squared) - root;
+}
+
+// one european contract, discount = exp(-r * T) and carry = exp((b - r) * T) supplied by the caller
+inline void EuropeanElement(const bool call, const GridColumns& g, const size_t i, const double discount, const double carry, double* prices, double* deltas, double* gammas)
+{
+    const double U = g.spots[i];
+    const double K = g.strikes[i];
+    const double T = g.maturities[i];
+    const double sigRootT = g.vols[i] * std::sqrt(T);
+    const double d1 = (std::log(U / K) + (g.carry[i] + 0.5 * g.vols[i] * g.vols[i]) * T) / sigRootT;
+    const double d2 = d1 - sigRootT;
+    const double Nd1 = NormalCdf(call ? d1 : -d1);      // N(d1) for calls, N(-d1) for puts, never 1 - N(d1)
+
+    if (prices)
+    {
+        prices[i] = call ? U * carry * Nd1 - K * discount * NormalCdf(d2)
+                         : K * discount * NormalCdf(-d2) - U * carry * Nd1;
+    }
+
+    if (deltas) { deltas[i] = call ? carry * Nd1 : -carry * Nd1; }
+    if (gammas) { gammas[i] = carry * NormalPdf(d1) / (U * sigRootT); }
+}
+
+void EuropeanBatch(const bool call, const GridColumns& g, double* prices, double* deltas, double* gammas)
+{
+    for (size_t i = 0; i < g.size; ++i)
+    {
+        const double T = g.maturities[i];
+        const double discount = prices ? std::exp(-g.rates[i] * T) : 0.0;
+        EuropeanElement(call, g, i, discount, std::exp((g.carry[i] - g.rates[i]) * T), prices, deltas, gammas);
+    }
+}
+
+void EuropeanBatch(const bool call, const GridColumns& g, const double* discounts, const double* carryFactors, double* prices, double* deltas, double* gammas)
+{ // no exponentials left per contract beyond the normal cdf
+    for (size_t i = 0; i < g.size; ++i)
+    {
+        EuropeanElement(call, g, i, discounts[i], carryFactors[i], prices, deltas, gammas);
+    }
+}
+
+void PerpetualBatch(const bool call, const GridColumns& g, double* prices, double* deltas, double* gammas)
+{ // power law in U, so delta = y * V / U and gamma = y * (y - 1) * V / U^2
+    for (size_t i = 0; i < g.size; ++i)
+    {
+        const double U = g.spots[i];
+        const double y = PerpetualExponent(call, g.rates[i], g.vols[i], g.carry[i]);       // once per contract
+        const double V = PerpetualPrice(call, y, g.strikes[i], U);
+
+        if (prices) { prices[i] = V; }
+        if (deltas) { deltas[i] = y * V / U; }
+        if (gammas) { gammas[i] = y * (y - 1.0) * V / (U * U); }
+    }
+}
+
+// the ValidateBatch domain checks for a finite maturity contract
+// the american kernels call into boost, which throws on NaN, so they test every row before solving
+inline bool InDomain(const GridColumns& g, const size_t i)
+{
+    const double K = g.strikes[i];
+    const double sig = g.vols[i];
+    const double T = g.maturities[i];
+    const double U = g.spots[i];
+
+    return std::isfinite(K) && std::isfinite(g.rates[i]) && std::isfinite(sig) && std::isfinite(T) && std::isfinite(g.carry[i]) && std::isfinite(U)
+        && K > 0.0 && sig > 0.0 && T > 0.0 && U > 0.0;
+}
+
+size_t BAWCritical(const bool call, const GridColumns& g, double* critical)
+{ // S* is proportional to K for fixed r, sig, T, b, so the previous ratio is a close guess along a chain
+    size_t total = 0;
+    double ratio = 0.0;
+
+    for (size_t i = 0; i < g.size; ++i)
+    {
+        if (!InDomain(g, i))
+        { // no solve, and the warm start carries over to the next good row
+            critical[i] = std::numeric_limits<double>::quiet_NaN();
+            continue;
+        }
+
+        BaroneAdesiWhaley opt(OptionData(g.strikes[i], g.rates[i], g.vols[i], g.maturities[i], g.carry[i]), call);
+        size_t iterations = 0;
+
+        critical[i] = opt.CriticalPrice((ratio > 0.0) ? ratio * g.strikes[i] : opt.SeedPrice(), iterations);
+        total += iterations;
+
+        const double next = critical[i] / g.strikes[i];
+        ratio = (std::isfinite(next) && next > 0.0) ? next : 0.0;      // no warm start across rows without early exercise
+    }
+
+    return total;
+}
+
+void BAWBatch(const bool call, const GridColumns& g, double* prices, double* deltas, double* gammas)
+{ // critical prices first, then closed form price and greeks per contract
+    std::vector<double> critical(g.size);
+    BAWCritical(call, g, critical.data());
+
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    for (size_t i = 0; i < g.size; ++i)
+    {
+        double price = nan, delta = nan, gamma = nan;
+        if (InDomain(g, i))
+        {
+            BaroneAdesiWhaley opt(OptionData(g.strikes[i], g.rates[i], g.vols[i], g.maturities[i], g.carry[i]), call);
+            opt.Value(g.spots[i], critical[i], price, delta, gamma);
+        }
+
+        if (prices) { prices[i] = price; }
+        if (deltas) { deltas[i] = delta; }
+        if (gammas) { gammas[i] = gamma; }
+    }
+}
+
+void BSBatch(const bool call, const GridColumns& g, double* prices, double* deltas, double* gammas)
+{ // closed form, nothing to share between contracts
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    for (size_t i = 0; i < g.size; ++i)
+    {
+        if (!InDomain(g, i))
+        {
+            if (prices) { prices[i] = nan; }
+            if (deltas) { deltas[i] = nan; }
+            if (gammas) { gammas[i] = nan; }
+            continue;
+        }
+
+        BjerksundStensland opt(OptionData(g.strikes[i], g.rates[i], g.vols[i], g.maturities[i], g.carry[i]), call);
+        opt.PriceBatch(g.spots + i, 1, prices ? prices + i : nullptr, deltas ? deltas + i : nullptr, gammas ? gammas + i : nullptr);
+    }
+}
+
+} // namespace
+
+size_t ValidateBatch(const std::string& type, const GridColumns& grid, uint8_t* status)
+{
+    const bool european = (type == "EuropeanCall" || type == "EuropeanPut");
+    const bool american = (type == "BAWAmericanCall" || type == "BAWAmericanPut" || type == "BSAmericanCall" || type == "BSAmericanPut");
+    const bool perpCall = (type == "PerpAmericanCall");
+
+    if (!european && !american && !perpCall && type != "PerpAmericanPut")
+    {
+        throw UnexpectedInputException();
+    }
+
+    size_t invalid = 0;
+
+    for (size_t i = 0; i < grid.size; ++i)
+    {
+        const double K = grid.strikes[i];
+        const double r = grid.rates[i];
+        const double sig = grid.vols[i];
+        const double T = grid.maturities[i];
+        const double b = grid.carry[i];
+        const double U = grid.spots[i];
+
+        uint8_t s = BATCH_VALID;
+
+        if (!std::isfinite(K) || !std::isfinite(r) || !std::isfinite(sig) || !std::isfinite(T) || !std::isfinite(b) || !std::isfinite(U))
+        {
+            s |= BATCH_NOT_FINITE;
+        }
+        if (!(U > 0.0)) { s |= BATCH_BAD_SPOT; }
+        if (!(K > 0.0)) { s |= BATCH_BAD_STRIKE; }
+        if (!(sig > 0.0)) { s |= BATCH_BAD_VOL; }
+
+        if (european || american)
+        {
+            if (!(T > 0.0)) { s |= BATCH_BAD_MATURITY; }
+        }
+        else if (!(r > 0.0) || (perpCall && !(b < r)))
+        { // y2 < 0 needs r > 0, y1 > 1 also needs b < r
+            s |= BATCH_NO_SOLUTION;
+        }
+
+        status[i] = s;
+        if (s != BATCH_VALID) { ++invalid; }
+    }
+
+    return invalid;
+}
+
+void PriceBatch(const std::string& type, const GridColumns& grid, double* prices)
+{
+    GreeksBatch(type, grid, prices, nullptr, nullptr);
+}
+
+void GreeksBatch(const std::string& type, const GridColumns& grid, double* prices, double* deltas, double* gammas)
+{ // dispatch on type once per batch rather than once per element
+    if (type == "EuropeanCall")
+    {
+        EuropeanBatch(true, grid, prices, deltas, gammas);
+    }
+    else if (type == "EuropeanPut")
+    {
+        EuropeanBatch(false, grid, prices, deltas, gammas);
+    }
+    else if (type == "PerpAmericanCall")
+    {
+        PerpetualBatch(true, grid, prices, deltas, gammas);
+    }
+    else if (type == "PerpAmericanPut")
+    {
+        PerpetualBatch(false, grid, prices, deltas, gammas);
+    }
+    else if (type == "BAWAmericanCall" || type == "BAWAmericanPut")
+    {
+        BAWBatch(type == "BAWAmericanCall", grid, prices, deltas, gammas);
+    }
+    else if (type == "BSAmericanCall" || type == "BSAmericanPut")
+    {
+        BSBatch(type == "BSAmericanCall", grid, prices, deltas, gammas);
+    }
+    else
+    {
+        throw UnexpectedInputException();
+    }
+}
+
+void GreeksBatch(const std::string& type, const GridColumns& grid, double* prices, double* deltas, double* gammas, const double* discounts, const double* carryFactors)
+{ // the other kernels read the rate and carry columns, silently ignoring the factors would price on a different curve
+    if (type == "EuropeanCall")
+    {
+        EuropeanBatch(true, grid, discounts, carryFactors, prices, deltas, gammas);
+    }
+    else if (type == "EuropeanPut")
+    {
+        EuropeanBatch(false, grid, discounts, carryFactors, prices, deltas, gammas);
+    }
+    else
+    {
+        throw UnexpectedInputException();
+    }
+}
+
+void GreeksBatch(const std::string& type, const GridColumns& grid, double* prices, double* deltas, double* gammas, const uint8_t* status)
+{
+    GreeksBatch(type, grid, prices, deltas, gammas);
+
+    // separate masking pass keeps the pricing loop free of branches on the status
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    for (size_t i = 0; i < grid.size; ++i)
+    {
+        if (status[i] == BATCH_VALID) { continue; }
+
+        if (prices) { prices[i] = nan; }
+        if (deltas) { deltas[i] = nan; }
+        if (gammas) { gammas[i] = nan; }
+    }
+}
+
+size_t CriticalPriceBatch(const std::string& type, const GridColumns& grid, double* critical)
+{
+    if (type != "BAWAmericanCall" && type != "BAWAmericanPut")
+    {
+        throw UnexpectedInputException();
+    }
+
+    return BAWCritical(type == "BAWAmericanCall", grid, critical);
+}
+
+} // namespace Engine
+} // namespace AidanRicher
@@ -0,0 +1,68 @@
+#ifndef BatchPricer_HPP
+#define BatchPricer_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace AidanRicher {
+namespace Engine {
+
+// non-owning view of contiguous parameter columns, element i is one contract
+// the columns can live in vectors, a MatrixParameters row or a memory-mapped file
+struct GridColumns {
+    const double* strikes;
+    const double* rates;
+    const double* vols;
+    const double* maturities;
+    const double* carry;
+    const double* spots;
+    size_t size;
+};
+
+// per-element validation status, a bitmask so a row can carry several reasons
+enum BatchStatus : uint8_t {
+    BATCH_VALID = 0,
+    BATCH_BAD_SPOT = 1,         // spot not positive
+    BATCH_BAD_STRIKE = 2,       // strike not positive
+    BATCH_BAD_VOL = 4,          // volatility zero or negative
+    BATCH_BAD_MATURITY = 8,     // european or finite maturity american option with T <= 0
+    BATCH_NOT_FINITE = 16,      // NaN or infinite input
+    BATCH_NO_SOLUTION = 32      // perpetual without a finite price (r <= 0, or b >= r for calls)
+};
+
+// one-time validation pass, status[i] receives the BatchStatus bits for contract i
+// returns the number of invalid contracts, throws UnexpectedInputException for an unknown type
+size_t ValidateBatch(const std::string& type, const GridColumns& grid, uint8_t* status);
+
+// batch kernels over whole columns, type uses the PricingMatrix names
+// ("EuropeanCall", "EuropeanPut", "PerpAmericanCall", "PerpAmericanPut")
+// plus the finite maturity american approximations ("BAWAmericanCall", "BAWAmericanPut" for Barone-Adesi-Whaley,
+// "BSAmericanCall", "BSAmericanPut" for Bjerksund-Stensland 2002)
+// inputs are not validated per element, out of domain rows come back as NaN rather than throwing
+
+// prices[i] for every contract in the grid
+void PriceBatch(const std::string& type, const GridColumns& grid, double* prices);
+
+// price, delta and gamma in one pass, any output pointer may be nullptr to skip it
+void GreeksBatch(const std::string& type, const GridColumns& grid, double* prices, double* deltas, double* gammas);
+
+// as above with the european discount factors precomputed, e.g. per expiry from a CurveCache
+// discounts[i] = exp(-r * T) and carryFactors[i] = exp((b - r) * T)
+// only "EuropeanCall" and "EuropeanPut" take precomputed factors, other types throw UnexpectedInputException
+void GreeksBatch(const std::string& type, const GridColumns& grid, double* prices, double* deltas, double* gammas, const double* discounts, const double* carryFactors);
+
+// as above, then every output of a contract with status[i] != BATCH_VALID is set to NaN
+// the kernels themselves stay check-free, so bad rows cost no more than good ones
+void GreeksBatch(const std::string& type, const GridColumns& grid, double* prices, double* deltas, double* gammas, const uint8_t* status);
+
+// Barone-Adesi-Whaley critical prices for every contract ("BAWAmericanCall" or "BAWAmericanPut")
+// each Newton solve is warm started from S* / K of the previous contract, so neighbouring rows of a chain converge in a step or two
+// returns the total number of Newton iterations, contracts without early exercise get +infinity (calls) or 0 (puts)
+// contracts failing the ValidateBatch domain checks get NaN and are not solved
+size_t CriticalPriceBatch(const std::string& type, const GridColumns& grid, double* critical);
+
+} // namespace Engine
+} // namespace AidanRicher
+
+#endif // BatchPricer_HPP
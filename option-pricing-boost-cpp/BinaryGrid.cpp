@@ -0,0 +1,382 @@
+#include "BinaryGrid.hpp"
+#include "ArrayException.hpp"
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace AidanRicher::Containers;
+
+namespace AidanRicher {
+namespace Engine {
+
+namespace {
+
+const char GRID_MAGIC[8] = "OPFGRID";
+const char RESULT_MAGIC[8] = "OPFRSLT";
+const uint32_t FORMAT_VERSION = 1;
+const uint32_t BYTE_ORDER_MARK = 0x01020304;
+const size_t HEADER_SIZE = 64;
+const size_t COLUMN_ALIGNMENT = 64;
+const size_t GRID_COLUMNS = 6;
+
+static_assert(sizeof(BinaryGridHeader) == HEADER_SIZE, "BinaryGridHeader must be 64 bytes");
+
+// bytes between column starts, rounded up so every column is cache line aligned
+size_t ColumnStride(const size_t count)
+{
+    size_t bytes = count * sizeof(double);
+    return (bytes + COLUMN_ALIGNMENT - 1) / COLUMN_ALIGNMENT * COLUMN_ALIGNMENT;
+}
+
+size_t ColumnCount(const uint64_t mask)
+{
+    return ((mask & RESULT_PRICE) ? 1 : 0) + ((mask & RESULT_DELTA) ? 1 : 0) + ((mask & RESULT_GAMMA) ? 1 : 0);
+}
+
+void ThrowIOError(const std::string& what, const std::string& path)
+{
+    throw std::runtime_error(what + " '" + path + "': " + std::strerror(errno));
+}
+
+// write all bytes at offset, retrying short writes
+void WriteAll(const int fd, const void* data, size_t bytes, off_t offset, const std::string& path)
+{
+    const char* p = static_cast<const char*>(data);
+
+    while (bytes > 0)
+    {
+        ssize_t written = ::pwrite(fd, p, bytes, offset);
+        if (written < 0)
+        {
+            if (errno == EINTR) { continue; }
+            ThrowIOError("Failed to write", path);
+        }
+
+        p += written;
+        bytes -= static_cast<size_t>(written);
+        offset += written;
+    }
+}
+
+BinaryGridHeader MakeHeader(const char* magic, const size_t columns, const size_t rows, const size_t cols, const uint64_t mask)
+{
+    BinaryGridHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, magic, sizeof(header.magic));
+    header.version = FORMAT_VERSION;
+    header.byteOrder = BYTE_ORDER_MARK;
+    header.columns = columns;
+    header.rows = rows;
+    header.cols = cols;
+    header.count = rows * cols;
+    header.columnStride = ColumnStride(rows * cols);
+    header.columnMask = mask;
+
+    return header;
+}
+
+// create the file, write the header and size it so every column exists
+int CreateColumnFile(const std::string& path, const BinaryGridHeader& header)
+{
+    int fd = ::open(path.c_str(), O_CREAT | O_TRUNC | O_RDWR, 0644);
+    if (fd < 0) { ThrowIOError("Failed to create", path); }
+
+    try
+    {
+        WriteAll(fd, &header, sizeof(header), 0, path);
+        if (::ftruncate(fd, static_cast<off_t>(HEADER_SIZE + header.columns * header.columnStride)) != 0)
+        {
+            ThrowIOError("Failed to size", path);
+        }
+    }
+    catch (...)
+    {
+        ::close(fd);
+        throw;
+    }
+
+    return fd;
+}
+
+} // namespace
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// parameter grid files                                                                                            //
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void WriteBinaryGrid(const std::string& path, const MatrixParameters& params)
+{
+    const std::vector<std::vector<double>>* fields[GRID_COLUMNS] = { &params.GetStrikes(), &params.GetRates(), &params.GetVols(), &params.GetMaturities(), &params.GetCarry(), &params.GetSpots() };
+
+    // the file format is rectangular, every row of every matrix must have the same length
+    const size_t rows = fields[0]->size();
+    const size_t cols = (rows > 0) ? (*fields[0])[0].size() : 0;
+
+    for (size_t f = 0; f < GRID_COLUMNS; ++f)
+    {
+        if (fields[f]->size() != rows) { throw SizeMismatchException(); }
+
+        for (size_t i = 0; i < rows; ++i)
+        {
+            if ((*fields[f])[i].size() != cols) { throw SizeMismatchException(); }
+        }
+    }
+
+    BinaryGridHeader header = MakeHeader(GRID_MAGIC, GRID_COLUMNS, rows, cols, 0);
+    int fd = CreateColumnFile(path, header);
+
+    try
+    {
+        // rows are written straight from the matrices into their place in each column
+        for (size_t f = 0; f < GRID_COLUMNS; ++f)
+        {
+            for (size_t i = 0; i < rows && cols > 0; ++i)
+            {
+                off_t offset = static_cast<off_t>(HEADER_SIZE + f * header.columnStride + i * cols * sizeof(double));
+                WriteAll(fd, (*fields[f])[i].data(), cols * sizeof(double), offset, path);
+            }
+        }
+    }
+    catch (...)
+    {
+        ::close(fd);
+        throw;
+    }
+
+    if (::close(fd) != 0) { ThrowIOError("Failed to close", path); }
+}
+
+void WriteBinaryGrid(const std::string& path, const GridColumns& grid, const size_t rows, const size_t cols)
+{
+    if (grid.size != rows * cols)
+    {
+        throw SizeMismatchException();
+    }
+
+    const double* fields[GRID_COLUMNS] = { grid.strikes, grid.rates, grid.vols, grid.maturities, grid.carry, grid.spots };
+
+    BinaryGridHeader header = MakeHeader(GRID_MAGIC, GRID_COLUMNS, rows, cols, 0);
+    int fd = CreateColumnFile(path, header);
+
+    try
+    {
+        for (size_t f = 0; f < GRID_COLUMNS && grid.size > 0; ++f)
+        {
+            WriteAll(fd, fields[f], grid.size * sizeof(double), static_cast<off_t>(HEADER_SIZE + f * header.columnStride), path);
+        }
+    }
+    catch (...)
+    {
+        ::close(fd);
+        throw;
+    }
+
+    if (::close(fd) != 0) { ThrowIOError("Failed to close", path); }
+}
+
+MatrixParameters ReadBinaryGrid(const std::string& path)
+{
+    MappedGrid grid(path);
+
+    if (!grid.IsParameterGrid())
+    {
+        throw std::runtime_error("Not a parameter grid file '" + path + "'");
+    }
+
+    std::vector<std::vector<double>> fields[GRID_COLUMNS];
+
+    for (size_t f = 0; f < GRID_COLUMNS; ++f)
+    {
+        const double* column = grid.Column(f);
+        fields[f].resize(grid.Rows());
+
+        for (size_t i = 0; i < grid.Rows(); ++i)
+        {
+            fields[f][i].assign(column + i * grid.Cols(), column + (i + 1) * grid.Cols());
+        }
+    }
+
+    return MatrixParameters(fields[0], fields[1], fields[2], fields[3], fields[4], fields[5]);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// MappedGrid                                                                                                      //
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// parameter constructor
+MappedGrid::MappedGrid(const std::string& path) : m_fd(-1), m_map(MAP_FAILED), m_length(0), m_header(nullptr)
+{
+    m_fd = ::open(path.c_str(), O_RDONLY);
+    if (m_fd < 0) { ThrowIOError("Failed to open", path); }
+
+    struct stat info;
+    if (::fstat(m_fd, &info) != 0 || static_cast<size_t>(info.st_size) < HEADER_SIZE)
+    {
+        ::close(m_fd);
+        throw std::runtime_error("Truncated or unreadable grid file '" + path + "'");
+    }
+
+    m_length = static_cast<size_t>(info.st_size);
+    m_map = ::mmap(nullptr, m_length, PROT_READ, MAP_PRIVATE, m_fd, 0);
+    if (m_map == MAP_FAILED)
+    {
+        ::close(m_fd);
+        ThrowIOError("Failed to map", path);
+    }
+
+    ::madvise(m_map, m_length, MADV_SEQUENTIAL);       // kernels stream each column front to back
+    m_header = static_cast<const BinaryGridHeader*>(m_map);
+
+    // validate before any column pointer is handed out
+    // every product is checked by dividing the available bytes instead, so a crafted header cannot wrap around
+    const BinaryGridHeader& h = *m_header;
+    const uint64_t body = m_length - HEADER_SIZE;       // bytes after the header
+
+    bool grid = (std::memcmp(h.magic, GRID_MAGIC, sizeof(GRID_MAGIC)) == 0);
+    bool result = (std::memcmp(h.magic, RESULT_MAGIC, sizeof(RESULT_MAGIC)) == 0 && h.columns == ColumnCount(h.columnMask));
+    bool magic = grid || result;
+    bool shape = (h.cols == 0) ? (h.count == 0) : (h.rows <= UINT64_MAX / h.cols && h.count == h.rows * h.cols);
+    bool layout = (h.version == FORMAT_VERSION && h.byteOrder == BYTE_ORDER_MARK && shape
+                   && h.count <= body / sizeof(double) && h.columnStride >= h.count * sizeof(double));
+    bool length = layout && (h.columnStride == 0 || h.columns <= body / h.columnStride);
+
+    if (!magic || !layout || !length)
+    {
+        ::munmap(m_map, m_length);
+        ::close(m_fd);
+        throw std::runtime_error("Invalid grid file header '" + path + "'");
+    }
+}
+
+// destructor
+MappedGrid::~MappedGrid()
+{
+    ::munmap(m_map, m_length);
+    ::close(m_fd);
+}
+
+// getter functions
+const BinaryGridHeader& MappedGrid::Header() const
+{
+    return *m_header;
+}
+
+size_t MappedGrid::Rows() const
+{
+    return static_cast<size_t>(m_header->rows);
+}
+
+size_t MappedGrid::Cols() const
+{
+    return static_cast<size_t>(m_header->cols);
+}
+
+size_t MappedGrid::Size() const
+{
+    return static_cast<size_t>(m_header->count);
+}
+
+bool MappedGrid::IsParameterGrid() const
+{
+    return std::memcmp(m_header->magic, GRID_MAGIC, sizeof(GRID_MAGIC)) == 0 && m_header->columns == GRID_COLUMNS;
+}
+
+const double* MappedGrid::Column(const size_t index) const
+{
+    if (index >= m_header->columns)
+    {
+        throw OutOfBoundsException(static_cast<int>(index));
+    }
+
+    return reinterpret_cast<const double*>(static_cast<const char*>(m_map) + HEADER_SIZE + index * m_header->columnStride);
+}
+
+GridColumns MappedGrid::Columns() const
+{
+    return Columns(0, Size());
+}
+
+GridColumns MappedGrid::Columns(const size_t first, const size_t count) const
+{
+    if (!IsParameterGrid())
+    {
+        throw UnexpectedInputException();
+    }
+
+    if (first + count > Size())
+    {
+        throw OutOfBoundsException(static_cast<int>(first + count));
+    }
+
+    GridColumns grid = { Column(0) + first, Column(1) + first, Column(2) + first, Column(3) + first, Column(4) + first, Column(5) + first, count };
+    return grid;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// BinaryResultWriter                                                                                              //
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// parameter constructor
+BinaryResultWriter::BinaryResultWriter(const std::string& path, const size_t rows, const size_t cols, const uint64_t mask) : m_fd(-1), m_mask(mask), m_count(rows * cols), m_stride(0)
+{
+    if (ColumnCount(mask) == 0)
+    {
+        throw EmptyArrayException();
+    }
+
+    BinaryGridHeader header = MakeHeader(RESULT_MAGIC, ColumnCount(mask), rows, cols, mask);
+    m_stride = static_cast<size_t>(header.columnStride);
+    m_fd = CreateColumnFile(path, header);
+}
+
+// destructor
+BinaryResultWriter::~BinaryResultWriter()
+{
+    if (m_fd >= 0) { ::close(m_fd); }
+}
+
+void BinaryResultWriter::WriteColumn(const size_t column, const size_t first, const size_t count, const double* values)
+{
+    off_t offset = static_cast<off_t>(HEADER_SIZE + column * m_stride + first * sizeof(double));
+    WriteAll(m_fd, values, count * sizeof(double), offset, "result file");
+}
+
+void BinaryResultWriter::Write(const size_t first, const size_t count, const double* prices, const double* deltas, const double* gammas)
+{
+    if (m_fd < 0)
+    {
+        throw std::runtime_error("Result file already closed");
+    }
+
+    if (first + count > m_count)
+    {
+        throw OutOfBoundsException(static_cast<int>(first + count));
+    }
+
+    size_t column = 0;
+    if (m_mask & RESULT_PRICE) { if (prices) { WriteColumn(column, first, count, prices); } ++column; }
+    if (m_mask & RESULT_DELTA) { if (deltas) { WriteColumn(column, first, count, deltas); } ++column; }
+    if (m_mask & RESULT_GAMMA) { if (gammas) { WriteColumn(column, first, count, gammas); } ++column; }
+}
+
+void BinaryResultWriter::Close()
+{
+    if (m_fd < 0) { return; }
+
+    int fd = m_fd;
+    m_fd = -1;
+
+    if (::close(fd) != 0)
+    {
+        throw std::runtime_error(std::string("Failed to close result file: ") + std::strerror(errno));
+    }
+}
+
+} // namespace Engine
+} // namespace AidanRicher
@@ -0,0 +1,106 @@
+#ifndef BinaryGrid_HPP
+#define BinaryGrid_HPP
+
+#include "BatchPricer.hpp"
+#include "MatrixParameters.hpp"
+#include <cstdint>
+#include <string>
+
+namespace AidanRicher {
+namespace Engine {
+
+// columnar binary file layout (native byte order)
+//   [0, 64)      BinaryGridHeader
+//   [64, ...)    one contiguous column of doubles per field, each starting on a 64 byte boundary
+// parameter grids hold the columns K, r, sig, T, b, spot in that order
+// result files hold whichever of price, delta, gamma are flagged in columnMask, in that order
+struct BinaryGridHeader {
+    char magic[8];              // "OPFGRID" for parameter grids, "OPFRSLT" for results
+    uint32_t version;           // file format version
+    uint32_t byteOrder;         // 0x01020304 as written by the producer, detects foreign byte order
+    uint64_t columns;           // number of columns that follow the header
+    uint64_t rows;              // matrix rows, for reshaping back to MatrixParameters
+    uint64_t cols;              // matrix columns
+    uint64_t count;             // elements per column, rows * cols
+    uint64_t columnStride;      // bytes between the start of consecutive columns
+    uint64_t columnMask;        // which result columns are present (RESULT_PRICE | RESULT_DELTA | RESULT_GAMMA)
+};
+
+// result column flags
+const uint64_t RESULT_PRICE = 1;
+const uint64_t RESULT_DELTA = 2;
+const uint64_t RESULT_GAMMA = 4;
+
+// write a rectangular MatrixParameters grid, throws SizeMismatchException for ragged or inconsistent matrices
+void WriteBinaryGrid(const std::string& path, const MatrixParameters& params);
+
+// write raw columns as a rows x cols grid, grid.size must equal rows * cols
+void WriteBinaryGrid(const std::string& path, const GridColumns& grid, const size_t rows, const size_t cols);
+
+// read a parameter grid back into a MatrixParameters (copies, use MappedGrid to avoid it)
+MatrixParameters ReadBinaryGrid(const std::string& path);
+
+// read-only memory mapping of a parameter grid or result file
+// the columns point straight into the mapping and can be fed to the batch kernels without parsing or copying
+class MappedGrid {
+    private:
+        int m_fd;                           // file descriptor
+        void* m_map;                        // start of the mapping
+        size_t m_length;                    // bytes mapped
+        const BinaryGridHeader* m_header;   // header at the start of the mapping
+
+    public:
+        // parameter constructor, maps the whole file and validates the header
+        explicit MappedGrid(const std::string& path);
+
+        // non-copyable, owns the mapping
+        MappedGrid(const MappedGrid& other) = delete;
+        MappedGrid& operator = (const MappedGrid& other) = delete;
+
+        // destructor, unmaps the file
+        ~MappedGrid();
+
+        // getter functions
+        const BinaryGridHeader& Header() const;
+        size_t Rows() const;
+        size_t Cols() const;
+        size_t Size() const;
+        bool IsParameterGrid() const;
+        const double* Column(const size_t index) const;     // index-th stored column
+        GridColumns Columns() const;                        // parameter columns, parameter grids only
+        GridColumns Columns(const size_t first, const size_t count) const;     // sub-range of the parameter columns
+};
+
+// streams price/delta/gamma columns into a pre-sized result file
+// chunks can be written in any order, so a grid can be priced and written block by block
+class BinaryResultWriter {
+    private:
+        int m_fd;                   // file descriptor
+        uint64_t m_mask;            // columns present in the file
+        size_t m_count;             // elements per column
+        size_t m_stride;            // bytes between column starts
+
+        void WriteColumn(const size_t column, const size_t first, const size_t count, const double* values);
+
+    public:
+        // parameter constructor, creates (or truncates) path for a rows x cols result grid
+        BinaryResultWriter(const std::string& path, const size_t rows, const size_t cols, const uint64_t mask = RESULT_PRICE | RESULT_DELTA | RESULT_GAMMA);
+
+        // non-copyable, owns the file
+        BinaryResultWriter(const BinaryResultWriter& other) = delete;
+        BinaryResultWriter& operator = (const BinaryResultWriter& other) = delete;
+
+        // destructor, closes the file
+        ~BinaryResultWriter();
+
+        // write elements [first, first + count) of each present column, pointers for absent columns are ignored
+        void Write(const size_t first, const size_t count, const double* prices, const double* deltas, const double* gammas);
+
+        // flush and close, the destructor does this as well but cannot report errors
+        void Close();
+};
+
+} // namespace Engine
+} // namespace AidanRicher
+
+#endif // BinaryGrid_HPP
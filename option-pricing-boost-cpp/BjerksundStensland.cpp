@@ -0,0 +1,333 @@
+#include "BjerksundStensland.hpp"
+#include <boost/math/distributions/normal.hpp>
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+
+using namespace boost::math;
+
+namespace AidanRicher {
+namespace Engine {
+
+namespace {
+
+const double PI = 3.14159265358979323846;
+const double BUMP = 1e-4;       // relative spot bump for the finite difference greeks
+
+double NormalCdf(const double x)
+{
+    normal_distribution<> myNormal;
+    return cdf(myNormal, x);
+}
+
+double BivariateNormalCdf(const double a, const double b, const double rho)
+{ // P(X < a, Y < b) for standard normals with correlation rho, Genz (2004) Gauss-Legendre scheme
+    static const double w[3][10] = {
+        { 0.1713244923791705, 0.3607615730481384, 0.4679139345726904 },
+        { 0.04717533638651177, 0.1069393259953183, 0.1600783285433464, 0.2031674267230659, 0.2334925365383547, 0.2491470458134029 },
+        { 0.01761400713915212, 0.04060142980038694, 0.06267204833410906, 0.08327674157670475, 0.1019301198172404,
+          0.1181945319615184, 0.1316886384491766, 0.1420961093183821, 0.1491729864726037, 0.1527533871307259 } };
+    static const double x[3][10] = {
+        { -0.9324695142031522, -0.6612093864662647, -0.2386191860831970 },
+        { -0.9815606342467191, -0.9041172563704750, -0.7699026741943050, -0.5873179542866171, -0.3678314989981802, -0.1252334085114692 },
+        { -0.9931285991850949, -0.9639719272779138, -0.9122344282513259, -0.8391169718222188, -0.7463319064601508,
+          -0.6360536807265150, -0.5108670019508271, -0.3737060887154196, -0.2277858511416451, -0.07652652113349733 } };
+
+    const int set = (std::abs(rho) < 0.3) ? 0 : (std::abs(rho) < 0.75) ? 1 : 2;
+    const int points = (set == 0) ? 3 : (set == 1) ? 6 : 10;
+
+    // upper orthant P(X > h, Y > k) with h = -a, k = -b
+    double h = -a;
+    double k = -b;
+    double hk = h * k;
+    double bvn = 0.0;
+
+    if (std::abs(rho) < 0.925)
+    {
+        double hs = 0.5 * (h * h + k * k);
+        double asr = std::asin(rho);
+        for (int i = 0; i < points; ++i)
+        {
+            for (int is = -1; is <= 1; is += 2)
+            {
+                double sn = std::sin(0.5 * asr * (is * x[set][i] + 1.0));
+                bvn += w[set][i] * std::exp((sn * hk - hs) / (1.0 - sn * sn));
+            }
+        }
+        return bvn * asr / (4.0 * PI) + NormalCdf(-h) * NormalCdf(-k);
+    }
+
+    if (rho < 0.0)
+    {
+        k = -k;
+        hk = -hk;
+    }
+
+    if (std::abs(rho) < 1.0)
+    {
+        double as = (1.0 - rho) * (1.0 + rho);
+        double A = std::sqrt(as);
+        double bs = (h - k) * (h - k);
+        double c = (4.0 - hk) / 8.0;
+        double d = (12.0 - hk) / 16.0;
+        double asr = -0.5 * (bs / as + hk);
+
+        if (asr > -100.0)
+        {
+            bvn = A * std::exp(asr) * (1.0 - c * (bs - as) * (1.0 - d * bs / 5.0) / 3.0 + c * d * as * as / 5.0);
+        }
+        if (-hk < 100.0)
+        {
+            double B = std::sqrt(bs);
+            bvn -= std::exp(-0.5 * hk) * std::sqrt(2.0 * PI) * NormalCdf(-B / A) * B * (1.0 - c * bs * (1.0 - d * bs / 5.0) / 3.0);
+        }
+
+        A *= 0.5;
+        for (int i = 0; i < points; ++i)
+        {
+            for (int is = -1; is <= 1; is += 2)
+            {
+                double xs = A * (is * x[set][i] + 1.0);
+                xs *= xs;
+                double rs = std::sqrt(1.0 - xs);
+                asr = -0.5 * (bs / xs + hk);
+                if (asr > -100.0)
+                {
+                    bvn += A * w[set][i] * std::exp(asr) * (std::exp(-hk * (1.0 - rs) / (2.0 * (1.0 + rs))) / rs - (1.0 + c * xs * (1.0 + d * xs)));
+                }
+            }
+        }
+        bvn = -bvn / (2.0 * PI);
+    }
+
+    if (rho > 0.0)
+    {
+        return bvn + NormalCdf(-std::max(h, k));
+    }
+
+    bvn = -bvn;
+    if (k > h)
+    {
+        bvn += (h < 0.0) ? NormalCdf(k) - NormalCdf(h) : NormalCdf(-h) - NormalCdf(-k);
+    }
+    return bvn;
+}
+
+// phi(U, T, gamma, H, I) of the flat boundary formula
+double Phi(const double U, const double T, const double gamma, const double H, const double I, const double r, const double b, const double sig)
+{
+    double sigRootT = sig * std::sqrt(T);
+    double lambda = (-r + gamma * b + 0.5 * gamma * (gamma - 1.0) * sig * sig) * T;
+    double d = -(std::log(U / H) + (b + (gamma - 0.5) * sig * sig) * T) / sigRootT;
+    double kappa = 2.0 * b / (sig * sig) + 2.0 * gamma - 1.0;
+
+    return std::exp(lambda) * std::pow(U, gamma) * (NormalCdf(d) - std::pow(I / U, kappa) * NormalCdf(d - 2.0 * std::log(I / U) / sigRootT));
+}
+
+// psi(U, T, gamma, H, I2, I1, t1) of the two step boundary formula
+double Psi(const double U, const double T, const double gamma, const double H, const double I2, const double I1, const double t1,
+           const double r, const double b, const double sig)
+{
+    double drift = b + (gamma - 0.5) * sig * sig;
+    double sigRoott1 = sig * std::sqrt(t1);
+    double sigRootT = sig * std::sqrt(T);
+
+    double e1 = (std::log(U / I1) + drift * t1) / sigRoott1;
+    double e2 = (std::log(I2 * I2 / (U * I1)) + drift * t1) / sigRoott1;
+    double e3 = (std::log(U / I1) - drift * t1) / sigRoott1;
+    double e4 = (std::log(I2 * I2 / (U * I1)) - drift * t1) / sigRoott1;
+
+    double f1 = (std::log(U / H) + drift * T) / sigRootT;
+    double f2 = (std::log(I2 * I2 / (U * H)) + drift * T) / sigRootT;
+    double f3 = (std::log(I1 * I1 / (U * H)) + drift * T) / sigRootT;
+    double f4 = (std::log(U * I1 * I1 / (H * I2 * I2)) + drift * T) / sigRootT;
+
+    double rho = std::sqrt(t1 / T);
+    double lambda = -r + gamma * b + 0.5 * gamma * (gamma - 1.0) * sig * sig;
+    double kappa = 2.0 * b / (sig * sig) + 2.0 * gamma - 1.0;
+
+    return std::exp(lambda * T) * std::pow(U, gamma) * (BivariateNormalCdf(-e1, -f1, rho)
+        - std::pow(I2 / U, kappa) * BivariateNormalCdf(-e2, -f2, rho)
+        - std::pow(I1 / U, kappa) * BivariateNormalCdf(-e3, -f3, -rho)
+        + std::pow(I1 / I2, kappa) * BivariateNormalCdf(-e4, -f4, -rho));
+}
+
+// trigger prices I1 (first step, up to t1) and I2 (second step) and the exponent beta
+void Boundary(const double K, const double T, const double r, const double b, const double sig, double& I1, double& I2, double& beta)
+{
+    double sigma_squared = sig * sig;
+    beta = (0.5 - b / sigma_squared) + std::sqrt(std::pow(b / sigma_squared - 0.5, 2.0) + 2.0 * r / sigma_squared);
+
+    double BInf = beta / (beta - 1.0) * K;
+    double B0 = std::max(K, r / (r - b) * K);
+    double t1 = 0.5 * (std::sqrt(5.0) - 1.0) * T;
+    double h1 = -(b * t1 + 2.0 * sig * std::sqrt(t1)) * K * K / ((BInf - B0) * B0);
+    double h2 = -(b * T + 2.0 * sig * std::sqrt(T)) * K * K / ((BInf - B0) * B0);
+
+    I1 = B0 + (BInf - B0) * (1.0 - std::exp(h1));
+    I2 = B0 + (BInf - B0) * (1.0 - std::exp(h2));
+}
+
+} // namespace
+
+// default constructor
+BjerksundStensland::BjerksundStensland() : m_data(), m_call(true) { }
+
+// parameter constructor
+BjerksundStensland::BjerksundStensland(const OptionData& data, const bool call) : m_data(data), m_call(call) { }
+
+// copy constructor
+BjerksundStensland::BjerksundStensland(const BjerksundStensland& other) : m_data(other.m_data), m_call(other.m_call) { }
+
+// virtual destructor
+BjerksundStensland::~BjerksundStensland() { }
+
+// assignment operator
+BjerksundStensland& BjerksundStensland::operator = (const BjerksundStensland& other)
+{
+    if (this == &other) { return *this; }   // self-assignment
+
+    m_data = other.m_data;
+    m_call = other.m_call;
+
+    return *this;
+}
+
+// getter functions
+const OptionData& BjerksundStensland::GetData() const
+{
+    return m_data;
+}
+
+bool BjerksundStensland::IsCall() const
+{
+    return m_call;
+}
+
+double BjerksundStensland::Call(const double U, const double K, const double T, const double r, const double b, const double sig)
+{ // american call, european when early exercise is never optimal (b >= r)
+    if (b >= r)
+    {
+        double d1 = (std::log(U / K) + (b + 0.5 * sig * sig) * T) / (sig * std::sqrt(T));
+        double d2 = d1 - sig * std::sqrt(T);
+        return U * std::exp((b - r) * T) * NormalCdf(d1) - K * std::exp(-r * T) * NormalCdf(d2);
+    }
+
+    double I1, I2, beta;
+    Boundary(K, T, r, b, sig, I1, I2, beta);
+
+    if (U >= I2) { return U - K; }
+
+    double t1 = 0.5 * (std::sqrt(5.0) - 1.0) * T;
+    double alpha1 = (I1 - K) * std::pow(I1, -beta);
+    double alpha2 = (I2 - K) * std::pow(I2, -beta);
+
+    return alpha2 * std::pow(U, beta) - alpha2 * Phi(U, t1, beta, I2, I2, r, b, sig)
+        + Phi(U, t1, 1.0, I2, I2, r, b, sig) - Phi(U, t1, 1.0, I1, I2, r, b, sig)
+        - K * Phi(U, t1, 0.0, I2, I2, r, b, sig) + K * Phi(U, t1, 0.0, I1, I2, r, b, sig)
+        + alpha1 * Phi(U, t1, beta, I1, I2, r, b, sig) - alpha1 * Psi(U, T, beta, I1, I2, I1, t1, r, b, sig)
+        + Psi(U, T, 1.0, I1, I2, I1, t1, r, b, sig) - Psi(U, T, 1.0, K, I2, I1, t1, r, b, sig)
+        - K * Psi(U, T, 0.0, I1, I2, I1, t1, r, b, sig) + K * Psi(U, T, 0.0, K, I2, I1, t1, r, b, sig);
+}
+
+double BjerksundStensland::ExercisePrice() const
+{ // I2, for puts the call trigger of the transformed problem mapped back, I2 is linear in the strike
+    double I1, I2, beta;
+
+    if (m_call)
+    {
+        if (m_data.B() >= m_data.R()) { return std::numeric_limits<double>::infinity(); }
+        Boundary(m_data.K(), m_data.T(), m_data.R(), m_data.B(), m_data.Sig(), I1, I2, beta);
+        return I2;
+    }
+
+    if (-m_data.B() >= m_data.R() - m_data.B()) { return 0.0; }
+    Boundary(1.0, m_data.T(), m_data.R() - m_data.B(), -m_data.B(), m_data.Sig(), I1, I2, beta);
+    return m_data.K() / I2;
+}
+
+double BjerksundStensland::Price(const double U) const
+{ // return the price of the american option
+    if (U <= 0.0)
+    {
+        throw std::invalid_argument("Underlying spot price U must be positive.");
+    }
+
+    return m_call ? Call(U, m_data.K(), m_data.T(), m_data.R(), m_data.B(), m_data.Sig())
+                  : Call(m_data.K(), U, m_data.T(), m_data.R() - m_data.B(), -m_data.B(), m_data.Sig());
+}
+
+double BjerksundStensland::Delta(const double U) const
+{ // return the delta of the american option, central difference with a relative bump
+    double h = BUMP * U;
+    return (Price(U + h) - Price(U - h)) / (2.0 * h);
+}
+
+double BjerksundStensland::Gamma(const double U) const
+{ // return the gamma of the american option
+    double h = BUMP * U;
+    return (Price(U + h) - 2.0 * Price(U) + Price(U - h)) / (h * h);
+}
+
+void BjerksundStensland::PriceBatch(const double* U, const size_t n, double* prices, double* deltas, double* gammas) const
+{ // three prices per spot cover price, delta and gamma
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        double price = nan, delta = nan, gamma = nan;
+
+        if (U[i] > 0.0)
+        {
+            double h = BUMP * U[i];
+            price = Price(U[i]);
+
+            if (deltas || gammas)
+            {
+                double up = Price(U[i] + h);
+                double down = Price(U[i] - h);
+                delta = (up - down) / (2.0 * h);
+                gamma = (up - 2.0 * price + down) / (h * h);
+            }
+        }
+
+        if (prices) { prices[i] = price; }
+        if (deltas) { deltas[i] = delta; }
+        if (gammas) { gammas[i] = gamma; }
+    }
+}
+
+std::ostream& operator << (std::ostream& os, const BjerksundStensland& source)
+{ // ostream << operator for option properties
+    os << std::endl;
+    os << "Bjerksund-Stensland American " << (source.m_call ? "Call" : "Put") << " Option:\n" <<
+        "K: " << source.m_data.K() << "\n" <<
+        "R: " << source.m_data.R() << "\n" <<
+        "Sig: " << source.m_data.Sig() << "\n" <<
+        "T: " << source.m_data.T() << "\n" <<
+        "B: " << source.m_data.B() << std::endl;
+
+    // return description
+    return os;
+}
+
+// overrides
+std::string BjerksundStensland::Type() const
+{
+    return m_call ? "Bjerksund-Stensland American Call Option" : "Bjerksund-Stensland American Put Option";
+}
+
+Option* BjerksundStensland::Clone() const
+{
+    return new BjerksundStensland(*this);
+}
+
+Option* BjerksundStensland::Clone(const OptionData& data) const
+{
+    return new BjerksundStensland(data, m_call);
+}
+
+} // namespace Engine
+} // namespace AidanRicher
@@ -0,0 +1,67 @@
+#ifndef BjerksundStensland_HPP
+#define BjerksundStensland_HPP
+
+#include "Option.hpp"
+#include "OptionData.hpp"
+#include <cstddef>
+#include <string>
+#include <iostream>
+
+namespace AidanRicher {
+namespace Engine {
+
+// finite maturity american option, Bjerksund and Stensland (2002) two step flat exercise boundary
+// closed form, no iteration, puts use the put-call transformation P(U, K, r, b) = C(K, U, r - b, -b)
+class BjerksundStensland : public Option {
+    private:
+        OptionData m_data;          // holds fixed contract params (k, r, sig, t, b)
+        bool m_call;                // call (true) or put (false)
+
+        // american call C(U, K, T, r, b, sig), the put is evaluated through it
+        static double Call(const double U, const double K, const double T, const double r, const double b, const double sig);
+
+    public:
+        // default constructor, american call
+        BjerksundStensland();
+
+        // parameter constructor
+        BjerksundStensland(const OptionData& data, const bool call);
+
+        // copy constructor
+        BjerksundStensland(const BjerksundStensland& other);
+
+        // destructor
+        virtual ~BjerksundStensland();
+
+        // assignment operator
+        BjerksundStensland& operator = (const BjerksundStensland& other);
+
+        // getter for const reference to option data
+        const OptionData& GetData() const;
+        bool IsCall() const;
+
+        // flat exercise boundary over the second half of the life of the option (I2), exercise at or above it for calls, at or below for puts
+        double ExercisePrice() const;
+
+        // core methods
+        double Price(const double U) const override;                            // return the price of the option
+        double Delta(const double U) const override;                            // return the delta of the option (central difference)
+        double Gamma(const double U) const override;                            // return the gamma of the option (central difference)
+
+        // price, delta and gamma over an array of spots, any output pointer may be nullptr
+        // spots that are not positive give NaN instead of throwing
+        void PriceBatch(const double* U, const size_t n, double* prices, double* deltas, double* gammas) const;
+
+        // ostream << operator
+        friend std::ostream& operator << (std::ostream& os, const BjerksundStensland& source);
+
+        // overrides of pure virtual methods from Option base class
+        virtual std::string Type() const override;
+        virtual Option* Clone() const override;
+        virtual Option* Clone(const OptionData& data) const override;
+};
+
+} // namespace Engine
+} // namespace AidanRicher
+
+#endif // BjerksundStensland_HPP
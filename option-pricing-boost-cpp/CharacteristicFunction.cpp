@@ -0,0 +1,192 @@
+#include "CharacteristicFunction.hpp"
+#include <cmath>
+
+namespace AidanRicher {
+namespace Engine {
+
+namespace {
+
+const std::complex<double> I(0.0, 1.0);
+
+} // namespace
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// BlackScholesCF                                                                                                  //
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// default constructor
+BlackScholesCF::BlackScholesCF() : m_sig(0.2), m_b(0.0) { }
+
+// parameter constructor
+BlackScholesCF::BlackScholesCF(const double sig, const double b) : m_sig(sig), m_b(b) { }
+
+// copy constructor
+BlackScholesCF::BlackScholesCF(const BlackScholesCF& other) : m_sig(other.m_sig), m_b(other.m_b) { }
+
+// destructor
+BlackScholesCF::~BlackScholesCF() { }
+
+// assignment operator
+BlackScholesCF& BlackScholesCF::operator = (const BlackScholesCF& other)
+{
+    if (this == &other) { return *this; }
+
+    m_sig = other.m_sig;
+    m_b = other.m_b;
+
+    return *this;
+}
+
+std::complex<double> BlackScholesCF::operator () (const std::complex<double>& u, const double T) const
+{ // exp(iu (b - sig^2 / 2) T - sig^2 u^2 T / 2)
+    return std::exp(I * u * (m_b - 0.5 * m_sig * m_sig) * T - 0.5 * m_sig * m_sig * u * u * T);
+}
+
+void BlackScholesCF::Cumulants(const double T, double& c1, double& c2, double& c4) const
+{
+    c1 = (m_b - 0.5 * m_sig * m_sig) * T;
+    c2 = m_sig * m_sig * T;
+    c4 = 0.0;
+}
+
+std::string BlackScholesCF::Type() const
+{
+    return "Black-Scholes";
+}
+
+CharacteristicFunction* BlackScholesCF::Clone() const
+{
+    return new BlackScholesCF(*this);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// HestonCF                                                                                                        //
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// default constructor
+HestonCF::HestonCF() : m_b(0.0), m_kappa(1.5), m_theta(0.04), m_xi(0.3), m_rho(-0.7), m_v0(0.04) { }
+
+// parameter constructor
+HestonCF::HestonCF(const double b, const double kappa, const double theta, const double xi, const double rho, const double v0) : m_b(b), m_kappa(kappa), m_theta(theta), m_xi(xi), m_rho(rho), m_v0(v0) { }
+
+// copy constructor
+HestonCF::HestonCF(const HestonCF& other) : m_b(other.m_b), m_kappa(other.m_kappa), m_theta(other.m_theta), m_xi(other.m_xi), m_rho(other.m_rho), m_v0(other.m_v0) { }
+
+// destructor
+HestonCF::~HestonCF() { }
+
+// assignment operator
+HestonCF& HestonCF::operator = (const HestonCF& other)
+{
+    if (this == &other) { return *this; }
+
+    m_b = other.m_b;
+    m_kappa = other.m_kappa;
+    m_theta = other.m_theta;
+    m_xi = other.m_xi;
+    m_rho = other.m_rho;
+    m_v0 = other.m_v0;
+
+    return *this;
+}
+
+std::complex<double> HestonCF::operator () (const std::complex<double>& u, const double T) const
+{ // Albrecher et al. (2007) form, g uses the minus root so exp(-dT) never wraps around the branch cut
+    const double xi2 = m_xi * m_xi;
+    std::complex<double> beta = m_kappa - m_rho * m_xi * I * u;
+    std::complex<double> d = std::sqrt(beta * beta + xi2 * (I * u + u * u));
+    std::complex<double> g = (beta - d) / (beta + d);
+    std::complex<double> edt = std::exp(-d * T);
+
+    std::complex<double> C = I * u * m_b * T + (m_kappa * m_theta / xi2) * ((beta - d) * T - 2.0 * std::log((1.0 - g * edt) / (1.0 - g)));
+    std::complex<double> D = ((beta - d) / xi2) * ((1.0 - edt) / (1.0 - g * edt));
+
+    return std::exp(C + D * m_v0);
+}
+
+void HestonCF::Cumulants(const double T, double& c1, double& c2, double& c4) const
+{ // Fang and Oosterlee (2008), the fourth cumulant is dropped and covered by the width L
+    const double k = m_kappa;
+    const double e1 = std::exp(-k * T);
+    const double e2 = std::exp(-2.0 * k * T);
+
+    c1 = m_b * T + (1.0 - e1) * (m_theta - m_v0) / (2.0 * k) - 0.5 * m_theta * T;
+    c2 = (1.0 / (8.0 * k * k * k)) * (m_xi * T * k * e1 * (m_v0 - m_theta) * (8.0 * k * m_rho - 4.0 * m_xi)
+        + k * m_rho * m_xi * (1.0 - e1) * (16.0 * m_theta - 8.0 * m_v0)
+        + 2.0 * m_theta * k * T * (-4.0 * k * m_rho * m_xi + m_xi * m_xi + 4.0 * k * k)
+        + m_xi * m_xi * ((m_theta - 2.0 * m_v0) * e2 + m_theta * (6.0 * e1 - 7.0) + 2.0 * m_v0)
+        + 8.0 * k * k * (m_v0 - m_theta) * (1.0 - e1));
+    c4 = 0.0;
+}
+
+std::string HestonCF::Type() const
+{
+    return "Heston";
+}
+
+CharacteristicFunction* HestonCF::Clone() const
+{
+    return new HestonCF(*this);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// MertonCF                                                                                                        //
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// default constructor
+MertonCF::MertonCF() : m_sig(0.2), m_b(0.0), m_lambda(0.5), m_muJ(-0.1), m_sigJ(0.15) { }
+
+// parameter constructor
+MertonCF::MertonCF(const double sig, const double b, const double lambda, const double muJ, const double sigJ) : m_sig(sig), m_b(b), m_lambda(lambda), m_muJ(muJ), m_sigJ(sigJ) { }
+
+// copy constructor
+MertonCF::MertonCF(const MertonCF& other) : m_sig(other.m_sig), m_b(other.m_b), m_lambda(other.m_lambda), m_muJ(other.m_muJ), m_sigJ(other.m_sigJ) { }
+
+// destructor
+MertonCF::~MertonCF() { }
+
+// assignment operator
+MertonCF& MertonCF::operator = (const MertonCF& other)
+{
+    if (this == &other) { return *this; }
+
+    m_sig = other.m_sig;
+    m_b = other.m_b;
+    m_lambda = other.m_lambda;
+    m_muJ = other.m_muJ;
+    m_sigJ = other.m_sigJ;
+
+    return *this;
+}
+
+std::complex<double> MertonCF::operator () (const std::complex<double>& u, const double T) const
+{ // diffusion part compensated for the mean jump so that phi(-i) = exp(b * T)
+    const double kbar = std::exp(m_muJ + 0.5 * m_sigJ * m_sigJ) - 1.0;
+    std::complex<double> jump = std::exp(I * u * m_muJ - 0.5 * m_sigJ * m_sigJ * u * u) - 1.0;
+
+    return std::exp(I * u * (m_b - 0.5 * m_sig * m_sig - m_lambda * kbar) * T - 0.5 * m_sig * m_sig * u * u * T + m_lambda * T * jump);
+}
+
+void MertonCF::Cumulants(const double T, double& c1, double& c2, double& c4) const
+{
+    const double kbar = std::exp(m_muJ + 0.5 * m_sigJ * m_sigJ) - 1.0;
+    const double mu2 = m_muJ * m_muJ;
+    const double s2 = m_sigJ * m_sigJ;
+
+    c1 = (m_b - 0.5 * m_sig * m_sig - m_lambda * kbar + m_lambda * m_muJ) * T;
+    c2 = (m_sig * m_sig + m_lambda * (mu2 + s2)) * T;
+    c4 = m_lambda * T * (mu2 * mu2 + 6.0 * s2 * mu2 + 3.0 * s2 * s2);
+}
+
+std::string MertonCF::Type() const
+{
+    return "Merton Jump Diffusion";
+}
+
+CharacteristicFunction* MertonCF::Clone() const
+{
+    return new MertonCF(*this);
+}
+
+} // namespace Engine
+} // namespace AidanRicher
@@ -0,0 +1,99 @@
+#ifndef CharacteristicFunction_HPP
+#define CharacteristicFunction_HPP
+
+#include <complex>
+#include <string>
+
+namespace AidanRicher {
+namespace Engine {
+
+// characteristic function of the log return X = ln(S(T) / U) under the pricing measure,
+// phi(u) = E[exp(iuX)], with the carry b in the drift so phi(-i) = exp(b * T)
+class CharacteristicFunction {
+    public:
+        virtual ~CharacteristicFunction() = default;
+
+        virtual std::complex<double> operator () (const std::complex<double>& u, const double T) const = 0;
+
+        // first, second and fourth cumulants of X, used for the COS truncation range
+        virtual void Cumulants(const double T, double& c1, double& c2, double& c4) const = 0;
+
+        virtual std::string Type() const = 0;
+        virtual CharacteristicFunction* Clone() const = 0;
+};
+
+// geometric brownian motion, validates against EuropeanCall / EuropeanPut
+class BlackScholesCF : public CharacteristicFunction {
+    private:
+        double m_sig;       // volatility
+        double m_b;         // cost of carry
+
+    public:
+        BlackScholesCF();                                       // default constructor
+        BlackScholesCF(const double sig, const double b);       // parameter constructor
+        BlackScholesCF(const BlackScholesCF& other);            // copy constructor
+        virtual ~BlackScholesCF();                              // destructor
+
+        // assignment operator
+        BlackScholesCF& operator = (const BlackScholesCF& other);
+
+        std::complex<double> operator () (const std::complex<double>& u, const double T) const override;
+        void Cumulants(const double T, double& c1, double& c2, double& c4) const override;
+        std::string Type() const override;
+        CharacteristicFunction* Clone() const override;
+};
+
+// Heston stochastic volatility, dv = kappa (theta - v) dt + xi sqrt(v) dW2, corr(dW1, dW2) = rho
+// uses the rotation-free ("little trap") form, continuous in u for long maturities
+class HestonCF : public CharacteristicFunction {
+    private:
+        double m_b;         // cost of carry
+        double m_kappa;     // mean reversion speed
+        double m_theta;     // long run variance
+        double m_xi;        // volatility of variance
+        double m_rho;       // spot / variance correlation
+        double m_v0;        // initial variance
+
+    public:
+        HestonCF();                                             // default constructor
+        HestonCF(const double b, const double kappa, const double theta, const double xi, const double rho, const double v0);   // parameter constructor
+        HestonCF(const HestonCF& other);                        // copy constructor
+        virtual ~HestonCF();                                    // destructor
+
+        // assignment operator
+        HestonCF& operator = (const HestonCF& other);
+
+        std::complex<double> operator () (const std::complex<double>& u, const double T) const override;
+        void Cumulants(const double T, double& c1, double& c2, double& c4) const override;
+        std::string Type() const override;
+        CharacteristicFunction* Clone() const override;
+};
+
+// Merton jump diffusion, lognormal jumps ln(1 + J) ~ N(muJ, sigJ^2) arriving at rate lambda
+class MertonCF : public CharacteristicFunction {
+    private:
+        double m_sig;       // diffusion volatility
+        double m_b;         // cost of carry
+        double m_lambda;    // jump intensity
+        double m_muJ;       // mean log jump
+        double m_sigJ;      // log jump volatility
+
+    public:
+        MertonCF();                                             // default constructor
+        MertonCF(const double sig, const double b, const double lambda, const double muJ, const double sigJ);   // parameter constructor
+        MertonCF(const MertonCF& other);                        // copy constructor
+        virtual ~MertonCF();                                    // destructor
+
+        // assignment operator
+        MertonCF& operator = (const MertonCF& other);
+
+        std::complex<double> operator () (const std::complex<double>& u, const double T) const override;
+        void Cumulants(const double T, double& c1, double& c2, double& c4) const override;
+        std::string Type() const override;
+        CharacteristicFunction* Clone() const override;
+};
+
+} // namespace Engine
+} // namespace AidanRicher
+
+#endif // CharacteristicFunction_HPP
@@ -0,0 +1,480 @@
+#include "ChebyshevProxy.hpp"
+#include "ArrayException.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+
+using namespace AidanRicher::Containers;
+
+namespace AidanRicher {
+namespace Engine {
+
+namespace {
+
+const double PI = 3.14159265358979323846;
+const size_t MAX_AXES = 5;                  // one per SensitivityParameter
+const char PROXY_MAGIC[8] = "OPFCHEB";
+const uint32_t FORMAT_VERSION = 1;
+const uint32_t BYTE_ORDER_MARK = 0x01020304;
+const uint64_t TEST_SEED = 20250101;        // fixed so the reported error is reproducible
+
+// file layout: ProxyFileHeader, then one ProxyFileAxis per axis, then the coefficients
+struct ProxyFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrder;
+    uint64_t dimension;
+    uint64_t size;
+    uint64_t evaluations;
+    double spot;
+    double k, r, sig, t, b;
+    double tailEstimate;
+    double testError;
+};
+
+struct ProxyFileAxis {
+    uint64_t parameter;
+    uint64_t nodes;
+    double lower;
+    double upper;
+};
+
+// node j of n on [lower, upper], j = 0 is the upper end
+double Node(const ProxyAxis& axis, const size_t j)
+{
+    double x = std::cos(PI * static_cast<double>(j) / static_cast<double>(axis.nodes - 1));
+    return axis.lower + 0.5 * (axis.upper - axis.lower) * (x + 1.0);
+}
+
+// model price with the axis parameters set from point
+double ModelPrice(const Option& option, const OptionData& base, const double spot, const std::vector<ProxyAxis>& axes, const double* point)
+{
+    OptionData data(base);
+    double U = spot;
+
+    for (size_t d = 0; d < axes.size(); ++d)
+    {
+        switch (axes[d].parameter)
+        {
+            case SENS_SPOT: U = point[d]; break;
+            case SENS_VOL: data.Sig(point[d]); break;
+            case SENS_RATE: data.R(point[d]); break;
+            case SENS_MATURITY: data.T(point[d]); break;
+            case SENS_CARRY: data.B(point[d]); break;
+        }
+    }
+
+    std::unique_ptr<Option> priced(option.Clone(data));
+    return priced->Price(U);
+}
+
+// an off-axis parameter of a Price() request must be the one the proxy was built with
+void CheckFixed(const char* name, const double value, const double fixed)
+{
+    if (!(std::abs(value - fixed) <= 1e-12 * std::max(1.0, std::abs(fixed))))
+    {
+        std::ostringstream s;
+        s << name << " " << value << " is not a proxy axis and differs from the build value " << fixed << ".";
+        throw std::invalid_argument(s.str());
+    }
+}
+
+} // namespace
+
+std::string ProxyDomainException::Message(const SensitivityParameter parameter, const double value, const double lower, const double upper)
+{
+    static const char* names[] = { "Spot", "Vol", "Rate", "Maturity", "Carry" };
+
+    std::ostringstream s;
+    s << names[parameter] << " " << value << " outside the proxy range [" << lower << ", " << upper << "].";
+    return s.str();
+}
+
+// parameter constructor
+ProxyDomainException::ProxyDomainException(const SensitivityParameter parameter, const double value, const double lower, const double upper)
+    : std::out_of_range(Message(parameter, value, lower, upper)), m_parameter(parameter), m_value(value), m_lower(lower), m_upper(upper) { }
+
+// getter functions
+SensitivityParameter ProxyDomainException::Parameter() const
+{
+    return m_parameter;
+}
+
+double ProxyDomainException::Value() const
+{
+    return m_value;
+}
+
+double ProxyDomainException::Lower() const
+{
+    return m_lower;
+}
+
+double ProxyDomainException::Upper() const
+{
+    return m_upper;
+}
+
+// default constructor
+ChebyshevProxy::ChebyshevProxy() : m_axes(), m_strides(), m_coefficients(), m_data(), m_spot(0.0), m_tailEstimate(0.0), m_testError(0.0), m_evaluations(0) { }
+
+// parameter constructor
+ChebyshevProxy::ChebyshevProxy(const Option& option, const double U, const std::vector<ProxyAxis>& axes, const size_t testPoints)
+    : m_axes(axes), m_strides(), m_coefficients(), m_data(option.GetData()), m_spot(U), m_tailEstimate(0.0), m_testError(0.0), m_evaluations(0)
+{
+    Layout();
+
+    const size_t D = m_axes.size();
+    const size_t N = m_coefficients.size();
+    std::vector<double> point(D);
+
+    // model values on the tensor grid
+    for (size_t idx = 0; idx < N; ++idx)
+    {
+        for (size_t d = 0; d < D; ++d)
+        {
+            point[d] = Node(m_axes[d], (idx / m_strides[d]) % m_axes[d].nodes);
+        }
+        m_coefficients[idx] = ModelPrice(option, m_data, m_spot, m_axes, point.data());
+    }
+    m_evaluations = N;
+
+    // values to coefficients, a type I discrete cosine transform along each axis in turn
+    std::vector<double> fiber(MAX_NODES);
+    for (size_t d = 0; d < D; ++d)
+    {
+        const size_t n = m_axes[d].nodes;
+        const size_t stride = m_strides[d];
+        const double scale = 2.0 / static_cast<double>(n - 1);
+
+        for (size_t start = 0; start < N; ++start)
+        {
+            if ((start / stride) % n != 0) { continue; }        // one pass per fiber, from its first element
+
+            for (size_t j = 0; j < n; ++j) { fiber[j] = m_coefficients[start + j * stride]; }
+
+            for (size_t k = 0; k < n; ++k)
+            {
+                double sum = 0.5 * (fiber[0] + ((k % 2 == 0) ? fiber[n - 1] : -fiber[n - 1]));
+                for (size_t j = 1; j + 1 < n; ++j)
+                {
+                    sum += fiber[j] * std::cos(PI * static_cast<double>(j * k) / static_cast<double>(n - 1));
+                }
+                m_coefficients[start + k * stride] = ((k == 0 || k == n - 1) ? 0.5 : 1.0) * scale * sum;
+            }
+        }
+    }
+
+    // truncation estimate, twice the highest order slice of every axis
+    for (size_t idx = 0; idx < N; ++idx)
+    {
+        for (size_t d = 0; d < D; ++d)
+        {
+            if ((idx / m_strides[d]) % m_axes[d].nodes == m_axes[d].nodes - 1)
+            {
+                m_tailEstimate += 2.0 * std::abs(m_coefficients[idx]);
+                break;
+            }
+        }
+    }
+
+    // off-grid check against the model
+    std::mt19937_64 engine(TEST_SEED);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    for (size_t i = 0; i < testPoints; ++i)
+    {
+        for (size_t d = 0; d < D; ++d)
+        {
+            point[d] = m_axes[d].lower + (m_axes[d].upper - m_axes[d].lower) * uniform(engine);
+        }
+
+        double error = std::abs(Value(point.data()) - ModelPrice(option, m_data, m_spot, m_axes, point.data()));
+        m_testError = std::max(m_testError, error);
+    }
+    m_evaluations += testPoints;
+}
+
+// parameter constructor, load from file
+ChebyshevProxy::ChebyshevProxy(const std::string& path) : m_axes(), m_strides(), m_coefficients(), m_data(), m_spot(0.0), m_tailEstimate(0.0), m_testError(0.0), m_evaluations(0)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+    {
+        throw std::runtime_error("Failed to open proxy file '" + path + "'");
+    }
+
+    ProxyFileHeader header;
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+
+    if (!file || std::memcmp(header.magic, PROXY_MAGIC, sizeof(PROXY_MAGIC)) != 0 || header.version != FORMAT_VERSION
+        || header.byteOrder != BYTE_ORDER_MARK || header.dimension == 0 || header.dimension > MAX_AXES)
+    {
+        throw std::runtime_error("Invalid proxy file header '" + path + "'");
+    }
+
+    for (uint64_t d = 0; d < header.dimension; ++d)
+    {
+        ProxyFileAxis stored;
+        file.read(reinterpret_cast<char*>(&stored), sizeof(stored));
+        if (!file || stored.parameter > SENS_CARRY)
+        {
+            throw std::runtime_error("Invalid proxy file axis '" + path + "'");
+        }
+
+        ProxyAxis axis = { static_cast<SensitivityParameter>(stored.parameter), stored.lower, stored.upper, static_cast<size_t>(stored.nodes) };
+        m_axes.push_back(axis);
+    }
+
+    try
+    {
+        Layout();
+    }
+    catch (const ArrayException&)
+    {
+        throw std::runtime_error("Invalid proxy file axis '" + path + "'");
+    }
+
+    if (header.size != m_coefficients.size())
+    {
+        throw std::runtime_error("Proxy file size mismatch '" + path + "'");
+    }
+
+    file.read(reinterpret_cast<char*>(m_coefficients.data()), static_cast<std::streamsize>(m_coefficients.size() * sizeof(double)));
+    if (!file)
+    {
+        throw std::runtime_error("Truncated proxy file '" + path + "'");
+    }
+
+    m_data = OptionData(header.k, header.r, header.sig, header.t, header.b);
+    m_spot = header.spot;
+    m_tailEstimate = header.tailEstimate;
+    m_testError = header.testError;
+    m_evaluations = static_cast<size_t>(header.evaluations);
+}
+
+// copy constructor
+ChebyshevProxy::ChebyshevProxy(const ChebyshevProxy& other) : m_axes(other.m_axes), m_strides(other.m_strides), m_coefficients(other.m_coefficients), m_data(other.m_data),
+    m_spot(other.m_spot), m_tailEstimate(other.m_tailEstimate), m_testError(other.m_testError), m_evaluations(other.m_evaluations) { }
+
+// destructor
+ChebyshevProxy::~ChebyshevProxy() = default;
+
+// assignment operator
+ChebyshevProxy& ChebyshevProxy::operator = (const ChebyshevProxy& other)
+{
+    if (this == &other) { return *this; }
+
+    m_axes = other.m_axes;
+    m_strides = other.m_strides;
+    m_coefficients = other.m_coefficients;
+    m_data = other.m_data;
+    m_spot = other.m_spot;
+    m_tailEstimate = other.m_tailEstimate;
+    m_testError = other.m_testError;
+    m_evaluations = other.m_evaluations;
+
+    return *this;
+}
+
+void ChebyshevProxy::Layout()
+{ // every parameter at most once, a non-empty interval and 2 to MAX_NODES nodes per axis
+    if (m_axes.empty() || m_axes.size() > MAX_AXES)
+    {
+        throw UnexpectedInputException();
+    }
+
+    bool seen[MAX_AXES] = { false, false, false, false, false };
+    size_t size = 1;
+
+    m_strides.assign(m_axes.size(), 1);
+    for (size_t d = m_axes.size(); d-- > 0; )
+    {
+        const ProxyAxis& axis = m_axes[d];
+        if (seen[axis.parameter] || !(axis.lower < axis.upper) || axis.nodes < 2 || axis.nodes > MAX_NODES)
+        {
+            throw UnexpectedInputException();
+        }
+        seen[axis.parameter] = true;
+
+        m_strides[d] = size;
+        size *= axis.nodes;
+    }
+
+    m_coefficients.assign(size, 0.0);
+}
+
+double ChebyshevProxy::Contract(const size_t axis, const size_t offset, const double* basis) const
+{ // nested sum over the coefficient tensor, innermost axis is contiguous
+    const size_t n = m_axes[axis].nodes;
+    const double* T = basis + axis * MAX_NODES;
+    double sum = 0.0;
+
+    if (axis + 1 == m_axes.size())
+    {
+        const double* c = m_coefficients.data() + offset;
+        for (size_t k = 0; k < n; ++k) { sum += c[k] * T[k]; }
+        return sum;
+    }
+
+    for (size_t k = 0; k < n; ++k)
+    {
+        sum += T[k] * Contract(axis + 1, offset + k * m_strides[axis], basis);
+    }
+    return sum;
+}
+
+double ChebyshevProxy::Value(const double* point) const
+{ // Chebyshev polynomials of every axis by recurrence, then one pass over the coefficients
+    if (m_axes.empty())
+    {
+        throw EmptyArrayException();
+    }
+
+    double basis[MAX_AXES * MAX_NODES];
+
+    for (size_t d = 0; d < m_axes.size(); ++d)
+    {
+        const ProxyAxis& axis = m_axes[d];
+        if (!(point[d] >= axis.lower && point[d] <= axis.upper))
+        {
+            throw ProxyDomainException(axis.parameter, point[d], axis.lower, axis.upper);
+        }
+
+        double* T = basis + d * MAX_NODES;
+        const double x = (2.0 * point[d] - axis.lower - axis.upper) / (axis.upper - axis.lower);
+        T[0] = 1.0;
+        T[1] = x;
+        for (size_t k = 2; k < axis.nodes; ++k) { T[k] = 2.0 * x * T[k - 1] - T[k - 2]; }
+    }
+
+    return Contract(0, 0, basis);
+}
+
+double ChebyshevProxy::Value(const std::vector<double>& point) const
+{
+    if (point.size() != m_axes.size())
+    {
+        throw SizeMismatchException();
+    }
+
+    return Value(point.data());
+}
+
+double ChebyshevProxy::Price(const double U, const OptionData& data) const
+{
+    double point[MAX_AXES];
+    bool onAxis[MAX_AXES] = { false, false, false, false, false };     // indexed by SensitivityParameter
+
+    for (size_t d = 0; d < m_axes.size(); ++d)
+    {
+        onAxis[m_axes[d].parameter] = true;
+        switch (m_axes[d].parameter)
+        {
+            case SENS_SPOT: point[d] = U; break;
+            case SENS_VOL: point[d] = data.Sig(); break;
+            case SENS_RATE: point[d] = data.R(); break;
+            case SENS_MATURITY: point[d] = data.T(); break;
+            case SENS_CARRY: point[d] = data.B(); break;
+        }
+    }
+
+    CheckFixed("Strike", data.K(), m_data.K());
+    if (!onAxis[SENS_SPOT]) { CheckFixed("Spot", U, m_spot); }
+    if (!onAxis[SENS_VOL]) { CheckFixed("Vol", data.Sig(), m_data.Sig()); }
+    if (!onAxis[SENS_RATE]) { CheckFixed("Rate", data.R(), m_data.R()); }
+    if (!onAxis[SENS_MATURITY]) { CheckFixed("Maturity", data.T(), m_data.T()); }
+    if (!onAxis[SENS_CARRY]) { CheckFixed("Carry", data.B(), m_data.B()); }
+
+    return Value(point);
+}
+
+void ChebyshevProxy::Save(const std::string& path) const
+{
+    if (m_axes.empty())
+    {
+        throw EmptyArrayException();
+    }
+
+    ProxyFileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, PROXY_MAGIC, sizeof(header.magic));
+    header.version = FORMAT_VERSION;
+    header.byteOrder = BYTE_ORDER_MARK;
+    header.dimension = m_axes.size();
+    header.size = m_coefficients.size();
+    header.evaluations = m_evaluations;
+    header.spot = m_spot;
+    header.k = m_data.K();
+    header.r = m_data.R();
+    header.sig = m_data.Sig();
+    header.t = m_data.T();
+    header.b = m_data.B();
+    header.tailEstimate = m_tailEstimate;
+    header.testError = m_testError;
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file)
+    {
+        throw std::runtime_error("Failed to create proxy file '" + path + "'");
+    }
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    for (size_t d = 0; d < m_axes.size(); ++d)
+    {
+        ProxyFileAxis stored = { static_cast<uint64_t>(m_axes[d].parameter), m_axes[d].nodes, m_axes[d].lower, m_axes[d].upper };
+        file.write(reinterpret_cast<const char*>(&stored), sizeof(stored));
+    }
+    file.write(reinterpret_cast<const char*>(m_coefficients.data()), static_cast<std::streamsize>(m_coefficients.size() * sizeof(double)));
+
+    file.close();
+    if (!file)
+    {
+        throw std::runtime_error("Failed to write proxy file '" + path + "'");
+    }
+}
+
+// error reported at build time
+double ChebyshevProxy::ErrorBound() const
+{
+    return std::max(m_tailEstimate, m_testError);
+}
+
+double ChebyshevProxy::TailEstimate() const
+{
+    return m_tailEstimate;
+}
+
+double ChebyshevProxy::TestError() const
+{
+    return m_testError;
+}
+
+// getter functions
+const std::vector<ProxyAxis>& ChebyshevProxy::Axes() const
+{
+    return m_axes;
+}
+
+size_t ChebyshevProxy::Dimension() const
+{
+    return m_axes.size();
+}
+
+size_t ChebyshevProxy::Size() const
+{
+    return m_coefficients.size();
+}
+
+size_t ChebyshevProxy::Evaluations() const
+{
+    return m_evaluations;
+}
+
+} // namespace Engine
+} // namespace AidanRicher
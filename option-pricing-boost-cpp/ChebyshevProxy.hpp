@@ -0,0 +1,112 @@
+#ifndef ChebyshevProxy_HPP
+#define ChebyshevProxy_HPP
+
+#include "Option.hpp"
+#include "OptionData.hpp"
+#include "SensitivityEngine.hpp"
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace AidanRicher {
+namespace Engine {
+
+// one dimension of the proxy domain, the parameter varies over [lower, upper] on nodes Chebyshev points
+struct ProxyAxis {
+    SensitivityParameter parameter;     // input varied along this axis (spot, vol, rate, maturity or carry)
+    double lower;                       // lower bound of the domain
+    double upper;                       // upper bound of the domain
+    size_t nodes;                       // Chebyshev points, the polynomial degree is nodes - 1
+};
+
+// thrown for a point outside the proxy domain, the proxy does not extrapolate
+// the message names the axis parameter, the value and the declared range, e.g. "Spot 90 outside the proxy range [100, 140]."
+class ProxyDomainException : public std::out_of_range {
+    private:
+        SensitivityParameter m_parameter;
+        double m_value;
+        double m_lower;
+        double m_upper;
+
+        static std::string Message(const SensitivityParameter parameter, const double value, const double lower, const double upper);
+
+    public:
+        // parameter constructor
+        ProxyDomainException(const SensitivityParameter parameter, const double value, const double lower, const double upper);
+
+        // getter functions
+        SensitivityParameter Parameter() const;
+        double Value() const;
+        double Lower() const;
+        double Upper() const;
+};
+
+// tensor Chebyshev interpolant of the price of any Option over a box of (spot, vol, r, T, b)
+// built offline from Price(U) on the Chebyshev-Lobatto grid, then evaluated with a few multiply-adds per coefficient
+// parameters without an axis stay at the values of the option (and spot) the proxy was built from
+class ChebyshevProxy {
+    private:
+        std::vector<ProxyAxis> m_axes;          // domain, one entry per varied parameter
+        std::vector<size_t> m_strides;          // coefficient strides, last axis fastest
+        std::vector<double> m_coefficients;     // Chebyshev coefficients c[k0][k1]...
+        OptionData m_data;                      // fixed params off the axes
+        double m_spot;                          // fixed spot when spot is not an axis
+        double m_tailEstimate;                  // truncation estimate from the highest order coefficients
+        double m_testError;                     // max |proxy - model| over random points at build time
+        size_t m_evaluations;                   // model prices taken to build and test the proxy
+
+        void Layout();                                                      // validate the axes, set the strides
+        double Contract(const size_t axis, const size_t offset, const double* basis) const;      // sum of c * T_k0 * T_k1 ...
+
+    public:
+        static const size_t MAX_NODES = 64;     // per axis
+
+        // default constructor, empty proxy
+        ChebyshevProxy();
+
+        // parameter constructor, builds the proxy, option is priced on every grid node and at testPoints random points
+        // throws UnexpectedInputException for an empty, repeated or degenerate axis
+        ChebyshevProxy(const Option& option, const double U, const std::vector<ProxyAxis>& axes, const size_t testPoints = 1000);
+
+        // parameter constructor, loads a proxy written by Save(), throws std::runtime_error for a bad file
+        explicit ChebyshevProxy(const std::string& path);
+
+        // copy constructor
+        ChebyshevProxy(const ChebyshevProxy& other);
+
+        // destructor
+        ~ChebyshevProxy();
+
+        // assignment operator
+        ChebyshevProxy& operator = (const ChebyshevProxy& other);
+
+        // proxy price at point[d] on axis d, throws ProxyDomainException outside the domain of any axis
+        double Value(const double* point) const;
+        double Value(const std::vector<double>& point) const;
+
+        // proxy price with the axis parameters read from a spot and contract
+        // parameters off the axes (always K, and U, sig, r, T or b without an axis) must match the build contract
+        // to 1e-12 relative, otherwise std::invalid_argument naming the parameter, the proxy cannot price another contract
+        double Price(const double U, const OptionData& data) const;
+
+        // binary file, native byte order
+        void Save(const std::string& path) const;
+
+        // error reported at build time, ErrorBound() = max(TailEstimate(), TestError())
+        // a sampled bound for a black box model, not a proof, it holds where the model is as smooth as the samples suggest
+        double ErrorBound() const;
+        double TailEstimate() const;
+        double TestError() const;
+
+        // getter functions
+        const std::vector<ProxyAxis>& Axes() const;
+        size_t Dimension() const;
+        size_t Size() const;                // number of coefficients
+        size_t Evaluations() const;         // model prices taken at build time
+};
+
+} // namespace Engine
+} // namespace AidanRicher
+
+#endif // ChebyshevProxy_HPP
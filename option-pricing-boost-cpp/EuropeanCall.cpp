@@ -1,6 +1,7 @@
 #include "EuropeanCall.hpp"
 #include <boost/math/distributions/normal.hpp>
 #include <cmath>
+#include <complex>
 #include <iostream>
 #include <stdexcept>
 
@@ -9,6 +10,18 @@ using namespace boost::math;
 namespace AidanRicher {
 namespace Engine {
 
+namespace {
+
+// normal cdf continued to a complex argument to first order, N(a + ib) = N(a) + ib * n(a) + O(b^2)
+// exact to machine precision for the tiny imaginary parts used by complex-step differentiation
+std::complex<double> ComplexCdf(const std::complex<double>& x)
+{
+    normal_distribution<> myNormal;
+    return std::complex<double>(cdf(myNormal, x.real()), x.imag() * pdf(myNormal, x.real()));
+}
+
+} // namespace
+
 // default constructor
 EuropeanCall::EuropeanCall() : m_data() { }
 
@@ -89,26 +102,33 @@ double EuropeanCall::PutCallParity(const double U) const
 
 double EuropeanCall::DividedDifferenceDelta(const double U, const double h) const
 { // delta approximation using the divided difference method
-    if (abs(Price(U + h) - Price(U - h)) <= std::pow(2, -53))
+    double up = Price(U + h);
+    double down = Price(U - h);
+
+    if (abs(up - down) <= std::pow(2, -53))
     {
         std::cout << "H is too small for accurate computation." << std::endl;
         return 0;
     }
 
     // return approximated delta
-    return (Price(U + h) - Price(U - h)) / (2.0 * h);
+    return (up - down) / (2.0 * h);
 }
 
 double EuropeanCall::DividedDifferenceGamma(const double U, const double h) const
 { // gamma approximation using the divided difference method
-    if (abs(Price(U + h) - 2.0 * Price(U) + Price(U - h)) <= std::pow(2, -53))
+    double up = Price(U + h);
+    double mid = Price(U);
+    double down = Price(U - h);
+
+    if (abs(up - 2.0 * mid + down) <= std::pow(2, -53))
     {
         std::cout << "H is too small for accurate computation." << std::endl;
         return 0;
     }
     
     // return approximated gamma
-    return (Price(U + h) - 2.0 * Price(U) + Price(U - h)) / (h * h); 
+    return (up - 2.0 * mid + down) / (h * h); 
 }
 
 std::ostream& operator << (std::ostream& os, const EuropeanCall& source)
@@ -136,5 +156,29 @@ Option* EuropeanCall::Clone() const
     return new EuropeanCall(*this);
 }
 
+Option* EuropeanCall::Clone(const OptionData& data) const
+{
+    return new EuropeanCall(data);
+}
+
+bool EuropeanCall::HasComplexPrice() const
+{
+    return true;
+}
+
+std::complex<double> EuropeanCall::ComplexPrice(const std::complex<double>& U) const
+{ // call price at a complex spot, Im(Price(U + ih)) / h is the delta with no subtractive cancellation
+    if (U.real() <= 0.0)
+    {
+        throw std::invalid_argument("Underlying spot price U must be positive.");
+    }
+
+    std::complex<double> d1 = (std::log(U / m_data.K()) + (m_data.B() + 0.5 * m_data.Sig() * m_data.Sig()) * m_data.T()) / (m_data.Sig() * sqrt(m_data.T()));
+    std::complex<double> d2 = d1 - m_data.Sig() * sqrt(m_data.T());
+
+    // return complex call price
+    return U * exp((m_data.B() - m_data.R()) * m_data.T()) * ComplexCdf(d1) - m_data.K() * exp(-m_data.R() * m_data.T()) * ComplexCdf(d2);
+}
+
 } // namespace Engine
 } // namespace AidanRicher
\ No newline at end of file
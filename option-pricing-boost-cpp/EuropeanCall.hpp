@@ -3,6 +3,7 @@
 
 #include "Option.hpp"               
 #include "OptionData.hpp"           
+#include <complex>
 #include <string>
 #include <iostream>    
 
@@ -47,6 +48,9 @@ class EuropeanCall : public Option {
         // overrides of pure virtual methods from Option base class
         virtual std::string Type() const override;
         virtual Option* Clone() const override;
+        virtual Option* Clone(const OptionData& data) const override;
+        virtual bool HasComplexPrice() const override;
+        virtual std::complex<double> ComplexPrice(const std::complex<double>& U) const override;     // price at a complex spot, for complex-step greeks
 };
 
 } // namespace Engine
@@ -0,0 +1,176 @@
+#include "FourierPricer.hpp"
+#include "ArrayException.hpp"
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <vector>
+
+using namespace AidanRicher::Containers;
+
+namespace AidanRicher {
+namespace Engine {
+
+namespace {
+
+const double PI = 3.14159265358979323846;
+const std::complex<double> I(0.0, 1.0);
+
+void FFT(std::vector<std::complex<double>>& a)
+{ // in place iterative radix-2, size must be a power of two
+    const size_t n = a.size();
+
+    for (size_t i = 1, j = 0; i < n; ++i)
+    { // bit reversal permutation
+        size_t bit = n >> 1;
+        for (; j & bit; bit >>= 1) { j ^= bit; }
+        j ^= bit;
+        if (i < j) { std::swap(a[i], a[j]); }
+    }
+
+    for (size_t len = 2; len <= n; len <<= 1)
+    {
+        const std::complex<double> w(std::cos(-2.0 * PI / static_cast<double>(len)), std::sin(-2.0 * PI / static_cast<double>(len)));
+        for (size_t i = 0; i < n; i += len)
+        {
+            std::complex<double> wk(1.0, 0.0);
+            for (size_t k = 0; k < len / 2; ++k)
+            {
+                std::complex<double> even = a[i + k];
+                std::complex<double> odd = a[i + k + len / 2] * wk;
+                a[i + k] = even + odd;
+                a[i + k + len / 2] = even - odd;
+                wk *= w;
+            }
+        }
+    }
+}
+
+// parity, C - P = U * phi(-i) * exp(-r T) - K * exp(-r T), phi(-i) = E[S(T) / U] is the forward factor
+inline double Parity(const double forward, const double discount, const double K)
+{
+    return (forward - K) * discount;
+}
+
+} // namespace
+
+void CosPrices(const CharacteristicFunction& cf, const bool call, const double U, const double r, const double T,
+               const double* strikes, const size_t n, double* prices, const size_t terms, const double L)
+{
+    if (n == 0) { return; }
+    if (!(U > 0.0) || !(T > 0.0) || terms == 0)
+    {
+        throw UnexpectedInputException();
+    }
+
+    double c1, c2, c4;
+    cf.Cumulants(T, c1, c2, c4);
+    const double width = L * std::sqrt(c2 + std::sqrt(c4));
+
+    // one interval on y = ln(S(T) / K) that covers every strike of the chain
+    double xMin = std::log(U / strikes[0]);
+    double xMax = xMin;
+    for (size_t i = 0; i < n; ++i)
+    {
+        if (!(strikes[i] > 0.0)) { throw UnexpectedInputException(); }
+        const double x = std::log(U / strikes[i]);
+        xMin = std::min(xMin, x);
+        xMax = std::max(xMax, x);
+    }
+    const double a = xMin + c1 - width;
+    const double b = xMax + c1 + width;
+    const double range = b - a;
+
+    // characteristic function and put payoff coefficients, once per term and shared by all strikes
+    std::vector<std::complex<double>> phi(terms);
+    std::vector<double> V(terms);
+    for (size_t k = 0; k < terms; ++k)
+    {
+        const double u = static_cast<double>(k) * PI / range;
+        phi[k] = cf(std::complex<double>(u, 0.0), T);
+
+        // chi and psi over [a, 0], the put payoff (1 - e^y)^+ lives on y < 0
+        const double ua = u * (0.0 - a);
+        const double chi = (std::cos(ua) - std::exp(a) + u * std::sin(ua)) / (1.0 + u * u);
+        const double psi = (k == 0) ? -a : std::sin(ua) / u;
+
+        V[k] = (2.0 / range) * (psi - chi);
+    }
+    V[0] *= 0.5;        // first term of the cosine series has weight one half
+
+    const double discount = std::exp(-r * T);
+    const double forward = U * cf(std::complex<double>(0.0, -1.0), T).real();
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        const double K = strikes[i];
+        const double x = std::log(U / K);
+        double sum = 0.0;
+
+        for (size_t k = 0; k < terms; ++k)
+        {
+            const double u = static_cast<double>(k) * PI / range;
+            sum += (phi[k] * std::exp(I * (u * (x - a)))).real() * V[k];
+        }
+
+        const double put = std::max(K * discount * sum, 0.0);
+        prices[i] = call ? put + Parity(forward, discount, K) : put;
+    }
+}
+
+void CarrMadanPrices(const CharacteristicFunction& cf, const bool call, const double U, const double r, const double T,
+                     const double* strikes, const size_t n, double* prices, const size_t gridSize, const double eta, const double alpha)
+{
+    if (n == 0) { return; }
+    if (!(U > 0.0) || !(T > 0.0) || gridSize < 4 || (gridSize & (gridSize - 1)) != 0 || !(eta > 0.0) || !(alpha > 0.0))
+    {
+        throw UnexpectedInputException();
+    }
+
+    const double discount = std::exp(-r * T);
+    const double lambda = 2.0 * PI / (static_cast<double>(gridSize) * eta);       // log-strike spacing
+    const double k0 = std::log(U) - 0.5 * static_cast<double>(gridSize) * lambda;  // first log strike
+
+    // psi(v) = e^{-rT} phi_lnS(v - (alpha + 1) i) / (alpha^2 + alpha - v^2 + i (2 alpha + 1) v), Simpson weights
+    std::vector<std::complex<double>> x(gridSize);
+    for (size_t j = 0; j < gridSize; ++j)
+    {
+        const double v = eta * static_cast<double>(j);
+        const std::complex<double> u(v, -(alpha + 1.0));
+        const std::complex<double> phiLnS = std::exp(I * u * std::log(U)) * cf(u, T);
+        const std::complex<double> psi = discount * phiLnS / std::complex<double>(alpha * alpha + alpha - v * v, (2.0 * alpha + 1.0) * v);
+        const double simpson = (3.0 + ((j % 2 == 0) ? -1.0 : 1.0) - (j == 0 ? 1.0 : 0.0)) / 3.0;
+
+        x[j] = std::exp(-I * (v * k0)) * psi * eta * simpson;
+    }
+
+    FFT(x);
+
+    std::vector<double> callGrid(gridSize);
+    for (size_t m = 0; m < gridSize; ++m)
+    {
+        const double k = k0 + lambda * static_cast<double>(m);
+        callGrid[m] = std::exp(-alpha * k) / PI * x[m].real();
+    }
+
+    const double forward = U * cf(std::complex<double>(0.0, -1.0), T).real();
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        if (!(strikes[i] > 0.0)) { throw UnexpectedInputException(); }
+
+        // cubic Lagrange interpolation in log strike on the four nearest grid points, clamped to the grid
+        const double pos = (std::log(strikes[i]) - k0) / lambda;
+        const double first = std::min(std::max(std::floor(pos) - 1.0, 0.0), static_cast<double>(gridSize - 4));
+        const size_t m = static_cast<size_t>(first);
+        const double t = std::min(std::max(pos - first, 0.0), 3.0);
+        const double c = -callGrid[m] * (t - 1.0) * (t - 2.0) * (t - 3.0) / 6.0
+                       + callGrid[m + 1] * t * (t - 2.0) * (t - 3.0) / 2.0
+                       - callGrid[m + 2] * t * (t - 1.0) * (t - 3.0) / 2.0
+                       + callGrid[m + 3] * t * (t - 1.0) * (t - 2.0) / 6.0;
+
+        prices[i] = call ? c : c - Parity(forward, discount, strikes[i]);
+    }
+}
+
+} // namespace Engine
+} // namespace AidanRicher
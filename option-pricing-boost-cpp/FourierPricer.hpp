@@ -0,0 +1,28 @@
+#ifndef FourierPricer_HPP
+#define FourierPricer_HPP
+
+#include "CharacteristicFunction.hpp"
+#include <cstddef>
+
+namespace AidanRicher {
+namespace Engine {
+
+// whole strike chains from a characteristic function, one expiry per call
+// prices[i] is the european call (call = true) or put at strikes[i], spot U, rate r, expiry T
+
+// COS method (Fang and Oosterlee 2008), puts are expanded directly and calls follow from parity
+// terms cosine terms share one characteristic function evaluation each across all strikes, O(terms * n)
+// L is the truncation width in standard deviations of the log return, widen it for fat tailed models (e.g. Heston with large xi)
+void CosPrices(const CharacteristicFunction& cf, const bool call, const double U, const double r, const double T,
+               const double* strikes, const size_t n, double* prices, const size_t terms = 256, const double L = 12.0);
+
+// Carr-Madan (1999) damped call transform with Simpson weights, one FFT of gridSize points gives calls
+// on a log-strike grid centred at ln U with spacing 2 pi / (gridSize * eta), cubic interpolated to the strikes
+// gridSize must be a power of two, alpha is the damping exponent
+void CarrMadanPrices(const CharacteristicFunction& cf, const bool call, const double U, const double r, const double T,
+                     const double* strikes, const size_t n, double* prices, const size_t gridSize = 4096, const double eta = 0.25, const double alpha = 1.5);
+
+} // namespace Engine
+} // namespace AidanRicher
+
+#endif // FourierPricer_HPP
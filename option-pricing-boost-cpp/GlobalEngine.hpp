@@ -3,6 +3,7 @@
 
 #include "EuropeanCall.hpp"
 #include "EuropeanPut.hpp"
+#include "MeshView.hpp"
 #include <iostream>
 #include <cmath>
 #include <vector>
@@ -13,17 +14,11 @@ namespace AidanRicher {
 namespace Engine {
 
 // generate a mesh array from start to end with step size h
+// materializes a UniformMesh, use the view in MeshView.hpp directly when no vector is needed
 template <typename T> 
 vector<T> MeshArray(const T start, const T step_size_h, const size_t vector_size)
 {
-    vector<T> mesh;
-    
-    for (size_t i = 0; i < vector_size; ++i)
-    {
-        mesh.push_back(start + i * step_size_h);
-    }
-
-    return mesh;
+    return UniformMesh<T>(start, step_size_h, vector_size).ToVector();
 }
 
 // global function to check put-call parity
@@ -0,0 +1,325 @@
+#include "IncrementalPricer.hpp"
+#include "EuropeanCall.hpp"
+#include "EuropeanPut.hpp"
+#include "PerpAmericanCall.hpp"
+#include "PerpAmericanPut.hpp"
+#include "ArrayException.hpp"
+#include <cmath>
+
+using namespace AidanRicher::Containers;
+
+namespace AidanRicher {
+namespace Engine {
+
+// default constructor
+IncrementalPricer::IncrementalPricer() : m_positions(), m_byUnderlying(), m_dirty(), m_tolerance(0.0), m_fullCount(0), m_taylorCount(0), m_cache(nullptr) { }
+
+// parameter constructor
+IncrementalPricer::IncrementalPricer(const double tolerance) : m_positions(), m_byUnderlying(), m_dirty(), m_tolerance(tolerance), m_fullCount(0), m_taylorCount(0), m_cache(nullptr) { }
+
+// copy constructor
+IncrementalPricer::IncrementalPricer(const IncrementalPricer& other) : m_positions(other.m_positions), m_byUnderlying(other.m_byUnderlying), m_dirty(other.m_dirty), m_tolerance(other.m_tolerance), m_fullCount(other.m_fullCount), m_taylorCount(other.m_taylorCount), m_cache(other.m_cache) { }
+
+// destructor
+IncrementalPricer::~IncrementalPricer() = default;
+
+// assignment operator
+IncrementalPricer& IncrementalPricer::operator = (const IncrementalPricer& other)
+{
+    if (this == &other) { return *this; }
+
+    m_positions = other.m_positions;
+    m_byUnderlying = other.m_byUnderlying;
+    m_dirty = other.m_dirty;
+    m_tolerance = other.m_tolerance;
+    m_fullCount = other.m_fullCount;
+    m_taylorCount = other.m_taylorCount;
+    m_cache = other.m_cache;
+
+    return *this;
+}
+
+void IncrementalPricer::MarkDirty(const size_t id, const bool params)
+{ // queue a position once, params flags that the Taylor shortcut is no longer valid
+    Position& pos = m_positions[id];
+
+    if (params) { pos.paramsDirty = true; }
+
+    if (!pos.dirty)
+    {
+        pos.dirty = true;
+        m_dirty.push_back(id);
+    }
+}
+
+void IncrementalPricer::FullEvaluate(Position& pos) const
+{ // full closed form evaluation, same dispatch as PricingMatrix
+    CachedGreeks cached;
+    const bool hit = m_cache && m_cache->Find(pos.type, pos.data, pos.spot, cached);
+
+    if (hit)
+    {
+        pos.price = cached.price;
+        pos.delta = cached.delta;
+        pos.gamma = cached.gamma;
+    }
+    else if (pos.type == "EuropeanCall")
+    {
+        EuropeanCall opt(pos.data);
+        pos.price = opt.Price(pos.spot);
+        pos.delta = opt.Delta(pos.spot);
+        pos.gamma = opt.Gamma(pos.spot);
+    }
+    else if (pos.type == "EuropeanPut")
+    {
+        EuropeanPut opt(pos.data);
+        pos.price = opt.Price(pos.spot);
+        pos.delta = opt.Delta(pos.spot);
+        pos.gamma = opt.Gamma(pos.spot);
+    }
+    else if (pos.type == "PerpAmericanCall")
+    {
+        PerpAmericanCall opt(pos.data);
+        pos.price = opt.Price(pos.spot);
+        pos.delta = opt.Delta(pos.spot);
+        pos.gamma = opt.Gamma(pos.spot);
+    }
+    else if (pos.type == "PerpAmericanPut")
+    {
+        PerpAmericanPut opt(pos.data);
+        pos.price = opt.Price(pos.spot);
+        pos.delta = opt.Delta(pos.spot);
+        pos.gamma = opt.Gamma(pos.spot);
+    }
+    else
+    {
+        throw UnexpectedInputException();
+    }
+
+    if (m_cache && !hit)
+    {
+        cached.price = pos.price;
+        cached.delta = pos.delta;
+        cached.gamma = pos.gamma;
+        m_cache->Insert(pos.type, pos.data, pos.spot, cached);
+    }
+
+    // new expansion point
+    pos.refSpot = pos.spot;
+    pos.refPrice = pos.price;
+    pos.refDelta = pos.delta;
+    pos.refGamma = pos.gamma;
+}
+
+const std::vector<size_t>& IncrementalPricer::Positions(const std::string& underlying) const
+{ // position ids on an underlying, empty if the underlying is unknown
+    static const std::vector<size_t> none;
+
+    std::map<std::string, std::vector<size_t>>::const_iterator itr = m_byUnderlying.find(underlying);
+    return (itr == m_byUnderlying.end()) ? none : itr->second;
+}
+
+size_t IncrementalPricer::AddPosition(const std::string& underlying, const std::string& type, const OptionData& data, const double spot)
+{
+    if (type != "EuropeanCall" && type != "EuropeanPut" && type != "PerpAmericanCall" && type != "PerpAmericanPut")
+    {
+        throw UnexpectedInputException();
+    }
+
+    Position pos;
+    pos.underlying = underlying;
+    pos.type = type;
+    pos.data = data;
+    pos.spot = spot;
+    pos.price = pos.delta = pos.gamma = 0.0;
+    pos.refSpot = pos.refPrice = pos.refDelta = pos.refGamma = 0.0;
+    pos.dirty = false;
+    pos.paramsDirty = false;
+
+    size_t id = m_positions.size();
+    m_positions.push_back(pos);
+    m_byUnderlying[underlying].push_back(id);
+    MarkDirty(id, true);        // never priced, needs a full evaluation
+
+    return id;
+}
+
+void IncrementalPricer::UpdateSpot(const std::string& underlying, const double spot)
+{ // only positions on this underlying are touched
+    const std::vector<size_t>& ids = Positions(underlying);
+
+    for (size_t i = 0; i < ids.size(); ++i)
+    {
+        Position& pos = m_positions[ids[i]];
+        if (pos.spot == spot) { continue; }
+
+        pos.spot = spot;
+        MarkDirty(ids[i], false);
+    }
+}
+
+void IncrementalPricer::UpdateVol(const std::string& underlying, const double sig)
+{
+    const std::vector<size_t>& ids = Positions(underlying);
+
+    for (size_t i = 0; i < ids.size(); ++i)
+    {
+        UpdateVol(ids[i], sig);
+    }
+}
+
+void IncrementalPricer::UpdateRate(const std::string& underlying, const double r)
+{
+    const std::vector<size_t>& ids = Positions(underlying);
+
+    for (size_t i = 0; i < ids.size(); ++i)
+    {
+        Position& pos = m_positions[ids[i]];
+        if (pos.data.R() == r) { continue; }
+
+        pos.data.R(r);
+        MarkDirty(ids[i], true);
+    }
+}
+
+void IncrementalPricer::UpdateCarry(const std::string& underlying, const double b)
+{
+    const std::vector<size_t>& ids = Positions(underlying);
+
+    for (size_t i = 0; i < ids.size(); ++i)
+    {
+        Position& pos = m_positions[ids[i]];
+        if (pos.data.B() == b) { continue; }
+
+        pos.data.B(b);
+        MarkDirty(ids[i], true);
+    }
+}
+
+void IncrementalPricer::UpdateVol(const size_t id, const double sig)
+{
+    if (id >= m_positions.size())
+    {
+        throw OutOfBoundsException(static_cast<int>(id));
+    }
+
+    Position& pos = m_positions[id];
+    if (pos.data.Sig() == sig) { return; }
+
+    pos.data.Sig(sig);
+    MarkDirty(id, true);
+}
+
+void IncrementalPricer::SetCache(PriceCache* cache)
+{
+    m_cache = cache;
+}
+
+size_t IncrementalPricer::Reprice()
+{ // recompute only the dirty positions
+    m_fullCount = 0;
+    m_taylorCount = 0;
+
+    for (size_t i = 0; i < m_dirty.size(); ++i)
+    {
+        Position& pos = m_positions[m_dirty[i]];
+        double dS = pos.spot - pos.refSpot;
+
+        if (!pos.paramsDirty && m_tolerance > 0.0 && std::abs(dS) <= m_tolerance * pos.refSpot)
+        { // small spot move, second order expansion around the last full evaluation
+            pos.price = pos.refPrice + pos.refDelta * dS + 0.5 * pos.refGamma * dS * dS;
+            pos.delta = pos.refDelta + pos.refGamma * dS;
+            pos.gamma = pos.refGamma;
+            ++m_taylorCount;
+        }
+        else
+        {
+            FullEvaluate(pos);
+            ++m_fullCount;
+        }
+
+        pos.dirty = false;
+        pos.paramsDirty = false;
+    }
+
+    size_t updated = m_dirty.size();
+    m_dirty.clear();
+
+    return updated;
+}
+
+void IncrementalPricer::RepriceAll()
+{
+    for (size_t i = 0; i < m_positions.size(); ++i)
+    {
+        MarkDirty(i, true);
+    }
+
+    Reprice();
+}
+
+// getter functions
+double IncrementalPricer::Price(const size_t id) const
+{
+    if (id >= m_positions.size()) { throw OutOfBoundsException(static_cast<int>(id)); }
+    return m_positions[id].price;
+}
+
+double IncrementalPricer::Delta(const size_t id) const
+{
+    if (id >= m_positions.size()) { throw OutOfBoundsException(static_cast<int>(id)); }
+    return m_positions[id].delta;
+}
+
+double IncrementalPricer::Gamma(const size_t id) const
+{
+    if (id >= m_positions.size()) { throw OutOfBoundsException(static_cast<int>(id)); }
+    return m_positions[id].gamma;
+}
+
+double IncrementalPricer::Spot(const size_t id) const
+{
+    if (id >= m_positions.size()) { throw OutOfBoundsException(static_cast<int>(id)); }
+    return m_positions[id].spot;
+}
+
+const OptionData& IncrementalPricer::GetData(const size_t id) const
+{
+    if (id >= m_positions.size()) { throw OutOfBoundsException(static_cast<int>(id)); }
+    return m_positions[id].data;
+}
+
+size_t IncrementalPricer::Size() const
+{
+    return m_positions.size();
+}
+
+size_t IncrementalPricer::DirtyCount() const
+{
+    return m_dirty.size();
+}
+
+size_t IncrementalPricer::FullEvaluations() const
+{
+    return m_fullCount;
+}
+
+size_t IncrementalPricer::TaylorUpdates() const
+{
+    return m_taylorCount;
+}
+
+double IncrementalPricer::BookValue() const
+{
+    double total = 0.0;
+
+    for (size_t i = 0; i < m_positions.size(); ++i)
+    {
+        total += m_positions[i].price;
+    }
+
+    return total;
+}
+
+} // namespace Engine
+} // namespace AidanRicher
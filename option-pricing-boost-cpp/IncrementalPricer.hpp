@@ -0,0 +1,100 @@
+#ifndef IncrementalPricer_HPP
+#define IncrementalPricer_HPP
+
+#include "OptionData.hpp"
+#include "PriceCache.hpp"
+#include <map>
+#include <string>
+#include <vector>
+
+namespace AidanRicher {
+namespace Engine {
+
+class IncrementalPricer {
+    private:
+        struct Position {
+            std::string underlying;     // underlying identifier the position is written on
+            std::string type;           // option type ("EuropeanCall", "EuropeanPut", "PerpAmericanCall", "PerpAmericanPut")
+            OptionData data;            // contract params (k, r, sig, t, b)
+            double spot;                // current spot of the underlying
+
+            // cached results
+            double price;
+            double delta;
+            double gamma;
+
+            // point of the last full evaluation, used as the Taylor expansion point
+            double refSpot;
+            double refPrice;
+            double refDelta;
+            double refGamma;
+
+            bool dirty;                 // position is queued for repricing
+            bool paramsDirty;           // vol/rate/carry changed, Taylor shortcut not allowed
+        };
+
+        std::vector<Position> m_positions;                          // all positions, indexed by id
+        std::map<std::string, std::vector<size_t>> m_byUnderlying;  // underlying -> position ids
+        std::vector<size_t> m_dirty;                                // ids queued for repricing
+        double m_tolerance;                                         // max relative spot move for the delta-gamma shortcut
+        size_t m_fullCount;                                         // full evaluations in the last Reprice()
+        size_t m_taylorCount;                                       // Taylor updates in the last Reprice()
+        PriceCache* m_cache;                                        // optional shared memo for full evaluations, not owned
+
+        void MarkDirty(size_t id, bool params);     // queue a position for repricing
+        void FullEvaluate(Position& pos) const;     // price, delta and gamma from the closed form
+        const std::vector<size_t>& Positions(const std::string& underlying) const;
+
+    public:
+        // default constructor, no Taylor shortcut
+        IncrementalPricer();
+
+        // parameter constructor
+        // tolerance is the relative spot move (|dS| / S) below which a delta-gamma expansion is used instead of a full reprice
+        IncrementalPricer(const double tolerance);
+
+        // copy constructor
+        IncrementalPricer(const IncrementalPricer& other);
+
+        // destructor
+        ~IncrementalPricer();
+
+        // assignment operator
+        IncrementalPricer& operator = (const IncrementalPricer& other);
+
+        // add a position and return its id, the position is priced on the next Reprice()
+        size_t AddPosition(const std::string& underlying, const std::string& type, const OptionData& data, const double spot);
+
+        // market data updates, mark only the affected positions dirty
+        void UpdateSpot(const std::string& underlying, const double spot);
+        void UpdateVol(const std::string& underlying, const double sig);
+        void UpdateRate(const std::string& underlying, const double r);
+        void UpdateCarry(const std::string& underlying, const double b);
+        void UpdateVol(const size_t id, const double sig);      // single contract vol update
+
+        // consult a shared cache before each full evaluation, nullptr switches it off again
+        void SetCache(PriceCache* cache);
+
+        // recompute all dirty positions, returns the number of positions updated
+        size_t Reprice();
+
+        // force a full reprice of every position
+        void RepriceAll();
+
+        // getter functions (values as of the last Reprice())
+        double Price(const size_t id) const;
+        double Delta(const size_t id) const;
+        double Gamma(const size_t id) const;
+        double Spot(const size_t id) const;
+        const OptionData& GetData(const size_t id) const;
+        size_t Size() const;
+        size_t DirtyCount() const;
+        size_t FullEvaluations() const;     // full evaluations in the last Reprice()
+        size_t TaylorUpdates() const;       // delta-gamma updates in the last Reprice()
+        double BookValue() const;           // sum of cached prices over all positions
+};
+
+} // namespace Engine
+} // namespace AidanRicher
+
+#endif // IncrementalPricer_HPP
@@ -0,0 +1,162 @@
+#include "JobExecutor.hpp"
+#include "ArrayException.hpp"
+
+using namespace AidanRicher::Containers;
+
+namespace AidanRicher {
+namespace Engine {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// CancellationToken                                                                                               //
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// default constructor
+CancellationToken::CancellationToken() : m_flag(std::make_shared<std::atomic<bool>>(false)) { }
+
+// copy constructor
+CancellationToken::CancellationToken(const CancellationToken& other) : m_flag(other.m_flag) { }
+
+// destructor
+CancellationToken::~CancellationToken() = default;
+
+// assignment operator
+CancellationToken& CancellationToken::operator = (const CancellationToken& other)
+{
+    if (this == &other) { return *this; }
+
+    m_flag = other.m_flag;
+
+    return *this;
+}
+
+void CancellationToken::Cancel()
+{
+    m_flag->store(true, std::memory_order_release);
+}
+
+bool CancellationToken::IsCancelled() const
+{
+    return m_flag->load(std::memory_order_acquire);
+}
+
+void CancellationToken::ThrowIfCancelled() const
+{
+    if (IsCancelled())
+    {
+        throw JobCancelledException();
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// JobExecutor                                                                                                     //
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// parameter constructor
+JobExecutor::JobExecutor(const size_t threads) : m_workers(), m_lock(), m_ready(), m_stopping(false)
+{
+    size_t count = (threads > 0) ? threads : std::thread::hardware_concurrency();
+    if (count == 0) { count = 1; }
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        m_workers.emplace_back(&JobExecutor::Work, this);
+    }
+}
+
+// destructor
+JobExecutor::~JobExecutor()
+{
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        m_stopping = true;
+    }
+    m_ready.notify_all();
+
+    for (size_t i = 0; i < m_workers.size(); ++i)
+    {
+        m_workers[i].join();
+    }
+}
+
+void JobExecutor::Work()
+{ // most urgent class first, oldest task first within a class
+    for (;;)
+    {
+        std::function<void()> task;
+
+        {
+            std::unique_lock<std::mutex> guard(m_lock);
+            m_ready.wait(guard, [this]() {
+                if (m_stopping) { return true; }
+                for (int p = 0; p < PRIORITY_CLASSES; ++p) { if (!m_queues[p].empty()) { return true; } }
+                return false;
+            });
+
+            for (int p = 0; p < PRIORITY_CLASSES && !task; ++p)
+            {
+                if (!m_queues[p].empty())
+                {
+                    task = std::move(m_queues[p].front());
+                    m_queues[p].pop_front();
+                }
+            }
+
+            if (!task) { return; }      // stopping and drained
+        }
+
+        try
+        {
+            task();
+        }
+        catch (...)
+        { // Submit() tasks report through their future, a Post() task has nowhere to report to
+        }
+    }
+}
+
+void JobExecutor::Post(const JobPriority priority, std::function<void()> task)
+{
+    if (priority < PRIORITY_TICK || priority >= PRIORITY_CLASSES)
+    {
+        throw OutOfBoundsException(static_cast<int>(priority));
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        if (m_stopping)
+        {
+            throw std::logic_error("Job submitted to an executor that is shutting down.");
+        }
+        m_queues[priority].push_back(std::move(task));
+    }
+    m_ready.notify_one();
+}
+
+// getter functions
+size_t JobExecutor::Threads() const
+{
+    return m_workers.size();
+}
+
+size_t JobExecutor::Pending()
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    size_t total = 0;
+    for (int p = 0; p < PRIORITY_CLASSES; ++p) { total += m_queues[p].size(); }
+    return total;
+}
+
+size_t JobExecutor::Pending(const JobPriority priority)
+{
+    if (priority < PRIORITY_TICK || priority >= PRIORITY_CLASSES)
+    {
+        throw OutOfBoundsException(static_cast<int>(priority));
+    }
+
+    std::lock_guard<std::mutex> guard(m_lock);
+    return m_queues[priority].size();
+}
+
+} // namespace Engine
+} // namespace AidanRicher
@@ -0,0 +1,108 @@
+#ifndef JobExecutor_HPP
+#define JobExecutor_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace AidanRicher {
+namespace Engine {
+
+// priority classes, a worker always takes the oldest task of the most urgent non-empty class
+// long jobs are submitted as many small tasks, so a tick task waits for at most one task per worker
+enum JobPriority {
+    PRIORITY_TICK = 0,          // latency sensitive repricing on market data
+    PRIORITY_INTERACTIVE,       // user facing requests
+    PRIORITY_BATCH,             // reports, grids and long MC runs
+    PRIORITY_CLASSES
+};
+
+// thrown into the future of a job that was cancelled before it finished
+class JobCancelledException : public std::runtime_error {
+    public:
+        JobCancelledException() : std::runtime_error("Pricing job cancelled.") { }
+};
+
+// shared cancellation flag, copies refer to the same flag
+// jobs poll it between units of work, so cancellation is cooperative and takes effect at the next check
+class CancellationToken {
+    private:
+        std::shared_ptr<std::atomic<bool>> m_flag;
+
+    public:
+        // default constructor, a fresh token that is not cancelled
+        CancellationToken();
+
+        // copy constructor, shares the flag
+        CancellationToken(const CancellationToken& other);
+
+        // destructor
+        ~CancellationToken();
+
+        // assignment operator
+        CancellationToken& operator = (const CancellationToken& other);
+
+        void Cancel();
+        bool IsCancelled() const;
+        void ThrowIfCancelled() const;      // throws JobCancelledException once cancelled
+};
+
+// progress of a job, units done out of total, called from the worker threads (one call at a time per job)
+typedef std::function<void(size_t done, size_t total)> ProgressCallback;
+
+// fixed pool of worker threads fed from one queue per priority class
+class JobExecutor {
+    private:
+        std::vector<std::thread> m_workers;
+        std::deque<std::function<void()>> m_queues[PRIORITY_CLASSES];
+        std::mutex m_lock;
+        std::condition_variable m_ready;
+        bool m_stopping;
+
+        void Work();        // worker loop
+
+    public:
+        // parameter constructor, threads = 0 uses the hardware concurrency
+        explicit JobExecutor(const size_t threads = 0);
+
+        // non-copyable, owns the threads
+        JobExecutor(const JobExecutor& other) = delete;
+        JobExecutor& operator = (const JobExecutor& other) = delete;
+
+        // destructor, runs every queued task, then joins the workers
+        ~JobExecutor();
+
+        // queue a task without a result, exceptions escaping it are swallowed
+        void Post(const JobPriority priority, std::function<void()> task);
+
+        // queue a callable, its result or exception arrives through the future
+        template <typename F>
+        auto Submit(const JobPriority priority, F fn) -> std::future<decltype(fn())>
+        {
+            typedef decltype(fn()) Result;
+            std::shared_ptr<std::packaged_task<Result()>> task = std::make_shared<std::packaged_task<Result()>>(std::move(fn));
+            std::future<Result> result = task->get_future();
+
+            Post(priority, [task]() { (*task)(); });
+
+            return result;
+        }
+
+        // getter functions
+        size_t Threads() const;
+        size_t Pending();                   // queued tasks not yet started, all classes
+        size_t Pending(const JobPriority priority);
+};
+
+} // namespace Engine
+} // namespace AidanRicher
+
+#endif // JobExecutor_HPP
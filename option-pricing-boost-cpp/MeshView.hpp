@@ -0,0 +1,198 @@
+#ifndef MeshView_HPP
+#define MeshView_HPP
+
+#include "ArrayException.hpp"
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+namespace AidanRicher {
+namespace Engine {
+
+// lazy, allocation-free meshes, point i is computed from i on demand so there is no accumulated drift
+// every view is a few doubles, cheap to copy, random access and usable in range-for loops and std algorithms
+// ToVector() materializes the points when a container is really needed
+
+// random access iterator over any mesh view
+template <typename Mesh>
+class MeshIterator {
+    private:
+        const Mesh* m_mesh;
+        std::ptrdiff_t m_index;
+
+    public:
+        typedef std::random_access_iterator_tag iterator_category;
+        typedef typename Mesh::value_type value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const value_type* pointer;
+        typedef value_type reference;           // points are computed, returned by value
+
+        MeshIterator() : m_mesh(nullptr), m_index(0) { }
+        MeshIterator(const Mesh* mesh, const std::ptrdiff_t index) : m_mesh(mesh), m_index(index) { }
+
+        value_type operator * () const { return (*m_mesh)[static_cast<size_t>(m_index)]; }
+        value_type operator [] (const difference_type n) const { return (*m_mesh)[static_cast<size_t>(m_index + n)]; }
+
+        MeshIterator& operator ++ () { ++m_index; return *this; }
+        MeshIterator& operator -- () { --m_index; return *this; }
+        MeshIterator operator ++ (int) { MeshIterator tmp(*this); ++m_index; return tmp; }
+        MeshIterator operator -- (int) { MeshIterator tmp(*this); --m_index; return tmp; }
+        MeshIterator& operator += (const difference_type n) { m_index += n; return *this; }
+        MeshIterator& operator -= (const difference_type n) { m_index -= n; return *this; }
+        MeshIterator operator + (const difference_type n) const { return MeshIterator(m_mesh, m_index + n); }
+        MeshIterator operator - (const difference_type n) const { return MeshIterator(m_mesh, m_index - n); }
+        friend MeshIterator operator + (const difference_type n, const MeshIterator& it) { return it + n; }
+        difference_type operator - (const MeshIterator& other) const { return m_index - other.m_index; }
+
+        bool operator == (const MeshIterator& other) const { return m_index == other.m_index; }
+        bool operator != (const MeshIterator& other) const { return m_index != other.m_index; }
+        bool operator < (const MeshIterator& other) const { return m_index < other.m_index; }
+        bool operator > (const MeshIterator& other) const { return m_index > other.m_index; }
+        bool operator <= (const MeshIterator& other) const { return m_index <= other.m_index; }
+        bool operator >= (const MeshIterator& other) const { return m_index >= other.m_index; }
+};
+
+// shared container interface, Mesh supplies operator [] and size()
+template <typename Mesh, typename T>
+class MeshBase {
+    public:
+        typedef T value_type;
+        typedef MeshIterator<Mesh> const_iterator;
+
+        const_iterator begin() const { return const_iterator(static_cast<const Mesh*>(this), 0); }
+        const_iterator end() const { return const_iterator(static_cast<const Mesh*>(this), static_cast<std::ptrdiff_t>(static_cast<const Mesh*>(this)->size())); }
+
+        T front() const { return (*static_cast<const Mesh*>(this))[0]; }
+        T back() const { return (*static_cast<const Mesh*>(this))[static_cast<const Mesh*>(this)->size() - 1]; }
+
+        std::vector<T> ToVector() const
+        {
+            const Mesh& mesh = *static_cast<const Mesh*>(this);
+            std::vector<T> points(mesh.size());
+
+            for (size_t i = 0; i < points.size(); ++i)
+            {
+                points[i] = mesh[i];
+            }
+
+            return points;
+        }
+};
+
+// start + i * step, i = 0 .. size - 1, the same points as MeshArray
+template <typename T>
+class UniformMesh : public MeshBase<UniformMesh<T>, T> {
+    private:
+        T m_start;
+        T m_step;
+        size_t m_size;
+        T m_end;            // last point, returned exactly when built from a range
+
+    public:
+        UniformMesh() : m_start(0), m_step(0), m_size(0), m_end(0) { }
+        UniformMesh(const T start, const T step, const size_t size) : m_start(start), m_step(step), m_size(size), m_end(start + static_cast<T>(size > 0 ? size - 1 : 0) * step) { }
+
+        // size points from lo to hi inclusive, both ends exact
+        static UniformMesh Between(const T lo, const T hi, const size_t size)
+        {
+            UniformMesh mesh(lo, size > 1 ? (hi - lo) / static_cast<T>(size - 1) : T(0), size);
+            mesh.m_end = (size > 1) ? hi : lo;
+            return mesh;
+        }
+
+        T operator [] (const size_t i) const { return (i + 1 == m_size) ? m_end : m_start + static_cast<T>(i) * m_step; }
+        size_t size() const { return m_size; }
+        T Step() const { return m_step; }
+};
+
+// lo * (hi / lo)^(i / (size - 1)), evenly spaced in log, for spot grids of multiplicative processes
+template <typename T>
+class GeometricMesh : public MeshBase<GeometricMesh<T>, T> {
+    private:
+        T m_lo;
+        T m_hi;
+        T m_logStep;
+        size_t m_size;
+
+    public:
+        GeometricMesh() : m_lo(1), m_hi(1), m_logStep(0), m_size(0) { }
+        GeometricMesh(const T lo, const T hi, const size_t size) : m_lo(lo), m_hi(hi), m_logStep(0), m_size(size)
+        {
+            if (!(lo > T(0)) || !(hi > T(0)))
+            {
+                throw AidanRicher::Containers::UnexpectedInputException();
+            }
+            if (size > 1) { m_logStep = std::log(hi / lo) / static_cast<T>(size - 1); }
+        }
+
+        T operator [] (const size_t i) const { return (i + 1 == m_size && i > 0) ? m_hi : m_lo * std::exp(static_cast<T>(i) * m_logStep); }
+        size_t size() const { return m_size; }
+};
+
+// Chebyshev-Lobatto points on [lo, hi] in increasing order, clustered at both ends
+template <typename T>
+class ChebyshevMesh : public MeshBase<ChebyshevMesh<T>, T> {
+    private:
+        T m_mid;
+        T m_half;
+        T m_angle;          // pi / (size - 1)
+        size_t m_size;
+
+    public:
+        ChebyshevMesh() : m_mid(0), m_half(0), m_angle(0), m_size(0) { }
+        ChebyshevMesh(const T lo, const T hi, const size_t size) : m_mid(T(0.5) * (lo + hi)), m_half(T(0.5) * (hi - lo)), m_angle(0), m_size(size)
+        {
+            if (size > 1) { m_angle = T(3.14159265358979323846) / static_cast<T>(size - 1); }
+        }
+
+        T operator [] (const size_t i) const
+        {
+            if (i == 0) { return m_mid - m_half; }
+            if (i + 1 == m_size) { return m_mid + m_half; }
+            return m_mid - m_half * std::cos(static_cast<T>(i) * m_angle);
+        }
+        size_t size() const { return m_size; }
+};
+
+// points on [lo, hi] concentrated around center (a strike or barrier), sinh stretching
+// x(u) = center + alpha * sinh(c1 + u * (c2 - c1)), smaller alpha packs more points near the center
+template <typename T>
+class ConcentratedMesh : public MeshBase<ConcentratedMesh<T>, T> {
+    private:
+        T m_lo;
+        T m_hi;
+        T m_center;
+        T m_alpha;
+        T m_c1;
+        T m_c2;
+        size_t m_size;
+
+    public:
+        ConcentratedMesh() : m_lo(0), m_hi(0), m_center(0), m_alpha(1), m_c1(0), m_c2(0), m_size(0) { }
+        ConcentratedMesh(const T lo, const T hi, const size_t size, const T center, const T alpha)
+            : m_lo(lo), m_hi(hi), m_center(center), m_alpha(alpha), m_c1(0), m_c2(0), m_size(size)
+        {
+            if (!(alpha > T(0)))
+            {
+                throw AidanRicher::Containers::NegativeStepSizeException();
+            }
+            m_c1 = std::asinh((lo - center) / alpha);
+            m_c2 = std::asinh((hi - center) / alpha);
+        }
+
+        T operator [] (const size_t i) const
+        {
+            if (i == 0) { return m_lo; }
+            if (i + 1 == m_size) { return m_hi; }
+
+            T u = static_cast<T>(i) / static_cast<T>(m_size - 1);
+            return m_center + m_alpha * std::sinh(m_c1 + u * (m_c2 - m_c1));
+        }
+        size_t size() const { return m_size; }
+};
+
+} // namespace Engine
+} // namespace AidanRicher
+
+#endif // MeshView_HPP
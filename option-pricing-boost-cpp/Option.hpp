@@ -1,6 +1,9 @@
 #ifndef Option_HPP
 #define Option_HPP
 
+#include "OptionData.hpp"
+#include <complex>
+#include <stdexcept>
 #include <string>
 
 namespace AidanRicher {
@@ -15,9 +18,22 @@ class Option {
         virtual double Gamma(double U) const = 0;
         virtual std::string Type() const = 0;
         virtual Option* Clone() const = 0;
+
+        // contract params, and a copy of the same option type on different params (used for parameter bumps)
+        virtual const OptionData& GetData() const = 0;
+        virtual Option* Clone(const OptionData& data) const = 0;
+
+        // complex-step support, price at a complex spot U + ih with a tiny imaginary part
+        // options without an analytic continuation of Price() keep the default and fall back to finite differences
+        virtual bool HasComplexPrice() const { return false; }
+        virtual std::complex<double> ComplexPrice(const std::complex<double>& U) const
+        {
+            (void)U;
+            throw std::logic_error("Complex-step pricing is not supported for " + Type());
+        }
 };
 
 } // namespace Engine
 } // namespace AidanRicher
 
-#endif // Option_HPP
\ No newline at end of file
+#endif // Option_HPP
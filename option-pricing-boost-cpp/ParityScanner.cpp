@@ -0,0 +1,166 @@
+#include "ParityScanner.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace AidanRicher {
+namespace Engine {
+
+namespace {
+
+inline bool SameKey(const ParityQuote& quote, const double strike, const double expiry)
+{ // exact match as in CheckPutCallParity
+    return quote.strike == strike && quote.expiry == expiry;
+}
+
+} // namespace
+
+size_t ParityScanner::KeyHash::operator () (const std::pair<double, double>& key) const
+{ // mix the bit patterns of strike and expiry, keys match exactly as in CheckPutCallParity
+    const double strike = key.first + 0.0;      // -0.0 becomes 0.0, equal keys must hash alike
+    const double expiry = key.second + 0.0;
+
+    uint64_t k, t;
+    std::memcpy(&k, &strike, sizeof(k));
+    std::memcpy(&t, &expiry, sizeof(t));
+
+    uint64_t h = k * 0x9E3779B97F4A7C15ULL ^ (t + 0x7F4A7C159E3779B9ULL + (k << 6) + (k >> 2));
+    return static_cast<size_t>(h ^ (h >> 32));
+}
+
+// default constructor
+ParityScanner::ParityScanner() : m_tolerance(1e-3), m_pairs(0) { }
+
+// parameter constructor
+ParityScanner::ParityScanner(const double tolerance) : m_tolerance(tolerance), m_pairs(0) { }
+
+// copy constructor, scratch buffers are not shared
+ParityScanner::ParityScanner(const ParityScanner& other) : m_tolerance(other.m_tolerance), m_pairs(other.m_pairs) { }
+
+// destructor
+ParityScanner::~ParityScanner() = default;
+
+// assignment operator
+ParityScanner& ParityScanner::operator = (const ParityScanner& other)
+{
+    if (this == &other) { return *this; }
+
+    m_tolerance = other.m_tolerance;
+    m_pairs = other.m_pairs;
+
+    return *this;
+}
+
+size_t ParityScanner::Scan(const OptionChain& chain, std::vector<ParityViolation>& out, const size_t chainIndex)
+{
+    // build side, index the puts by (strike, expiry) in a linear probing table at most half full
+    // the table only grows, a smaller chain clears and uses a prefix of it
+    size_t capacity = 16;
+    while (capacity < 2 * chain.puts.size()) { capacity <<= 1; }
+    if (m_puts.size() < capacity) { m_puts.resize(capacity); }
+
+    const size_t mask = capacity - 1;
+    const KeyHash hash = KeyHash();
+    std::fill(m_puts.begin(), m_puts.begin() + capacity, 0);
+
+    for (size_t i = 0; i < chain.puts.size(); ++i)
+    {
+        const ParityQuote& p = chain.puts[i];
+        size_t slot = hash(std::make_pair(p.strike, p.expiry)) & mask;
+
+        while (m_puts[slot] != 0 && !SameKey(chain.puts[m_puts[slot] - 1], p.strike, p.expiry))
+        {
+            slot = (slot + 1) & mask;
+        }
+
+        m_puts[slot] = i + 1;       // a duplicate put overwrites, the last quote wins
+    }
+
+    // probe side, gather the matched pairs into columns
+    m_strikes.clear();
+    m_expiries.clear();
+    m_calls.clear();
+    m_putPrices.clear();
+
+    for (size_t i = 0; i < chain.calls.size(); ++i)
+    {
+        const ParityQuote& c = chain.calls[i];
+        size_t slot = hash(std::make_pair(c.strike, c.expiry)) & mask;
+
+        while (m_puts[slot] != 0 && !SameKey(chain.puts[m_puts[slot] - 1], c.strike, c.expiry))
+        {
+            slot = (slot + 1) & mask;
+        }
+
+        if (m_puts[slot] == 0) { continue; }
+
+        m_strikes.push_back(c.strike);
+        m_expiries.push_back(c.expiry);
+        m_calls.push_back(c.price);
+        m_putPrices.push_back(chain.puts[m_puts[slot] - 1].price);
+    }
+
+    const size_t n = m_strikes.size();
+    m_residuals.resize(n);
+    m_pairs += n;
+
+    // residual pass over the columns, no branches so the compiler can vectorize it
+    const double U = chain.spot;
+    const double r = chain.rate;
+    const double carry = chain.carry - chain.rate;
+    const double* K = m_strikes.data();
+    const double* T = m_expiries.data();
+    const double* C = m_calls.data();
+    const double* P = m_putPrices.data();
+    double* residual = m_residuals.data();
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        residual[i] = C[i] - P[i] - (U * std::exp(carry * T[i]) - K[i] * std::exp(-r * T[i]));
+    }
+
+    // compaction pass, only the violations leave the scanner
+    size_t found = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        if (!(std::abs(residual[i]) <= m_tolerance))
+        { // NaN quotes are reported as well
+            ParityViolation v = { chainIndex, K[i], T[i], C[i], P[i], residual[i] };
+            out.push_back(v);
+            ++found;
+        }
+    }
+
+    return found;
+}
+
+std::vector<ParityViolation> ParityScanner::Scan(const std::vector<OptionChain>& chains)
+{
+    std::vector<ParityViolation> violations;
+
+    for (size_t i = 0; i < chains.size(); ++i)
+    {
+        Scan(chains[i], violations, i);
+    }
+
+    return violations;
+}
+
+// getter and setter functions
+double ParityScanner::Tolerance() const
+{
+    return m_tolerance;
+}
+
+void ParityScanner::Tolerance(const double tolerance)
+{
+    m_tolerance = tolerance;
+}
+
+size_t ParityScanner::PairsChecked() const
+{
+    return m_pairs;
+}
+
+} // namespace Engine
+} // namespace AidanRicher
@@ -0,0 +1,87 @@
+#ifndef ParityScanner_HPP
+#define ParityScanner_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace AidanRicher {
+namespace Engine {
+
+// one market quote of a European option
+struct ParityQuote {
+    double strike;
+    double expiry;          // time to expiry T
+    double price;           // quoted premium
+};
+
+// quotes on one underlying, calls and puts in any order, paired on (strike, expiry)
+struct OptionChain {
+    double spot;
+    double rate;            // interest rate r
+    double carry;           // cost of carry b
+    std::vector<ParityQuote> calls;
+    std::vector<ParityQuote> puts;
+};
+
+// a call/put pair whose parity residual exceeds the tolerance
+struct ParityViolation {
+    size_t chain;           // index of the chain in the scanned batch
+    double strike;
+    double expiry;
+    double call;            // quoted call premium
+    double put;             // quoted put premium
+    double residual;        // C - P - (U * exp((b - r) * T) - K * exp(-r * T))
+};
+
+class ParityScanner {
+    private:
+        struct KeyHash {
+            size_t operator () (const std::pair<double, double>& key) const;
+        };
+
+        double m_tolerance;         // absolute residual allowed, in price units
+        size_t m_pairs;             // pairs checked since construction
+
+        // scratch reused across chains so a scan does not allocate once warm
+        std::vector<size_t> m_puts;         // open addressing table on (strike, expiry), put index + 1, 0 marks an empty slot
+        std::vector<double> m_strikes;
+        std::vector<double> m_expiries;
+        std::vector<double> m_calls;
+        std::vector<double> m_putPrices;
+        std::vector<double> m_residuals;
+
+    public:
+        // default constructor, tolerance 1e-3 as in CheckPutCallParity
+        ParityScanner();
+
+        // parameter constructor
+        ParityScanner(const double tolerance);
+
+        // copy constructor
+        ParityScanner(const ParityScanner& other);
+
+        // destructor
+        ~ParityScanner();
+
+        // assignment operator
+        ParityScanner& operator = (const ParityScanner& other);
+
+        // scan one chain, violations are appended to out tagged with chainIndex, returns the number appended
+        // calls without a put at the same (strike, expiry) are skipped, duplicate puts keep the last quote
+        size_t Scan(const OptionChain& chain, std::vector<ParityViolation>& out, const size_t chainIndex = 0);
+
+        // scan a batch of chains, the violations come back in chain order
+        std::vector<ParityViolation> Scan(const std::vector<OptionChain>& chains);
+
+        // getter and setter functions
+        double Tolerance() const;
+        void Tolerance(const double tolerance);
+        size_t PairsChecked() const;
+};
+
+} // namespace Engine
+} // namespace AidanRicher
+
+#endif // ParityScanner_HPP
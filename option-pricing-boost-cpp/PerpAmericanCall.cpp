@@ -1,6 +1,9 @@
 #include "PerpAmericanCall.hpp"
 #include <cmath>
+#include <complex>
 #include <iostream>
+#include <limits>
+#include <stdexcept>
 
 namespace AidanRicher {
 namespace Engine {
@@ -33,43 +36,58 @@ const OptionData& PerpAmericanCall::GetData() const
     return m_data;
 }
 
+double PerpAmericanCall::Exponent() const
+{ // y1 from the volatility, rate and carry
+    double sigma_squared = m_data.Sig() * m_data.Sig();
+    return 0.5 - (m_data.B() / sigma_squared) + std::sqrt(std::pow((m_data.B() / sigma_squared - 0.5), 2.0) + (2.0 * m_data.R() / sigma_squared));
+}
+
+double PerpAmericanCall::Value(const double y1, const double U) const
+{ // price for a precomputed exponent
+    double call_rhs = ((y1 - 1.0) / y1) * (U / m_data.K());
+    return (m_data.K() / (y1 - 1.0)) * std::pow(call_rhs, y1);
+}
+
 double PerpAmericanCall::Price(const double U) const
 { // return the price of the perpetual american call option
     if (U <= 0.0)
     {
         throw std::invalid_argument("Underlying spot price U must be positive.");
     }
-    
-    double sigma_squared = m_data.Sig() * m_data.Sig();
-    double y1 = 0.5 - (m_data.B() / sigma_squared) + std::sqrt(std::pow((m_data.B() / sigma_squared - 0.5), 2.0) + (2.0 * m_data.R() / sigma_squared));
-    double call_rhs = ((y1 - 1.0) / y1) * (U / m_data.K());
 
     // return call price
-    return (m_data.K() / (y1 - 1.0)) * std::pow(call_rhs, y1);
+    return Value(Exponent(), U);
 }
 
 double PerpAmericanCall::DividedDifferenceDelta(const double U, const double h) const 
 { // delta approximation using the divided difference method
-    if (abs(Price(U + h) - Price(U - h)) <= std::pow(2, -53))
+    double up = Price(U + h);
+    double down = Price(U - h);
+
+    if (std::abs(up - down) <= std::pow(2, -53))
     {
         std::cout << "H is too small for accurate computation." << std::endl;
         return 0;
     }
 
     // return approximated delta
-    return (Price(U + h) - Price(U - h)) / (2.0 * h);
+    return (up - down) / (2.0 * h);
 }
 
 double PerpAmericanCall::DividedDifferenceGamma(const double U, const double h) const
 { // gamma approximation using the divided difference method
-    if (abs(Price(U + h) - 2.0 * Price(U) + Price(U - h)) <= std::pow(2, -53))
+    double up = Price(U + h);
+    double mid = Price(U);
+    double down = Price(U - h);
+
+    if (std::abs(up - 2.0 * mid + down) <= std::pow(2, -53))
     {
         std::cout << "H is too small for accurate computation." << std::endl;
         return 0;
     }
 
     // return approximated gamma
-    return (Price(U + h) - 2.0 * Price(U) + Price(U - h)) / (h * h);
+    return (up - 2.0 * mid + down) / (h * h);
 }
 
 std::ostream& operator << (std::ostream& os, const PerpAmericanCall& source)
@@ -86,19 +104,44 @@ std::ostream& operator << (std::ostream& os, const PerpAmericanCall& source)
     return os;
 }
 
-// delta and gamma were not implimented in this class, so we will just return 0.0 for now
+// the price is a power law in U, V = A * U^y1, so the greeks follow directly from the price
 double PerpAmericanCall::Delta(const double U) const 
-{   
-    // parameter U isn't being used
-    (void)U;
-    return 0.0; 
+{ // return the delta of the perpetual american call option, dV/dU = y1 * V / U
+    if (U <= 0.0)
+    {
+        throw std::invalid_argument("Underlying spot price U must be positive.");
+    }
+
+    double y1 = Exponent();
+    return y1 * Value(y1, U) / U;
 }
 
 double PerpAmericanCall::Gamma(const double U) const 
-{   
-    // parameter U isn't being used
-    (void)U;
-    return 0.0; 
+{ // return the gamma of the perpetual american call option, d2V/dU2 = y1 * (y1 - 1) * V / U^2
+    if (U <= 0.0)
+    {
+        throw std::invalid_argument("Underlying spot price U must be positive.");
+    }
+
+    double y1 = Exponent();
+    return y1 * (y1 - 1.0) * Value(y1, U) / (U * U);
+}
+
+void PerpAmericanCall::PriceBatch(const double* U, const size_t n, double* prices, double* deltas, double* gammas) const
+{ // one exponent and one coefficient per contract, then a single pow per spot
+    const double y1 = Exponent();
+    const double A = (m_data.K() / (y1 - 1.0)) * std::pow((y1 - 1.0) / (y1 * m_data.K()), y1);
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        const double S = U[i];
+        const double V = (S > 0.0) ? A * std::pow(S, y1) : nan;
+
+        if (prices) { prices[i] = V; }
+        if (deltas) { deltas[i] = y1 * V / S; }
+        if (gammas) { gammas[i] = y1 * (y1 - 1.0) * V / (S * S); }
+    }
 }
 
 std::string PerpAmericanCall::Type() const 
@@ -111,5 +154,27 @@ Option* PerpAmericanCall::Clone() const
     return new PerpAmericanCall(*this);
 }
 
+Option* PerpAmericanCall::Clone(const OptionData& data) const
+{
+    return new PerpAmericanCall(data);
+}
+
+bool PerpAmericanCall::HasComplexPrice() const
+{
+    return true;
+}
+
+std::complex<double> PerpAmericanCall::ComplexPrice(const std::complex<double>& U) const
+{ // call price at a complex spot, the power law is analytic for Re(U) > 0
+    if (U.real() <= 0.0)
+    {
+        throw std::invalid_argument("Underlying spot price U must be postive.");
+    }
+
+    double y1 = Exponent();
+    std::complex<double> call_rhs = ((y1 - 1.0) / y1) * (U / m_data.K());
+    return (m_data.K() / (y1 - 1.0)) * std::pow(call_rhs, y1);
+}
+
 } // namespace Engine
 } // namespace AidanRicher
\ No newline at end of file
@@ -3,6 +3,7 @@
 
 #include "Option.hpp"
 #include "OptionData.hpp"
+#include <complex>
 #include <string>
 #include <iostream>
 
@@ -13,6 +14,9 @@ class PerpAmericanCall : public Option {
     private: 
         OptionData m_data;      // private member to hold option data
 
+        double Exponent() const;                                    // y1, the price is a power law V(U) = A * U^y1
+        double Value(const double y1, const double U) const;        // price for a precomputed exponent
+
     public:
         PerpAmericanCall();                                 // default constructor
         PerpAmericanCall(const OptionData& data);           // parameter constructor
@@ -30,6 +34,10 @@ class PerpAmericanCall : public Option {
         double DividedDifferenceDelta(const double U, const double h) const;    // delta approximation using divided difference method
         double DividedDifferenceGamma(const double U, const double h) const;    // gamma approximation using divided difference method
 
+        // price, delta and gamma over an array of spots with y1 computed once, any output pointer may be nullptr
+        // spots that are not positive give NaN instead of throwing
+        void PriceBatch(const double* U, const size_t n, double* prices, double* deltas, double* gammas) const;
+
         // ostream << operator
         friend std::ostream& operator << (std::ostream& os, const PerpAmericanCall& source);
 
@@ -38,6 +46,9 @@ class PerpAmericanCall : public Option {
         double Gamma(const double U) const override;
         virtual std::string Type() const override;
         virtual Option* Clone() const override;
+        virtual Option* Clone(const OptionData& data) const override;
+        virtual bool HasComplexPrice() const override;
+        virtual std::complex<double> ComplexPrice(const std::complex<double>& U) const override;     // price at a complex spot, for complex-step greeks
 };
 
 } // namespace Engine
@@ -1,6 +1,9 @@
 #include "PerpAmericanPut.hpp"
 #include <cmath>
+#include <complex>
 #include <iostream>
+#include <limits>
+#include <stdexcept>
 
 namespace AidanRicher {
 namespace Engine {
@@ -33,43 +36,58 @@ const OptionData& PerpAmericanPut::GetData() const
     return m_data;
 }
 
-double PerpAmericanPut::Price(const double U) const 
+double PerpAmericanPut::Exponent() const
+{ // y2 from the volatility, rate and carry
+    double sigma_squared = m_data.Sig() * m_data.Sig();
+    return 0.5 - (m_data.B() / sigma_squared) - std::sqrt(std::pow((m_data.B() / sigma_squared - 0.5), 2.0) + (2.0 * m_data.R() / sigma_squared));
+}
+
+double PerpAmericanPut::Value(const double y2, const double U) const
+{ // price for a precomputed exponent
+    double put_rhs = ((y2 - 1.0) / y2) * (U / m_data.K());
+    return (m_data.K() / (1.0 - y2)) * std::pow(put_rhs, y2);
+}
+
+double PerpAmericanPut::Price(const double U) const
 { // return the price of the perpetual american put option
     if (U <= 0.0)
     {
         throw std::invalid_argument("Underlying spot price U must be postive.");
     }
 
-    double sigma_squared = m_data.Sig() * m_data.Sig();
-    double y2 = 0.5 - (m_data.B() / sigma_squared) - std::sqrt(std::pow((m_data.B() / sigma_squared - 0.5), 2.0) + (2.0 * m_data.R() / sigma_squared));
-    double put_rhs = ((y2 - 1.0) / y2) * (U / m_data.K());
-
     // return put price
-    return (m_data.K() / (1.0 - y2)) * std::pow(put_rhs, y2);
+    return Value(Exponent(), U);
 }
 
 double PerpAmericanPut::DividedDifferenceDelta(const double U, const double h) const
 { // delta approximation using the divided difference method
-    if (abs(Price(U + h) - Price(U - h)) <= std::pow(2, -53))
+    double up = Price(U + h);
+    double down = Price(U - h);
+
+    if (std::abs(up - down) <= std::pow(2, -53))
     {
         std::cout << "H is too small for accurate computation." << std::endl;
         return 0;
     }
 
     // return approximated delta
-    return (Price(U + h) - Price(U - h)) / (2.0 * h);
+    return (up - down) / (2.0 * h);
 }
 
 double PerpAmericanPut::DividedDifferenceGamma(const double U, const double h) const
 { // gamma approximation using the divided difference method
-    if (abs(Price(U + h) - 2.0 * Price(U) + Price(U - h)) <= std::pow(2, -53))
+    double up = Price(U + h);
+    double mid = Price(U);
+    double down = Price(U - h);
+
+    if (std::abs(up - 2.0 * mid + down) <= std::pow(2, -53))
     {
         std::cout << "H is too small for accurate computation." << std::endl;
         return 0;
     }
 
     // return approximated gamma
-    return (Price(U + h) - 2.0 * Price(U) + Price(U - h)) / (h * h);
+    return (up - 2.0 * mid + down) / (h * h);
 }
 
 std::ostream& operator << (std::ostream& os, const PerpAmericanPut& source)
@@ -86,19 +104,44 @@ std::ostream& operator << (std::ostream& os, const PerpAmericanPut& source)
     return os;
 }
 
-// delta and gamma are not implemented for this class, so we will just return 0.0 for now
+// the price is a power law in U, V = A * U^y2, so the greeks follow directly from the price
 double PerpAmericanPut::Delta(const double U) const 
-{   
-    // parameter U isn't being used
-    (void)U; 
-    return 0.0; 
+{ // return the delta of the perpetual american put option, dV/dU = y2 * V / U
+    if (U <= 0.0)
+    {
+        throw std::invalid_argument("Underlying spot price U must be postive.");
+    }
+
+    double y2 = Exponent();
+    return y2 * Value(y2, U) / U;
 }
 
 double PerpAmericanPut::Gamma(const double U) const 
-{   
-    // parameter U isn't being used
-    (void)U;
-    return 0.0; 
+{ // return the gamma of the perpetual american put option, d2V/dU2 = y2 * (y2 - 1) * V / U^2
+    if (U <= 0.0)
+    {
+        throw std::invalid_argument("Underlying spot price U must be postive.");
+    }
+
+    double y2 = Exponent();
+    return y2 * (y2 - 1.0) * Value(y2, U) / (U * U);
+}
+
+void PerpAmericanPut::PriceBatch(const double* U, const size_t n, double* prices, double* deltas, double* gammas) const
+{ // one exponent and one coefficient per contract, then a single pow per spot
+    const double y2 = Exponent();
+    const double A = (m_data.K() / (1.0 - y2)) * std::pow((y2 - 1.0) / (y2 * m_data.K()), y2);
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        const double S = U[i];
+        const double V = (S > 0.0) ? A * std::pow(S, y2) : nan;
+
+        if (prices) { prices[i] = V; }
+        if (deltas) { deltas[i] = y2 * V / S; }
+        if (gammas) { gammas[i] = y2 * (y2 - 1.0) * V / (S * S); }
+    }
 }
 
 std::string PerpAmericanPut::Type() const 
@@ -111,5 +154,27 @@ Option* PerpAmericanPut::Clone() const
     return new PerpAmericanPut(*this);
 }
 
+Option* PerpAmericanPut::Clone(const OptionData& data) const
+{
+    return new PerpAmericanPut(data);
+}
+
+bool PerpAmericanPut::HasComplexPrice() const
+{
+    return true;
+}
+
+std::complex<double> PerpAmericanPut::ComplexPrice(const std::complex<double>& U) const
+{ // put price at a complex spot, the power law is analytic for Re(U) > 0
+    if (U.real() <= 0.0)
+    {
+        throw std::invalid_argument("Underlying spot price U must be postive.");
+    }
+
+    double y2 = Exponent();
+    std::complex<double> put_rhs = ((y2 - 1.0) / y2) * (U / m_data.K());
+    return (m_data.K() / (1.0 - y2)) * std::pow(put_rhs, y2);
+}
+
 } // namespace Engine 
 } // namespace AidanRicher
\ No newline at end of file
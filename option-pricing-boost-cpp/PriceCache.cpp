@@ -0,0 +1,224 @@
+#include "PriceCache.hpp"
+#include "ArrayException.hpp"
+#include <cmath>
+#include <cstring>
+
+using namespace AidanRicher::Containers;
+
+namespace AidanRicher {
+namespace Engine {
+
+namespace {
+
+// splitmix64 finalizer, spreads nearby keys over all bits
+inline uint64_t Mix(uint64_t x)
+{
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+// FNV-1a over the type name
+uint64_t TypeHash(const std::string& type)
+{
+    uint64_t h = 0xCBF29CE484222325ULL;
+    for (size_t i = 0; i < type.size(); ++i)
+    {
+        h ^= static_cast<unsigned char>(type[i]);
+        h *= 0x100000001B3ULL;
+    }
+    return h;
+}
+
+} // namespace
+
+bool PriceCache::Key::operator == (const Key& other) const
+{
+    return type == other.type && quantized == other.quantized && std::memcmp(fields, other.fields, sizeof(fields)) == 0;
+}
+
+size_t PriceCache::KeyHash::operator () (const Key& key) const
+{
+    uint64_t h = Mix(key.type ^ (key.quantized ? 1 : 0));
+    for (size_t i = 0; i < 6; ++i)
+    {
+        h = Mix(h ^ static_cast<uint64_t>(key.fields[i]));
+    }
+    return static_cast<size_t>(h);
+}
+
+// parameter constructor
+PriceCache::PriceCache(const size_t capacity, const size_t shards, const double tolerance)
+    : m_shards(), m_shardCapacity(0), m_tolerance(tolerance), m_hits(0), m_misses(0), m_evictions(0)
+{
+    if (capacity == 0 || shards == 0 || !(tolerance == 0.0 || (tolerance >= MIN_TOLERANCE && std::isfinite(tolerance))))
+    {
+        throw UnexpectedInputException();
+    }
+
+    m_shardCapacity = (capacity + shards - 1) / shards;
+    for (size_t i = 0; i < shards; ++i)
+    {
+        m_shards.push_back(std::unique_ptr<Shard>(new Shard()));
+    }
+}
+
+// destructor
+PriceCache::~PriceCache() = default;
+
+PriceCache::Key PriceCache::MakeKey(const std::string& type, const double K, const double r, const double sig, const double T, const double b, const double U) const
+{ // bit patterns (with -0 folded into 0), only the spot is quantized
+    const double values[6] = { K, r, sig, T, b, U };
+    Key key;
+    key.type = TypeHash(type);
+
+    for (size_t i = 0; i < 6; ++i)
+    {
+        const double v = (values[i] == 0.0) ? 0.0 : values[i];
+        std::memcpy(&key.fields[i], &v, sizeof(v));
+    }
+
+    // |quotient| < 2^62 fits llround with room to spare, NaN and infinite spots fail the test and stay exact
+    const double quotient = (m_tolerance > 0.0) ? U / m_tolerance : 0.0;
+    key.quantized = (m_tolerance > 0.0 && std::abs(quotient) < 4.611686018427387904e18);
+    if (key.quantized)
+    {
+        key.fields[5] = static_cast<int64_t>(std::llround(quotient));
+    }
+
+    return key;
+}
+
+PriceCache::Shard& PriceCache::ShardFor(const size_t hash)
+{
+    return *m_shards[(hash >> 32) % m_shards.size()];       // high bits, the map buckets use the low ones
+}
+
+bool PriceCache::Find(const std::string& type, const OptionData& data, const double U, CachedGreeks& out)
+{
+    return Find(type, data.K(), data.R(), data.Sig(), data.T(), data.B(), U, out);
+}
+
+bool PriceCache::Find(const std::string& type, const double K, const double r, const double sig, const double T, const double b, const double U, CachedGreeks& out)
+{
+    const Key key = MakeKey(type, K, r, sig, T, b, U);
+    const size_t hash = KeyHash()(key);
+    Shard& shard = ShardFor(hash);
+
+    {
+        std::lock_guard<std::mutex> guard(shard.lock);
+        auto itr = shard.index.find(key);
+        if (itr != shard.index.end())
+        {
+            shard.entries.splice(shard.entries.begin(), shard.entries, itr->second);      // most recently used
+            out = itr->second->second;
+            m_hits.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    m_misses.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+void PriceCache::Insert(const std::string& type, const OptionData& data, const double U, const CachedGreeks& value)
+{
+    Insert(type, data.K(), data.R(), data.Sig(), data.T(), data.B(), U, value);
+}
+
+void PriceCache::Insert(const std::string& type, const double K, const double r, const double sig, const double T, const double b, const double U, const CachedGreeks& value)
+{
+    const Key key = MakeKey(type, K, r, sig, T, b, U);
+    const size_t hash = KeyHash()(key);
+    Shard& shard = ShardFor(hash);
+
+    std::lock_guard<std::mutex> guard(shard.lock);
+
+    auto itr = shard.index.find(key);
+    if (itr != shard.index.end())
+    { // refresh in place
+        itr->second->second = value;
+        shard.entries.splice(shard.entries.begin(), shard.entries, itr->second);
+        return;
+    }
+
+    if (shard.entries.size() >= m_shardCapacity)
+    { // evict the least recently used entry of this shard
+        shard.index.erase(shard.entries.back().first);
+        shard.entries.pop_back();
+        m_evictions.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    shard.entries.emplace_front(key, value);
+    shard.index.emplace(key, shard.entries.begin());
+}
+
+void PriceCache::Clear()
+{
+    for (size_t i = 0; i < m_shards.size(); ++i)
+    {
+        std::lock_guard<std::mutex> guard(m_shards[i]->lock);
+        m_shards[i]->index.clear();
+        m_shards[i]->entries.clear();
+    }
+}
+
+void PriceCache::ResetCounters()
+{
+    m_hits = 0;
+    m_misses = 0;
+    m_evictions = 0;
+}
+
+// getter functions
+size_t PriceCache::Size()
+{
+    size_t total = 0;
+    for (size_t i = 0; i < m_shards.size(); ++i)
+    {
+        std::lock_guard<std::mutex> guard(m_shards[i]->lock);
+        total += m_shards[i]->entries.size();
+    }
+    return total;
+}
+
+size_t PriceCache::Capacity() const
+{
+    return m_shardCapacity * m_shards.size();
+}
+
+size_t PriceCache::Shards() const
+{
+    return m_shards.size();
+}
+
+double PriceCache::Tolerance() const
+{
+    return m_tolerance;
+}
+
+size_t PriceCache::Hits() const
+{
+    return m_hits.load(std::memory_order_relaxed);
+}
+
+size_t PriceCache::Misses() const
+{
+    return m_misses.load(std::memory_order_relaxed);
+}
+
+size_t PriceCache::Evictions() const
+{
+    return m_evictions.load(std::memory_order_relaxed);
+}
+
+double PriceCache::HitRate() const
+{
+    const size_t hits = Hits();
+    const size_t total = hits + Misses();
+    return (total == 0) ? 0.0 : static_cast<double>(hits) / static_cast<double>(total);
+}
+
+} // namespace Engine
+} // namespace AidanRicher
@@ -0,0 +1,101 @@
+#ifndef PriceCache_HPP
+#define PriceCache_HPP
+
+#include "OptionData.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace AidanRicher {
+namespace Engine {
+
+// cached result of one (type, contract, spot) evaluation
+struct CachedGreeks {
+    double price;
+    double delta;
+    double gamma;
+};
+
+// bounded, sharded, thread safe memo of prices keyed by option type, contract terms and spot
+// each shard is an LRU list under its own mutex, so concurrent lookups on different keys rarely contend
+// with a tolerance > 0 the spot is rounded to a multiple of it before hashing, so spots that agree to within
+// the tolerance share an entry (the cached value is the one computed for the first of them)
+// the contract terms K, r, sig, T and b always match exactly, one absolute step cannot suit inputs as far apart in scale as spot and rate
+class PriceCache {
+    private:
+        struct Key {
+            uint64_t type;          // hash of the option type name
+            int64_t fields[6];      // K, r, sig, T, b, spot, bit patterns except a quantized spot
+            bool quantized;         // fields[5] is a multiple of the tolerance rather than a bit pattern
+            bool operator == (const Key& other) const;
+        };
+
+        struct KeyHash {
+            size_t operator () (const Key& key) const;
+        };
+
+        struct Shard {
+            std::mutex lock;
+            std::list<std::pair<Key, CachedGreeks>> entries;        // most recently used first
+            std::unordered_map<Key, std::list<std::pair<Key, CachedGreeks>>::iterator, KeyHash> index;
+        };
+
+        std::vector<std::unique_ptr<Shard>> m_shards;
+        size_t m_shardCapacity;         // entries per shard before the least recently used is evicted
+        double m_tolerance;             // spot quantization step, 0 for exact keys
+        std::atomic<size_t> m_hits;
+        std::atomic<size_t> m_misses;
+        std::atomic<size_t> m_evictions;
+
+        Key MakeKey(const std::string& type, const double K, const double r, const double sig, const double T, const double b, const double U) const;
+        Shard& ShardFor(const size_t hash);
+
+    public:
+        // parameter constructor, capacity is the total number of entries, split evenly over the shards
+        // tolerance is the spot quantization step, 0 or at least MIN_TOLERANCE
+        // throws UnexpectedInputException for a zero capacity or shard count, or a tolerance outside that range
+        // a spot too large to quantize with the tolerance (spot / tolerance beyond int64) keeps an exact key
+        static constexpr double MIN_TOLERANCE = 1e-9;
+
+        PriceCache(const size_t capacity, const size_t shards = 16, const double tolerance = 0.0);
+
+        // non-copyable, shared between pricers by pointer
+        PriceCache(const PriceCache& other) = delete;
+        PriceCache& operator = (const PriceCache& other) = delete;
+
+        // destructor
+        ~PriceCache();
+
+        // lookup, true and the cached greeks on a hit, counts a hit or a miss
+        bool Find(const std::string& type, const OptionData& data, const double U, CachedGreeks& out);
+        bool Find(const std::string& type, const double K, const double r, const double sig, const double T, const double b, const double U, CachedGreeks& out);
+
+        // insert or refresh an entry, evicts the least recently used entry of a full shard
+        void Insert(const std::string& type, const OptionData& data, const double U, const CachedGreeks& value);
+        void Insert(const std::string& type, const double K, const double r, const double sig, const double T, const double b, const double U, const CachedGreeks& value);
+
+        // drop every entry, the counters are kept
+        void Clear();
+        void ResetCounters();
+
+        // getter functions
+        size_t Size();                  // entries currently held
+        size_t Capacity() const;
+        size_t Shards() const;
+        double Tolerance() const;
+        size_t Hits() const;
+        size_t Misses() const;
+        size_t Evictions() const;
+        double HitRate() const;         // hits / (hits + misses), 0 before the first lookup
+};
+
+} // namespace Engine
+} // namespace AidanRicher
+
+#endif // PriceCache_HPP
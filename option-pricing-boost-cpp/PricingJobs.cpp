@@ -0,0 +1,140 @@
+#include "PricingJobs.hpp"
+#include "BatchPricer.hpp"
+#include "ArrayException.hpp"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+using namespace AidanRicher::Containers;
+
+namespace AidanRicher {
+namespace Engine {
+
+namespace {
+
+// state shared by the row tasks of one grid job, the last task to finish fulfils the promise
+struct GridJob {
+    MatrixParameters params;
+    std::string type;
+    CancellationToken token;
+    ProgressCallback progress;
+    PricingSnapshot result;
+    std::promise<PricingSnapshot> promise;
+    std::atomic<size_t> finished;
+    std::atomic<bool> failed;
+    std::mutex progressLock;        // progress calls for one job never overlap
+
+    GridJob(const MatrixParameters& p, const std::string& t, const CancellationToken& c, ProgressCallback f)
+        : params(p), type(t), token(c), progress(f), result(), promise(), finished(0), failed(false), progressLock() { }
+
+    void Fail(std::exception_ptr error)
+    { // first failure wins, later rows only count themselves off
+        if (!failed.exchange(true)) { promise.set_exception(error); }
+    }
+};
+
+void PriceRow(const std::shared_ptr<GridJob>& job, const size_t i)
+{
+    const size_t rows = job->result.prices.size();
+
+    if (!job->failed.load())
+    {
+        try
+        {
+            job->token.ThrowIfCancelled();
+
+            const MatrixParameters& p = job->params;
+            const size_t cols = p.GetStrikes()[i].size();
+            GridColumns row = { p.GetStrikes()[i].data(), p.GetRates()[i].data(), p.GetVols()[i].data(), p.GetMaturities()[i].data(), p.GetCarry()[i].data(), p.GetSpots()[i].data(), cols };
+
+            // same per-element status and NaN masking as PricingMatrix
+            std::vector<uint8_t> status(cols);
+            ValidateBatch(job->type, row, status.data());
+
+            job->result.prices[i].resize(cols);
+            job->result.deltas[i].resize(cols);
+            job->result.gammas[i].resize(cols);
+            GreeksBatch(job->type, row, job->result.prices[i].data(), job->result.deltas[i].data(), job->result.gammas[i].data(), status.data());
+        }
+        catch (...)
+        {
+            job->Fail(std::current_exception());
+        }
+    }
+
+    const size_t done = job->finished.fetch_add(1) + 1;
+
+    if (job->progress && !job->failed.load())
+    {
+        std::lock_guard<std::mutex> guard(job->progressLock);
+        job->progress(done, rows);
+    }
+
+    if (done == rows && !job->failed.load())
+    {
+        job->promise.set_value(std::move(job->result));
+    }
+}
+
+} // namespace
+
+std::future<PricingSnapshot> SubmitGrid(JobExecutor& executor, const MatrixParameters& params, const std::string& type, const JobPriority priority,
+                                        const CancellationToken& token, ProgressCallback progress)
+{
+    const size_t rows = params.GetStrikes().size();
+
+    // shape errors are the caller's, report them now rather than through the future
+    if (params.GetRates().size() != rows || params.GetVols().size() != rows || params.GetMaturities().size() != rows || params.GetCarry().size() != rows || params.GetSpots().size() != rows)
+    {
+        throw SizeMismatchException();
+    }
+    for (size_t i = 0; i < rows; ++i)
+    {
+        const size_t cols = params.GetStrikes()[i].size();
+        if (params.GetRates()[i].size() != cols || params.GetVols()[i].size() != cols || params.GetMaturities()[i].size() != cols || params.GetCarry()[i].size() != cols || params.GetSpots()[i].size() != cols)
+        {
+            throw SizeMismatchException();
+        }
+    }
+
+    std::shared_ptr<GridJob> job = std::make_shared<GridJob>(params, type, token, progress);
+    job->result.prices.resize(rows);
+    job->result.deltas.resize(rows);
+    job->result.gammas.resize(rows);
+
+    std::future<PricingSnapshot> result = job->promise.get_future();
+
+    if (rows == 0)
+    {
+        job->promise.set_value(std::move(job->result));
+        return result;
+    }
+
+    for (size_t i = 0; i < rows; ++i)
+    {
+        executor.Post(priority, [job, i]() { PriceRow(job, i); });
+    }
+
+    return result;
+}
+
+std::future<double> SubmitBookValue(JobExecutor& executor, const IncrementalPricer& book, const JobPriority priority, const CancellationToken& token)
+{
+    IncrementalPricer copy(book);
+
+    return executor.Submit(priority, [copy, token]() mutable {
+        token.ThrowIfCancelled();
+        copy.RepriceAll();
+        return copy.BookValue();
+    });
+}
+
+std::future<size_t> SubmitReprice(JobExecutor& executor, IncrementalPricer& book, const JobPriority priority)
+{
+    IncrementalPricer* live = &book;
+    return executor.Submit(priority, [live]() { return live->Reprice(); });
+}
+
+} // namespace Engine
+} // namespace AidanRicher
@@ -0,0 +1,31 @@
+#ifndef PricingJobs_HPP
+#define PricingJobs_HPP
+
+#include "JobExecutor.hpp"
+#include "MatrixParameters.hpp"
+#include "PricingMatrix.hpp"
+#include "IncrementalPricer.hpp"
+#include <future>
+#include <string>
+
+namespace AidanRicher {
+namespace Engine {
+
+// asynchronous versions of the synchronous pricing calls, run on a shared JobExecutor
+// a cancelled job throws JobCancelledException from future.get(), other errors are rethrown as they were raised
+
+// PricingMatrix::ComputeAll() as a job, one task per row so tick work can run between rows
+// the parameters are copied, progress reports rows done out of rows, throws SizeMismatchException at once for ragged matrices
+std::future<PricingSnapshot> SubmitGrid(JobExecutor& executor, const MatrixParameters& params, const std::string& type, const JobPriority priority,
+                                        const CancellationToken& token, ProgressCallback progress = nullptr);
+
+// value of a copy of the book after a full reprice
+std::future<double> SubmitBookValue(JobExecutor& executor, const IncrementalPricer& book, const JobPriority priority, const CancellationToken& token);
+
+// IncrementalPricer::Reprice() on a live book, the book must not be touched until the future is ready
+std::future<size_t> SubmitReprice(JobExecutor& executor, IncrementalPricer& book, const JobPriority priority = PRIORITY_TICK);
+
+} // namespace Engine
+} // namespace AidanRicher
+
+#endif // PricingJobs_HPP
@@ -1,11 +1,9 @@
 #include "PricingMatrix.hpp"
-#include "EuropeanCall.hpp"
-#include "EuropeanPut.hpp"
-#include "PerpAmericanCall.hpp"
-#include "PerpAmericanPut.hpp"
 #include "ArrayException.hpp"
+#include "BinaryGrid.hpp"
 #include <iostream>
 #include <iomanip>
+#include <limits>
 
 using namespace AidanRicher::Containers;
 
@@ -13,13 +11,16 @@ namespace AidanRicher {
 namespace Engine {
 
 // defualt constructor
-PricingMatrix::PricingMatrix() { }
+PricingMatrix::PricingMatrix() : m_results(new SnapshotPublisher<PricingSnapshot>()), m_invalidCount(0), m_validated(false), m_cache(nullptr) { }
 
 // parameter constructor
-PricingMatrix::PricingMatrix(const MatrixParameters& params, const std::string& type) : m_params(params), m_type(type), m_priceMatrix(), m_deltaMatrix(), m_gammaMatrix() { }
+PricingMatrix::PricingMatrix(const MatrixParameters& params, const std::string& type) : m_params(params), m_type(type), m_results(new SnapshotPublisher<PricingSnapshot>()), m_statusMatrix(), m_invalidCount(0), m_validated(false), m_cache(nullptr) { }
 
 // copy constructor
-PricingMatrix::PricingMatrix(const PricingMatrix& other) : m_params(other.m_params), m_type(other.m_type), m_priceMatrix(other.m_priceMatrix), m_deltaMatrix(other.m_deltaMatrix), m_gammaMatrix(other.m_gammaMatrix) { }
+PricingMatrix::PricingMatrix(const PricingMatrix& other) : m_params(other.m_params), m_type(other.m_type), m_results(new SnapshotPublisher<PricingSnapshot>()), m_statusMatrix(other.m_statusMatrix), m_invalidCount(other.m_invalidCount), m_validated(other.m_validated), m_cache(other.m_cache)
+{ // the copy gets its own publisher, starting from the results of other
+    PublishCopy(other.m_results->Current());
+}
 
 // destructor
 PricingMatrix::~PricingMatrix() = default;
@@ -31,15 +32,19 @@ PricingMatrix& PricingMatrix::operator = (const PricingMatrix& other)
 
     m_params = other.m_params;
     m_type = other.m_type;
-    m_priceMatrix = other.m_priceMatrix;
-    m_deltaMatrix = other.m_deltaMatrix;
-    m_gammaMatrix = other.m_gammaMatrix;
+    PublishCopy(other.m_results->Current());
+    m_statusMatrix = other.m_statusMatrix;
+    m_invalidCount = other.m_invalidCount;
+    m_validated = other.m_validated;
+    m_cache = other.m_cache;
 
     return *this;
 }
 
-void PricingMatrix::ComputePriceMatrix()
-{
+void PricingMatrix::Validate()
+{ // dimension check and per-element status, done once per parameter set
+    if (m_validated) { return; }
+
     const std::vector<std::vector<double>>& strikes = m_params.GetStrikes();
     const std::vector<std::vector<double>>& rates = m_params.GetRates();
     const std::vector<std::vector<double>>& vols = m_params.GetVols();
@@ -62,185 +67,169 @@ void PricingMatrix::ComputePriceMatrix()
         }
     }
 
-    // resize price matrix
-    m_priceMatrix.clear();
-    m_priceMatrix.resize(strikes.size());   // rows
+    // per-element status, bad elements come out as NaN instead of aborting the grid
+    m_statusMatrix.clear();
+    m_statusMatrix.resize(strikes.size());
+    m_invalidCount = 0;
 
     for (size_t i = 0; i < strikes.size(); ++i)
     {
-        m_priceMatrix[i].resize(strikes[i].size());     // columns
-        
-        for (size_t j = 0; j < strikes[i].size(); ++j)
-        {
-            OptionData optionData(strikes[i][j], rates[i][j], vols[i][j], maturities[i][j], carry[i][j]);
-            double spot = spots[i][j];
-
-            if (m_type == "EuropeanCall")
-            {
-                EuropeanCall opt(optionData);
-                m_priceMatrix[i][j] = opt.Price(spot);
-            }
-            else if (m_type == "EuropeanPut")
-            {
-                EuropeanPut opt(optionData);
-                m_priceMatrix[i][j] = opt.Price(spot);
-            }
-            else if (m_type == "PerpAmericanCall")
-            {
-                PerpAmericanCall opt(optionData);
-                m_priceMatrix[i][j] = opt.Price(spot);
-            }
-            else if (m_type == "PerpAmericanPut")
-            {
-                PerpAmericanPut opt(optionData);
-                m_priceMatrix[i][j] = opt.Price(spot);
-            }
-            else
-            {
-                throw UnexpectedInputException();
-            }
-        }
+        m_statusMatrix[i].resize(strikes[i].size());
+        m_invalidCount += ValidateBatch(m_type, Row(i), m_statusMatrix[i].data());     // throws UnexpectedInputException for an unknown type
     }
+
+    m_validated = true;
 }
 
-void PricingMatrix::ComputeDeltaMatrix(const double h)
-{
-    const std::vector<std::vector<double>>& strikes = m_params.GetStrikes();
-    const std::vector<std::vector<double>>& rates = m_params.GetRates();
-    const std::vector<std::vector<double>>& vols = m_params.GetVols();
-    const std::vector<std::vector<double>>& maturities = m_params.GetMaturities();
-    const std::vector<std::vector<double>>& carry = m_params.GetCarry();
-    const std::vector<std::vector<double>>& spots = m_params.GetSpots();
+GridColumns PricingMatrix::Row(const size_t i) const
+{ // each row of the parameter matrices is contiguous, so a row is a column view for the batch kernels
+    GridColumns row = { m_params.GetStrikes()[i].data(), m_params.GetRates()[i].data(), m_params.GetVols()[i].data(), m_params.GetMaturities()[i].data(), m_params.GetCarry()[i].data(), m_params.GetSpots()[i].data(), m_params.GetStrikes()[i].size() };
+    return row;
+}
 
-    // verify outer matrix dimenstions are equal
-    if (strikes.size() != rates.size() || strikes.size() != vols.size() || strikes.size() != maturities.size() || strikes.size() != carry.size() || strikes.size() != spots.size())
-    {
-        throw SizeMismatchException();
-    }
-    
-    // verify inner matrix dimensions per row are equal
-    for (size_t i = 0; i < strikes.size(); ++i)
+void PricingMatrix::Compute(const bool price, const bool delta, const bool gamma)
+{ // results not being recomputed are carried over from the current snapshot, then the whole set is published at once
+    Validate();
+
+    PricingSnapshot& back = m_results->Back();
+    const PricingSnapshot& current = m_results->Current();
+
+    if (!price) { back.prices = current.prices; }
+    if (!delta) { back.deltas = current.deltas; }
+    if (!gamma) { back.gammas = current.gammas; }
+
+    Fill(price ? &back.prices : nullptr, delta ? &back.deltas : nullptr, gamma ? &back.gammas : nullptr);
+    m_results->Publish();
+}
+
+void PricingMatrix::Fill(std::vector<std::vector<double>>* prices, std::vector<std::vector<double>>* deltas, std::vector<std::vector<double>>* gammas)
+{ // run the batch kernels row by row into the requested matrices, resizing keeps the capacity of a recycled buffer
+    const size_t rows = m_statusMatrix.size();
+    if (prices) { prices->resize(rows); }
+    if (deltas) { deltas->resize(rows); }
+    if (gammas) { gammas->resize(rows); }
+
+    for (size_t i = 0; i < rows; ++i)
     {
-        if (rates[i].size() != strikes[i].size() || vols[i].size() != strikes[i].size() || maturities[i].size() != strikes[i].size() || carry[i].size() != strikes[i].size() || spots[i].size() != strikes[i].size())
+        const size_t cols = m_statusMatrix[i].size();
+        if (prices) { (*prices)[i].resize(cols); }
+        if (deltas) { (*deltas)[i].resize(cols); }
+        if (gammas) { (*gammas)[i].resize(cols); }
+
+        if (m_cache)
         {
-            throw SizeMismatchException();
+            ComputeCached(i, prices ? (*prices)[i].data() : nullptr, deltas ? (*deltas)[i].data() : nullptr, gammas ? (*gammas)[i].data() : nullptr);
+            continue;
         }
+
+        GreeksBatch(m_type, Row(i), prices ? (*prices)[i].data() : nullptr, deltas ? (*deltas)[i].data() : nullptr, gammas ? (*gammas)[i].data() : nullptr, m_statusMatrix[i].data());
     }
+}
 
-    // resize delta matrix
-    m_deltaMatrix.clear();
-    m_deltaMatrix.resize(strikes.size());
+void PricingMatrix::ComputeCached(const size_t i, double* prices, double* deltas, double* gammas)
+{ // hits are copied out, misses are gathered into columns and priced by one kernel call
+    const GridColumns row = Row(i);
+    const uint8_t* status = m_statusMatrix[i].data();
+    const double nan = std::numeric_limits<double>::quiet_NaN();
 
-    for (size_t i = 0; i < strikes.size(); ++i)
+    std::vector<size_t> missing;
+    for (size_t j = 0; j < row.size; ++j)
     {
-        m_deltaMatrix[i].resize(strikes[i].size());
+        CachedGreeks value = { nan, nan, nan };
 
-        for (size_t j = 0; j < strikes[i].size(); ++j)
+        // invalid elements never reach the cache
+        if (status[j] == BATCH_VALID && !m_cache->Find(m_type, row.strikes[j], row.rates[j], row.vols[j], row.maturities[j], row.carry[j], row.spots[j], value))
         {
-            OptionData optionData(strikes[i][j], rates[i][j], vols[i][j], maturities[i][j], carry[i][j]);
-            double spot = spots[i][j];
-
-            if (m_type == "EuropeanCall")
-            {
-                EuropeanCall opt(optionData);
-                m_deltaMatrix[i][j] = opt.Delta(spot);
-            }
-            else if (m_type == "EuropeanPut")
-            {
-                EuropeanPut opt(optionData);
-                m_deltaMatrix[i][j] = opt.Delta(spot);
-            }
-            else if (m_type == "PerpAmericanCall")
-            {
-                PerpAmericanCall opt(optionData);
-                m_deltaMatrix[i][j] = opt.DividedDifferenceDelta(spot, h);
-            }
-            else if (m_type == "PerpAmericanPut")
-            {
-                PerpAmericanPut opt(optionData);
-                m_deltaMatrix[i][j] = opt.DividedDifferenceDelta(spot, h);
-            }
-            else
-            {
-                throw UnexpectedInputException();
-            }
+            missing.push_back(j);
+            continue;
         }
+
+        if (prices) { prices[j] = value.price; }
+        if (deltas) { deltas[j] = value.delta; }
+        if (gammas) { gammas[j] = value.gamma; }
     }
-}
 
-void PricingMatrix::ComputeGammaMatrix(const double h)
-{
-    const std::vector<std::vector<double>>& strikes = m_params.GetStrikes();
-    const std::vector<std::vector<double>>& rates = m_params.GetRates();
-    const std::vector<std::vector<double>>& vols = m_params.GetVols();
-    const std::vector<std::vector<double>>& maturities = m_params.GetMaturities();
-    const std::vector<std::vector<double>>& carry = m_params.GetCarry();
-    const std::vector<std::vector<double>>& spots = m_params.GetSpots();
+    if (missing.empty()) { return; }
 
-    // verify outer matrix dimenstions are equal
-    if (strikes.size() != rates.size() || strikes.size() != vols.size() || strikes.size() != maturities.size() || strikes.size() != carry.size() || strikes.size() != spots.size())
+    const size_t n = missing.size();
+    std::vector<double> columns(6 * n);
+    for (size_t m = 0; m < n; ++m)
     {
-        throw SizeMismatchException();
-    }
-    
-    // verify inner matrix dimensions per row are equal
-    for (size_t i = 0; i < strikes.size(); ++i)
-    {
-        if (rates[i].size() != strikes[i].size() || vols[i].size() != strikes[i].size() || maturities[i].size() != strikes[i].size() || carry[i].size() != strikes[i].size() || spots[i].size() != strikes[i].size())
-        {
-            throw SizeMismatchException();
-        }
+        const size_t j = missing[m];
+        columns[m] = row.strikes[j];
+        columns[n + m] = row.rates[j];
+        columns[2 * n + m] = row.vols[j];
+        columns[3 * n + m] = row.maturities[j];
+        columns[4 * n + m] = row.carry[j];
+        columns[5 * n + m] = row.spots[j];
     }
 
-    // resize gamma matrix
-    m_gammaMatrix.clear();
-    m_gammaMatrix.resize(strikes.size());
+    GridColumns batch = { &columns[0], &columns[n], &columns[2 * n], &columns[3 * n], &columns[4 * n], &columns[5 * n], n };
+    std::vector<double> p(n), d(n), g(n);
+    GreeksBatch(m_type, batch, p.data(), d.data(), g.data());
 
-    for (size_t i = 0; i < strikes.size(); ++i)
+    for (size_t m = 0; m < n; ++m)
     {
-        m_gammaMatrix[i].resize(strikes[i].size());
+        const size_t j = missing[m];
+        CachedGreeks value = { p[m], d[m], g[m] };
+        m_cache->Insert(m_type, row.strikes[j], row.rates[j], row.vols[j], row.maturities[j], row.carry[j], row.spots[j], value);
 
-        for (size_t j = 0; j < strikes[i].size(); ++j)
-        {
-            OptionData optionData(strikes[i][j], rates[i][j], vols[i][j], maturities[i][j], carry[i][j]);
-            double spot = spots[i][j];
-
-            if (m_type == "EuropeanCall")
-            {
-                EuropeanCall opt(optionData);
-                m_gammaMatrix[i][j] = opt.Gamma(spot);
-            }
-            else if (m_type == "EuropeanPut")
-            {
-                EuropeanPut opt(optionData);
-                m_gammaMatrix[i][j] = opt.Gamma(spot);
-            }
-            else if (m_type == "PerpAmericanCall")
-            {
-                PerpAmericanCall opt(optionData);
-                m_gammaMatrix[i][j] = opt.DividedDifferenceGamma(spot, h);
-            }
-            else if (m_type == "PerpAmericanPut")
-            {
-                PerpAmericanPut opt(optionData);
-                m_gammaMatrix[i][j] = opt.DividedDifferenceGamma(spot, h);
-            }
-            else
-            {
-                throw UnexpectedInputException();
-            }
-        }
+        if (prices) { prices[j] = value.price; }
+        if (deltas) { deltas[j] = value.delta; }
+        if (gammas) { gammas[j] = value.gamma; }
     }
 }
 
+void PricingMatrix::SetCache(PriceCache* cache)
+{
+    m_cache = cache;
+}
+
+void PricingMatrix::PublishCopy(const PricingSnapshot& results)
+{
+    PricingSnapshot& back = m_results->Back();
+    back.prices = results.prices;
+    back.deltas = results.deltas;
+    back.gammas = results.gammas;
+    m_results->Publish();
+}
+
+void PricingMatrix::ComputePriceMatrix()
+{
+    Compute(true, false, false);
+}
+
+void PricingMatrix::ComputeDeltaMatrix(const double h)
+{
+    // parameter h isn't being used, every option type now has a closed form delta
+    (void)h;
+
+    Compute(false, true, false);
+}
+
+void PricingMatrix::ComputeGammaMatrix(const double h)
+{
+    // parameter h isn't being used, every option type now has a closed form gamma
+    (void)h;
+
+    Compute(false, false, true);
+}
+
+void PricingMatrix::ComputeAll()
+{
+    Compute(true, true, true);
+}
+
 void PricingMatrix::PrintPriceMatrix()
 {
+    const std::vector<std::vector<double>>& matrix = m_results->Current().prices;
+
     std::cout << m_type << " Price Matrix:\n";
-    for (size_t i = 0; i < m_priceMatrix.size(); ++i)
+    for (size_t i = 0; i < matrix.size(); ++i)
     {
-        for (size_t j = 0; j < m_priceMatrix[i].size(); ++j)
+        for (size_t j = 0; j < matrix[i].size(); ++j)
         {
-            std::cout << std::fixed << std::setprecision(5) << std::setw(10) << m_priceMatrix[i][j];
+            std::cout << std::fixed << std::setprecision(5) << std::setw(10) << matrix[i][j];
         }
         std::cout << "\n";
     }
@@ -248,12 +237,14 @@ void PricingMatrix::PrintPriceMatrix()
 
 void PricingMatrix::PrintDeltaMatrix()
 {
+    const std::vector<std::vector<double>>& matrix = m_results->Current().deltas;
+
     std::cout << m_type << " Delta Matrix:\n";
-    for (size_t i = 0; i < m_deltaMatrix.size(); ++i)
+    for (size_t i = 0; i < matrix.size(); ++i)
     {
-        for (size_t j = 0; j < m_deltaMatrix[i].size(); ++j)
+        for (size_t j = 0; j < matrix[i].size(); ++j)
         {
-            std::cout << std::fixed << std::setprecision(5) << std::setw(10) << m_deltaMatrix[i][j];
+            std::cout << std::fixed << std::setprecision(5) << std::setw(10) << matrix[i][j];
         }
         std::cout << "\n";
     }
@@ -261,30 +252,104 @@ void PricingMatrix::PrintDeltaMatrix()
 
 void PricingMatrix::PrintGammaMatrix()
 {
+    const std::vector<std::vector<double>>& matrix = m_results->Current().gammas;
+
     std::cout << m_type << " Gamma Matrix:\n";
-    for (size_t i = 0; i < m_gammaMatrix.size(); ++i)
+    for (size_t i = 0; i < matrix.size(); ++i)
     {
-        for (size_t j = 0; j < m_gammaMatrix[i].size(); ++j)
+        for (size_t j = 0; j < matrix[i].size(); ++j)
         {
-            std::cout << std::fixed << std::setprecision(5) << std::setw(10) << m_gammaMatrix[i][j];
+            std::cout << std::fixed << std::setprecision(5) << std::setw(10) << matrix[i][j];
         }
         std::cout << "\n";
     }
 }
 
+void PricingMatrix::WriteBinary(const std::string& path) const
+{ // from a pinned snapshot, so a concurrent recompute cannot tear the file
+    SnapshotHandle<PricingSnapshot> results = Snapshot();
+    const std::vector<std::vector<double>>* matrices[3] = { &results->prices, &results->deltas, &results->gammas };
+    const uint64_t flags[3] = { RESULT_PRICE, RESULT_DELTA, RESULT_GAMMA };
+
+    uint64_t mask = 0;
+    size_t rows = 0;
+    size_t cols = 0;
+
+    // every computed matrix must share one rectangular shape
+    for (size_t m = 0; m < 3; ++m)
+    {
+        const std::vector<std::vector<double>>& matrix = *matrices[m];
+        if (matrix.empty()) { continue; }
+
+        if (mask == 0)
+        {
+            rows = matrix.size();
+            cols = matrix[0].size();
+        }
+
+        if (matrix.size() != rows)
+        {
+            throw SizeMismatchException();
+        }
+
+        for (size_t i = 0; i < matrix.size(); ++i)
+        {
+            if (matrix[i].size() != cols) { throw SizeMismatchException(); }
+        }
+
+        mask |= flags[m];
+    }
+
+    if (mask == 0)
+    {
+        throw EmptyArrayException();
+    }
+
+    BinaryResultWriter writer(path, rows, cols, mask);
+
+    for (size_t i = 0; i < rows; ++i)
+    {
+        writer.Write(i * cols, cols, (mask & RESULT_PRICE) ? results->prices[i].data() : nullptr, (mask & RESULT_DELTA) ? results->deltas[i].data() : nullptr, (mask & RESULT_GAMMA) ? results->gammas[i].data() : nullptr);
+    }
+
+    writer.Close();
+}
+
+SnapshotHandle<PricingSnapshot> PricingMatrix::Snapshot() const
+{
+    return m_results->Acquire();
+}
+
+uint64_t PricingMatrix::Version() const
+{
+    return m_results->Version();
+}
+
 const std::vector<std::vector<double>>& PricingMatrix::GetPriceMatrix() const
 {
-    return m_priceMatrix;
+    return m_results->Current().prices;
 }
 
 const std::vector<std::vector<double>>& PricingMatrix::GetDeltaMatrix() const
 {
-    return m_deltaMatrix;
+    return m_results->Current().deltas;
 }
 
 const std::vector<std::vector<double>>& PricingMatrix::GetGammaMatrix() const
 {
-    return m_gammaMatrix;
+    return m_results->Current().gammas;
+}
+
+const std::vector<std::vector<uint8_t>>& PricingMatrix::GetStatusMatrix()
+{
+    Validate();
+    return m_statusMatrix;
+}
+
+size_t PricingMatrix::InvalidCount()
+{
+    Validate();
+    return m_invalidCount;
 }
 
 } // namespace Engine
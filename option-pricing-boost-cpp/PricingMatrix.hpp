@@ -2,21 +2,45 @@
 #define PricingMatrix_HPP
 
 #include "MatrixParameters.hpp"
+#include "BatchPricer.hpp"
+#include "PriceCache.hpp"
+#include "Snapshot.hpp"
+#include <cstdint>
+#include <memory>
 #include <vector>
 #include <string>
 
 namespace AidanRicher {
 namespace Engine {
 
+// one consistent set of results, matrices that have never been computed are empty
+struct PricingSnapshot {
+    std::vector<std::vector<double>> prices;
+    std::vector<std::vector<double>> deltas;
+    std::vector<std::vector<double>> gammas;
+};
+
 class PricingMatrix {
     private:
         MatrixParameters m_params;      // option parameter matrix
         std::string m_type;             // option type
 
-        // store our computed matrices
-        std::vector<std::vector<double>> m_priceMatrix;
-        std::vector<std::vector<double>> m_deltaMatrix;
-        std::vector<std::vector<double>> m_gammaMatrix;
+        // computed matrices, each Compute fills a back buffer and publishes it whole
+        std::unique_ptr<SnapshotPublisher<PricingSnapshot>> m_results;
+
+        // per-element BatchStatus, filled once by Validate()
+        std::vector<std::vector<uint8_t>> m_statusMatrix;
+        size_t m_invalidCount;
+        bool m_validated;
+
+        PriceCache* m_cache;            // optional shared memo, not owned
+
+        void Validate();                        // dimension and element checks, once per parameter set
+        GridColumns Row(const size_t i) const;  // row i of the parameter matrices as batch kernel input
+        void Compute(const bool price, const bool delta, const bool gamma);                        // into the back buffer, then publish
+        void Fill(std::vector<std::vector<double>>* prices, std::vector<std::vector<double>>* deltas, std::vector<std::vector<double>>* gammas);
+        void PublishCopy(const PricingSnapshot& results);                                          // publish a copy of another matrix's results
+        void ComputeCached(const size_t i, double* prices, double* deltas, double* gammas);     // row i through the cache, misses priced as one batch
 
     public:
         // default constructor
@@ -34,23 +58,40 @@ class PricingMatrix {
         // assignment operator
         PricingMatrix& operator = (const PricingMatrix& other);
 
+        // consult a shared cache before pricing, nullptr switches it off again
+        // misses are priced with price, delta and gamma together so later requests for any of them hit
+        void SetCache(PriceCache* cache);
+
         // computational functions
+        // invalid elements (see BatchStatus) come out as NaN instead of throwing, GetStatusMatrix() says why
         void ComputePriceMatrix();
-        // Delta and Gamma Matrix coomputation functions must have an h parameter as an input
-        // contains the divided difference method calcualation for approximating perpetual american options
-        // h is set to 0.0001, or h = 1e-4
+        // Delta and Gamma Matrix computation functions use the closed form greeks for every option type
+        // h was the divided difference step for perpetual american options, kept so existing callers still compile
         void ComputeDeltaMatrix(const double h = 0.0001);
         void ComputeGammaMatrix(const double h = 0.0001);
+        void ComputeAll();      // price, delta and gamma matrices in one pass
 
         // printing functions
         void PrintPriceMatrix();
         void PrintDeltaMatrix();
         void PrintGammaMatrix();
 
-        // getter functions
+        // write the computed matrices to a columnar binary result file at full precision
+        // matrices that have not been computed are left out of the file
+        void WriteBinary(const std::string& path) const;
+
+        // any thread, pin the latest published results, consistent across price, delta and gamma
+        // the pricer keeps computing into another buffer while the handle is held, and never waits for readers
+        SnapshotHandle<PricingSnapshot> Snapshot() const;
+        uint64_t Version() const;       // number of results published so far
+
+        // getter functions, the latest results for the thread that computes them
+        // other threads use Snapshot(), a later Compute may recycle the buffer these references point into
         const std::vector<std::vector<double>>& GetPriceMatrix() const;
         const std::vector<std::vector<double>>& GetDeltaMatrix() const;
         const std::vector<std::vector<double>>& GetGammaMatrix() const;
+        const std::vector<std::vector<uint8_t>>& GetStatusMatrix();     // validates on first use
+        size_t InvalidCount();                                          // number of invalid elements
 };
 
 } // namespace Engine
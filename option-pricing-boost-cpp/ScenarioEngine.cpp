@@ -0,0 +1,289 @@
+#include "ScenarioEngine.hpp"
+#include "GlobalEngine.hpp"
+#include "EuropeanCall.hpp"
+#include "EuropeanPut.hpp"
+#include "PerpAmericanCall.hpp"
+#include "PerpAmericanPut.hpp"
+#include "ArrayException.hpp"
+#include <boost/math/distributions/normal.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <exception>
+#include <limits>
+#include <mutex>
+#include <thread>
+
+using namespace AidanRicher::Containers;
+
+namespace AidanRicher {
+namespace Engine {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// ScenarioShocks                                                                                                  //
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// default constructor
+ScenarioShocks::ScenarioShocks() : m_spotShocks(1, 0.0), m_volShocks(1, 0.0) { }
+
+// parameter constructor from explicit shock lists
+ScenarioShocks::ScenarioShocks(const std::vector<double>& spotShocks, const std::vector<double>& volShocks) : m_spotShocks(spotShocks), m_volShocks(volShocks)
+{
+    if (m_spotShocks.empty() || m_volShocks.empty())
+    {
+        throw EmptyArrayException();
+    }
+}
+
+// parameter constructor for evenly spaced grids
+ScenarioShocks::ScenarioShocks(const double spotLow, const double spotHigh, const size_t nSpot, const double volLow, const double volHigh, const size_t nVol)
+{
+    if (nSpot == 0 || nVol == 0)
+    {
+        throw EmptyArrayException();
+    }
+
+    // a single point grid sits on the low end
+    double spotStep = (nSpot > 1) ? (spotHigh - spotLow) / static_cast<double>(nSpot - 1) : 0.0;
+    double volStep = (nVol > 1) ? (volHigh - volLow) / static_cast<double>(nVol - 1) : 0.0;
+
+    m_spotShocks = MeshArray(spotLow, spotStep, nSpot);
+    m_volShocks = MeshArray(volLow, volStep, nVol);
+}
+
+// copy constructor
+ScenarioShocks::ScenarioShocks(const ScenarioShocks& other) : m_spotShocks(other.m_spotShocks), m_volShocks(other.m_volShocks) { }
+
+// destructor
+ScenarioShocks::~ScenarioShocks() = default;
+
+// assignment operator
+ScenarioShocks& ScenarioShocks::operator = (const ScenarioShocks& other)
+{
+    if (this == &other) { return *this; }
+
+    m_spotShocks = other.m_spotShocks;
+    m_volShocks = other.m_volShocks;
+
+    return *this;
+}
+
+// getter functions
+const std::vector<double>& ScenarioShocks::GetSpotShocks() const
+{
+    return m_spotShocks;
+}
+
+const std::vector<double>& ScenarioShocks::GetVolShocks() const
+{
+    return m_volShocks;
+}
+
+size_t ScenarioShocks::NumScenarios() const
+{
+    return m_spotShocks.size() * m_volShocks.size();
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// ScenarioEngine                                                                                                  //
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// default constructor
+ScenarioEngine::ScenarioEngine() { }
+
+// parameter constructor
+ScenarioEngine::ScenarioEngine(const std::vector<OptionData>& contracts, const std::vector<double>& spots, const std::string& type) : m_contracts(contracts), m_spots(spots), m_type(type)
+{
+    if (m_contracts.size() != m_spots.size())
+    {
+        throw SizeMismatchException();
+    }
+
+    if (m_type != "EuropeanCall" && m_type != "EuropeanPut" && m_type != "PerpAmericanCall" && m_type != "PerpAmericanPut")
+    {
+        throw UnexpectedInputException();
+    }
+}
+
+// copy constructor
+ScenarioEngine::ScenarioEngine(const ScenarioEngine& other) : m_contracts(other.m_contracts), m_spots(other.m_spots), m_type(other.m_type) { }
+
+// destructor
+ScenarioEngine::~ScenarioEngine() = default;
+
+// assignment operator
+ScenarioEngine& ScenarioEngine::operator = (const ScenarioEngine& other)
+{
+    if (this == &other) { return *this; }
+
+    m_contracts = other.m_contracts;
+    m_spots = other.m_spots;
+    m_type = other.m_type;
+
+    return *this;
+}
+
+void ScenarioEngine::PriceChunk(const size_t first, const size_t last, const double volShock, const std::vector<double>& spotShocks, const std::vector<double>& logShocks, std::vector<double>& out) const
+{ // fill out with (last - first) x spotShocks.size() prices at one vol shock
+    boost::math::normal_distribution<> myNormal;
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    const size_t nSpot = spotShocks.size();
+    const bool european = (m_type == "EuropeanCall" || m_type == "EuropeanPut");
+    const bool call = (m_type == "EuropeanCall" || m_type == "PerpAmericanCall");
+
+    for (size_t c = first; c < last; ++c)
+    {
+        const OptionData& d = m_contracts[c];
+        const double S = m_spots[c];
+        const double sig = d.Sig() + volShock;
+        double* row = &out[(c - first) * nSpot];
+
+        const bool finite = std::isfinite(d.K()) && std::isfinite(d.R()) && std::isfinite(sig) && std::isfinite(d.T()) && std::isfinite(d.B()) && std::isfinite(S);
+        if (!finite || !(sig > 0.0) || !(S > 0.0) || !(d.K() > 0.0) || (european && !(d.T() > 0.0)))
+        { // the ValidateBatch domain checks on the shocked contract, boost's cdf throws on the NaN these would give
+            for (size_t s = 0; s < nSpot; ++s) { row[s] = nan; }
+            continue;
+        }
+
+        if (european)
+        { // everything but log(U / K) is constant across the spot shocks
+            const double sigRootT = sig * std::sqrt(d.T());
+            const double drift = (d.B() + 0.5 * sig * sig) * d.T();
+            const double discount = std::exp(-d.R() * d.T());
+            const double carry = std::exp((d.B() - d.R()) * d.T());
+            const double logMoneyness = std::log(S / d.K());
+
+            for (size_t s = 0; s < nSpot; ++s)
+            {
+                const double U = S * (1.0 + spotShocks[s]);
+                if (!(U > 0.0) || !std::isfinite(U)) { row[s] = nan; continue; }
+
+                const double d1 = (logMoneyness + logShocks[s] + drift) / sigRootT;
+                const double d2 = d1 - sigRootT;
+
+                row[s] = call ? U * carry * cdf(myNormal, d1) - d.K() * discount * cdf(myNormal, d2)
+                              : d.K() * discount * cdf(myNormal, -d2) - U * carry * cdf(myNormal, -d1);
+            }
+        }
+        else
+        { // perpetual price is a power law in U, so V(S * (1 + shock)) = V(S) * (1 + shock)^y
+            const double sigma_squared = sig * sig;
+            const double root = std::sqrt(std::pow((d.B() / sigma_squared - 0.5), 2.0) + (2.0 * d.R() / sigma_squared));
+            const double y = call ? 0.5 - (d.B() / sigma_squared) + root : 0.5 - (d.B() / sigma_squared) - root;
+            const double base = call ? (d.K() / (y - 1.0)) * std::pow(((y - 1.0) / y) * (S / d.K()), y)
+                                     : (d.K() / (1.0 - y)) * std::pow(((y - 1.0) / y) * (S / d.K()), y);
+
+            for (size_t s = 0; s < nSpot; ++s)
+            {
+                row[s] = !(spotShocks[s] > -1.0) ? nan : base * std::exp(y * logShocks[s]);
+            }
+        }
+    }
+}
+
+void ScenarioEngine::Run(const ScenarioShocks& shocks, const std::function<void(const ScenarioChunk&)>& sink, const size_t chunkSize, const unsigned threads) const
+{
+    const std::vector<double>& spotShocks = shocks.GetSpotShocks();
+    const std::vector<double>& volShocks = shocks.GetVolShocks();
+
+    if (chunkSize == 0)
+    {
+        throw NegativeStepSizeException();
+    }
+
+    if (m_contracts.empty()) { return; }
+
+    // log(1 + shock) is shared by every contract
+    std::vector<double> logShocks(spotShocks.size());
+    for (size_t s = 0; s < spotShocks.size(); ++s)
+    {
+        logShocks[s] = (spotShocks[s] > -1.0) ? std::log1p(spotShocks[s]) : 0.0;
+    }
+
+    // work items are (contract block, vol shock) pairs
+    const size_t nBlocks = (m_contracts.size() + chunkSize - 1) / chunkSize;
+    const size_t nItems = nBlocks * volShocks.size();
+
+    unsigned nThreads = (threads == 0) ? std::thread::hardware_concurrency() : threads;
+    if (nThreads == 0) { nThreads = 1; }
+    if (nThreads > nItems) { nThreads = static_cast<unsigned>(nItems); }
+
+    std::atomic<size_t> next(0);
+    std::mutex sinkMutex;
+    std::exception_ptr error;
+
+    auto worker = [&]()
+    {
+        std::vector<double> buffer(chunkSize * spotShocks.size());      // reused for every chunk of this thread
+
+        try
+        {
+            for (size_t item = next++; item < nItems; item = next++)
+            {
+                const size_t block = item / volShocks.size();
+                const size_t v = item % volShocks.size();
+                const size_t first = block * chunkSize;
+                const size_t last = std::min(first + chunkSize, m_contracts.size());
+
+                PriceChunk(first, last, volShocks[v], spotShocks, logShocks, buffer);
+
+                ScenarioChunk chunk = { first, last - first, v, spotShocks.size(), buffer.data() };
+
+                std::lock_guard<std::mutex> lock(sinkMutex);
+                if (error) { return; }
+                sink(chunk);
+            }
+        }
+        catch (...)
+        { // keep the first error and stop handing out work
+            std::lock_guard<std::mutex> lock(sinkMutex);
+            if (!error) { error = std::current_exception(); }
+            next = nItems;
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < nThreads; ++t)
+    {
+        pool.push_back(std::thread(worker));
+    }
+    worker();       // calling thread does its share
+
+    for (size_t t = 0; t < pool.size(); ++t)
+    {
+        pool[t].join();
+    }
+
+    if (error) { std::rethrow_exception(error); }
+}
+
+double ScenarioEngine::Price(const size_t contract, const double spotShock, const double volShock) const
+{ // reference price through the option classes
+    if (contract >= m_contracts.size())
+    {
+        throw OutOfBoundsException(static_cast<int>(contract));
+    }
+
+    OptionData data = m_contracts[contract];
+    data.Sig(data.Sig() + volShock);
+    const double U = m_spots[contract] * (1.0 + spotShock);
+
+    if (m_type == "EuropeanCall") { return EuropeanCall(data).Price(U); }
+    if (m_type == "EuropeanPut") { return EuropeanPut(data).Price(U); }
+    if (m_type == "PerpAmericanCall") { return PerpAmericanCall(data).Price(U); }
+    return PerpAmericanPut(data).Price(U);
+}
+
+// getter functions
+size_t ScenarioEngine::Size() const
+{
+    return m_contracts.size();
+}
+
+const std::string& ScenarioEngine::Type() const
+{
+    return m_type;
+}
+
+} // namespace Engine
+} // namespace AidanRicher
@@ -0,0 +1,96 @@
+#ifndef ScenarioEngine_HPP
+#define ScenarioEngine_HPP
+
+#include "OptionData.hpp"
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace AidanRicher {
+namespace Engine {
+
+class ScenarioShocks {
+    private:
+        std::vector<double> m_spotShocks;       // relative spot bumps, S * (1 + shock)
+        std::vector<double> m_volShocks;        // absolute vol bumps, sig + shock
+
+    public:
+        // default constructor, single unshocked scenario
+        ScenarioShocks();
+
+        // parameter constructor from explicit shock lists
+        ScenarioShocks(const std::vector<double>& spotShocks, const std::vector<double>& volShocks);
+
+        // parameter constructor for evenly spaced grids, e.g. (-0.1, 0.1, 21, -0.05, 0.05, 11)
+        ScenarioShocks(const double spotLow, const double spotHigh, const size_t nSpot, const double volLow, const double volHigh, const size_t nVol);
+
+        // copy constructor
+        ScenarioShocks(const ScenarioShocks& other);
+
+        // destructor
+        ~ScenarioShocks();
+
+        // assignment operator
+        ScenarioShocks& operator = (const ScenarioShocks& other);
+
+        // getter functions
+        const std::vector<double>& GetSpotShocks() const;
+        const std::vector<double>& GetVolShocks() const;
+        size_t NumScenarios() const;
+};
+
+// block of the result cube handed to the caller
+// holds every spot shock for contracts [FirstContract, FirstContract + NumContracts) at one vol shock
+struct ScenarioChunk {
+    size_t FirstContract;
+    size_t NumContracts;
+    size_t VolIndex;
+    size_t NumSpotShocks;
+    const double* Values;       // NumContracts x NumSpotShocks, row major
+
+    double Value(const size_t contract, const size_t spotIndex) const { return Values[contract * NumSpotShocks + spotIndex]; }
+};
+
+class ScenarioEngine {
+    private:
+        std::vector<OptionData> m_contracts;    // contract params (k, r, sig, t, b)
+        std::vector<double> m_spots;            // base spot per contract
+        std::string m_type;                     // option type, same names as PricingMatrix
+
+        // price one chunk into out, invariants of each contract are hoisted out of the spot shock loop
+        void PriceChunk(const size_t first, const size_t last, const double volShock, const std::vector<double>& spotShocks, const std::vector<double>& logShocks, std::vector<double>& out) const;
+
+    public:
+        // default constructor
+        ScenarioEngine();
+
+        // parameter constructor, spots[i] is the base spot of contracts[i]
+        ScenarioEngine(const std::vector<OptionData>& contracts, const std::vector<double>& spots, const std::string& type);
+
+        // copy constructor
+        ScenarioEngine(const ScenarioEngine& other);
+
+        // destructor
+        ~ScenarioEngine();
+
+        // assignment operator
+        ScenarioEngine& operator = (const ScenarioEngine& other);
+
+        // full revaluation over every (contract, spot shock, vol shock)
+        // results are streamed to sink one chunk at a time, sink is never called concurrently
+        // work is split over contract blocks and vol shocks, threads = 0 uses the hardware concurrency
+        // cells whose shocked contract fails the ValidateBatch domain checks are NaN, one bad contract never stops the run
+        void Run(const ScenarioShocks& shocks, const std::function<void(const ScenarioChunk&)>& sink, const size_t chunkSize = 256, const unsigned threads = 0) const;
+
+        // single scenario price, for spot checks against the streamed cube
+        double Price(const size_t contract, const double spotShock, const double volShock) const;
+
+        // getter functions
+        size_t Size() const;
+        const std::string& Type() const;
+};
+
+} // namespace Engine
+} // namespace AidanRicher
+
+#endif // ScenarioEngine_HPP
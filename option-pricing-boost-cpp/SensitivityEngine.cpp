@@ -0,0 +1,182 @@
+#include "SensitivityEngine.hpp"
+#include "ArrayException.hpp"
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <limits>
+
+using namespace AidanRicher::Containers;
+
+namespace AidanRicher {
+namespace Engine {
+
+namespace {
+
+const double COMPLEX_STEP = 1.0e-20;        // imaginary step, no cancellation so it can be far below sqrt(eps)
+
+} // namespace
+
+// parameter constructor
+SensitivityEngine::SensitivityEngine(const Option& option, const double U) : m_option(option.Clone()), m_spot(U), m_basePrice(std::numeric_limits<double>::quiet_NaN()), m_cache(), m_evaluations(0) { }
+
+// copy constructor
+SensitivityEngine::SensitivityEngine(const SensitivityEngine& other) : m_option(other.m_option->Clone()), m_spot(other.m_spot), m_basePrice(other.m_basePrice), m_cache(other.m_cache), m_evaluations(other.m_evaluations) { }
+
+// destructor
+SensitivityEngine::~SensitivityEngine() = default;
+
+// assignment operator
+SensitivityEngine& SensitivityEngine::operator = (const SensitivityEngine& other)
+{
+    if (this == &other) { return *this; }
+
+    m_option.reset(other.m_option->Clone());
+    m_spot = other.m_spot;
+    m_basePrice = other.m_basePrice;
+    m_cache = other.m_cache;
+    m_evaluations = other.m_evaluations;
+
+    return *this;
+}
+
+void SensitivityEngine::Spot(const double U)
+{
+    if (U == m_spot) { return; }
+
+    m_spot = U;
+    m_basePrice = std::numeric_limits<double>::quiet_NaN();
+    m_cache.clear();
+}
+
+double SensitivityEngine::BaseValue(const SensitivityParameter param) const
+{
+    const OptionData& data = m_option->GetData();
+
+    switch (param)
+    {
+        case SENS_SPOT: return m_spot;
+        case SENS_VOL: return data.Sig();
+        case SENS_RATE: return data.R();
+        case SENS_MATURITY: return data.T();
+        case SENS_CARRY: return data.B();
+    }
+
+    throw UnexpectedInputException();
+}
+
+bool SensitivityEngine::Positive(const SensitivityParameter param) const
+{
+    return param == SENS_SPOT || param == SENS_VOL || param == SENS_MATURITY;
+}
+
+double SensitivityEngine::Evaluate(const SensitivityParameter param, const double x)
+{ // memoized price with one parameter moved to x, the base point is shared across parameters
+    if (x == BaseValue(param)) { return Price(); }
+
+    std::pair<int, double> key(param, x);
+    std::map<std::pair<int, double>, double>::const_iterator itr = m_cache.find(key);
+    if (itr != m_cache.end()) { return itr->second; }
+
+    double value;
+    if (param == SENS_SPOT)
+    {
+        value = m_option->Price(x);
+    }
+    else
+    {
+        OptionData data(m_option->GetData());
+        if (param == SENS_VOL) { data.Sig(x); }
+        else if (param == SENS_RATE) { data.R(x); }
+        else if (param == SENS_MATURITY) { data.T(x); }
+        else { data.B(x); }
+
+        std::unique_ptr<Option> bumped(m_option->Clone(data));
+        value = bumped->Price(m_spot);
+    }
+
+    ++m_evaluations;
+    m_cache[key] = value;
+
+    return value;
+}
+
+double SensitivityEngine::Price()
+{
+    if (std::isnan(m_basePrice))
+    {
+        m_basePrice = m_option->Price(m_spot);
+        ++m_evaluations;
+    }
+
+    return m_basePrice;
+}
+
+double SensitivityEngine::Delta()
+{
+    if (m_option->HasComplexPrice())
+    {
+        ++m_evaluations;
+        return ComplexStepDelta();
+    }
+
+    return FirstDerivative(SENS_SPOT);
+}
+
+double SensitivityEngine::Gamma()
+{
+    return SecondDerivative(SENS_SPOT);
+}
+
+double SensitivityEngine::ComplexStepDelta() const
+{ // f(U + ih) = f(U) + ih f'(U) + O(h^2), the imaginary part carries the derivative with no subtraction
+    return m_option->ComplexPrice(std::complex<double>(m_spot, COMPLEX_STEP)).imag() / COMPLEX_STEP;
+}
+
+double SensitivityEngine::Step(const SensitivityParameter param) const
+{ // eps^(1/4) balances truncation and round-off for the second difference, and is still accurate for the first
+    const double x = BaseValue(param);
+    const double h = std::pow(std::numeric_limits<double>::epsilon(), 0.25) * std::max(std::abs(x), 1.0);
+
+    // round so that x + h - x is exactly h
+    volatile double bumped = x + h;
+    return bumped - x;
+}
+
+double SensitivityEngine::FirstDerivative(const SensitivityParameter param)
+{
+    const double x = BaseValue(param);
+    const double h = Step(param);
+
+    if (Positive(param) && x - h <= 0.0)
+    { // one-sided second order stencil on x, x + h, x + 2h
+        return (-3.0 * Price() + 4.0 * Evaluate(param, x + h) - Evaluate(param, x + 2.0 * h)) / (2.0 * h);
+    }
+
+    return (Evaluate(param, x + h) - Evaluate(param, x - h)) / (2.0 * h);
+}
+
+double SensitivityEngine::SecondDerivative(const SensitivityParameter param)
+{
+    const double x = BaseValue(param);
+    const double h = Step(param);
+
+    if (Positive(param) && x - h <= 0.0)
+    {
+        return (Price() - 2.0 * Evaluate(param, x + h) + Evaluate(param, x + 2.0 * h)) / (h * h);
+    }
+
+    return (Evaluate(param, x + h) - 2.0 * Price() + Evaluate(param, x - h)) / (h * h);
+}
+
+size_t SensitivityEngine::Evaluations() const
+{
+    return m_evaluations;
+}
+
+const Option& SensitivityEngine::GetOption() const
+{
+    return *m_option;
+}
+
+} // namespace Engine
+} // namespace AidanRicher
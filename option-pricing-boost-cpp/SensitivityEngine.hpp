@@ -0,0 +1,71 @@
+#ifndef SensitivityEngine_HPP
+#define SensitivityEngine_HPP
+
+#include "Option.hpp"
+#include "OptionData.hpp"
+#include <map>
+#include <memory>
+#include <utility>
+
+namespace AidanRicher {
+namespace Engine {
+
+// parameters a sensitivity can be taken with respect to
+enum SensitivityParameter {
+    SENS_SPOT = 0,      // underlying spot U
+    SENS_VOL,           // volatility sig
+    SENS_RATE,          // interest rate r
+    SENS_MATURITY,      // time to expiry T
+    SENS_CARRY          // cost of carry b
+};
+
+// numerical sensitivities of any Option at a fixed spot
+// delta uses complex-step differentiation where the option supports it (one evaluation, no cancellation)
+// everything else uses central differences with an automatic step, every bumped price is cached so the
+// first and second derivative of a parameter share one 3-point stencil and the base price is shared by all
+class SensitivityEngine {
+    private:
+        std::unique_ptr<Option> m_option;       // owned copy of the option at the base params
+        double m_spot;                          // base spot
+        double m_basePrice;                     // price at the base point, NaN until first needed
+        std::map<std::pair<int, double>, double> m_cache;   // (parameter, bumped value) -> price
+        size_t m_evaluations;                   // real price evaluations, cache hits excluded
+
+        double Evaluate(const SensitivityParameter param, const double x);  // price with one parameter moved to x
+        double BaseValue(const SensitivityParameter param) const;          // current value of a parameter
+        bool Positive(const SensitivityParameter param) const;             // parameter must stay > 0 (spot, vol, T)
+
+    public:
+        // parameter constructor, the option is cloned
+        SensitivityEngine(const Option& option, const double U);
+
+        // copy constructor
+        SensitivityEngine(const SensitivityEngine& other);
+
+        // destructor
+        ~SensitivityEngine();
+
+        // assignment operator
+        SensitivityEngine& operator = (const SensitivityEngine& other);
+
+        // move the base spot, clears the cache
+        void Spot(const double U);
+
+        double Price();                 // base price
+        double Delta();                 // complex step if supported, otherwise central difference
+        double Gamma();                 // second derivative in spot
+        double ComplexStepDelta() const;                            // Im(Price(U + ih)) / h, throws if the option has no complex price
+
+        double FirstDerivative(const SensitivityParameter param);   // d Price / d param
+        double SecondDerivative(const SensitivityParameter param);  // d2 Price / d param2, shares the stencil of FirstDerivative
+
+        // getter functions
+        double Step(const SensitivityParameter param) const;        // automatic step, eps^(1/4) * max(|x|, 1)
+        size_t Evaluations() const;                                 // price evaluations so far
+        const Option& GetOption() const;
+};
+
+} // namespace Engine
+} // namespace AidanRicher
+
+#endif // SensitivityEngine_HPP
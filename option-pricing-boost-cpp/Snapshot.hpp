@@ -0,0 +1,167 @@
+#ifndef Snapshot_HPP
+#define Snapshot_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace AidanRicher {
+namespace Engine {
+
+// one buffer of a SnapshotPublisher, a reader pins it while looking at it
+template <typename T>
+struct SnapshotSlot {
+    T value;
+    uint64_t version;                   // publish count when this buffer was made current
+    std::atomic<size_t> readers;        // handles currently pinning this buffer
+
+    SnapshotSlot() : value(), version(0), readers(0) { }
+};
+
+// read handle on a published snapshot, the buffer is not reused by the writer while the handle lives
+// move-only, release it (or let it go out of scope) promptly so the writer can recycle the buffer
+template <typename T>
+class SnapshotHandle {
+    private:
+        SnapshotSlot<T>* m_slot;        // pinned buffer, nullptr when empty
+
+    public:
+        // default constructor, empty handle
+        SnapshotHandle() : m_slot(nullptr) { }
+
+        // parameter constructor, takes over a pin already counted in slot->readers
+        explicit SnapshotHandle(SnapshotSlot<T>* slot) : m_slot(slot) { }
+
+        // move constructor
+        SnapshotHandle(SnapshotHandle&& other) noexcept : m_slot(other.m_slot) { other.m_slot = nullptr; }
+
+        // non-copyable, every handle is one pin
+        SnapshotHandle(const SnapshotHandle& other) = delete;
+        SnapshotHandle& operator = (const SnapshotHandle& other) = delete;
+
+        // destructor, unpins the buffer
+        ~SnapshotHandle() { Release(); }
+
+        // move assignment operator
+        SnapshotHandle& operator = (SnapshotHandle&& other) noexcept
+        {
+            if (this == &other) { return *this; }
+
+            Release();
+            m_slot = other.m_slot;
+            other.m_slot = nullptr;
+
+            return *this;
+        }
+
+        void Release()
+        {
+            if (m_slot)
+            {
+                m_slot->readers.fetch_sub(1, std::memory_order_release);
+                m_slot = nullptr;
+            }
+        }
+
+        // getter functions
+        const T& operator * () const { return m_slot->value; }
+        const T* operator -> () const { return &m_slot->value; }
+        uint64_t Version() const { return m_slot ? m_slot->version : 0; }
+        explicit operator bool () const { return m_slot != nullptr; }
+};
+
+// single writer, many reader publication of immutable snapshots (read-copy-update with reference counted buffers)
+// the writer fills Back() and Publish() swaps it in with one atomic store, readers Acquire() the current buffer
+// without locks and never wait for the writer; the writer never waits either, if every older buffer is still
+// pinned by a reader it allocates another one, so the pool is two buffers plus one per long-lived handle
+// buffers live as long as the publisher, every handle must be released before the publisher is destroyed
+template <typename T>
+class SnapshotPublisher {
+    private:
+        std::vector<std::unique_ptr<SnapshotSlot<T>>> m_slots;     // buffer pool, touched by the writer only
+        std::atomic<SnapshotSlot<T>*> m_current;                    // published buffer
+        SnapshotSlot<T>* m_back;                                    // buffer being written, nullptr between publishes
+        std::atomic<uint64_t> m_version;                            // number of publishes so far, read by any thread
+
+    public:
+        // default constructor, an empty T is published as version 0
+        SnapshotPublisher() : m_slots(), m_current(nullptr), m_back(nullptr), m_version(0)
+        {
+            m_slots.emplace_back(new SnapshotSlot<T>());
+            m_current.store(m_slots[0].get());
+        }
+
+        // non-copyable, readers hold pointers into the pool
+        SnapshotPublisher(const SnapshotPublisher& other) = delete;
+        SnapshotPublisher& operator = (const SnapshotPublisher& other) = delete;
+
+        // destructor
+        ~SnapshotPublisher() = default;
+
+        // any thread, pin the current snapshot
+        SnapshotHandle<T> Acquire() const
+        { // pin, then confirm the buffer is still current, a buffer that was swapped out in between may already be rewritten
+            for (;;)
+            {
+                SnapshotSlot<T>* slot = m_current.load(std::memory_order_seq_cst);
+                slot->readers.fetch_add(1, std::memory_order_seq_cst);
+
+                if (m_current.load(std::memory_order_seq_cst) == slot)
+                {
+                    return SnapshotHandle<T>(slot);
+                }
+
+                slot->readers.fetch_sub(1, std::memory_order_release);
+            }
+        }
+
+        // writer thread only, a buffer no reader holds, kept until the next Publish()
+        // its contents are whatever an older snapshot left there, so containers keep their capacity
+        T& Back()
+        {
+            if (m_back) { return m_back->value; }
+
+            SnapshotSlot<T>* current = m_current.load(std::memory_order_relaxed);
+            for (size_t i = 0; i < m_slots.size(); ++i)
+            {
+                SnapshotSlot<T>* slot = m_slots[i].get();
+                if (slot != current && slot->readers.load(std::memory_order_seq_cst) == 0)
+                {
+                    m_back = slot;
+                    return m_back->value;
+                }
+            }
+
+            m_slots.emplace_back(new SnapshotSlot<T>());
+            m_back = m_slots.back().get();
+            return m_back->value;
+        }
+
+        // writer thread only, make Back() the current snapshot
+        void Publish()
+        {
+            Back();
+            const uint64_t version = m_version.load(std::memory_order_relaxed) + 1;
+            m_back->version = version;
+            m_current.store(m_back, std::memory_order_seq_cst);
+            m_version.store(version, std::memory_order_release);     // after the swap, Acquire() following Version() == v sees v or newer
+            m_back = nullptr;
+        }
+
+        // writer thread only, the current snapshot without pinning it (the writer is the only one that recycles buffers)
+        const T& Current() const
+        {
+            return m_current.load(std::memory_order_relaxed)->value;
+        }
+
+        // getter functions
+        uint64_t Version() const { return m_version.load(std::memory_order_acquire); }      // any thread, the buffer is not read
+        size_t Buffers() const { return m_slots.size(); }           // writer thread only
+};
+
+} // namespace Engine
+} // namespace AidanRicher
+
+#endif // Snapshot_HPP
@@ -0,0 +1,409 @@
+#include "TradeCsv.hpp"
+#include "ArrayException.hpp"
+#include <charconv>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+
+using namespace AidanRicher::Containers;
+
+namespace AidanRicher {
+namespace Engine {
+
+namespace {
+
+const size_t TRADE_FIELDS = 6;      // K, r, sig, T, b, spot
+
+inline const char* SkipBlanks(const char* p, const char* end)
+{
+    while (p < end && (*p == ' ' || *p == '\t')) { ++p; }
+    return p;
+}
+
+// parse one line "K,r,sig,T,b,spot" into values, false if malformed
+bool ParseLine(const char* p, const char* end, double* values)
+{
+    for (size_t f = 0; f < TRADE_FIELDS; ++f)
+    {
+        p = SkipBlanks(p, end);
+        if (p < end && *p == '+') { ++p; }         // from_chars does not accept a leading plus
+
+        std::from_chars_result result = std::from_chars(p, end, values[f]);
+        if (result.ec != std::errc() || result.ptr == p) { return false; }
+
+        p = SkipBlanks(result.ptr, end);
+
+        if (f + 1 < TRADE_FIELDS)
+        {
+            if (p == end || *p != ',') { return false; }
+            ++p;
+        }
+    }
+
+    return p == end;
+}
+
+// parse every complete line in [begin, end) into batch
+// returns the index (within this range) of the first malformed data row, or npos when all rows parsed
+size_t ParseRange(const char* begin, const char* end, TradeBatch& batch)
+{
+    double values[TRADE_FIELDS];
+    size_t row = 0;
+    const char* p = begin;
+
+    while (p < end)
+    {
+        const char* eol = static_cast<const char*>(std::memchr(p, '\n', static_cast<size_t>(end - p)));
+        if (eol == nullptr) { eol = end; }
+
+        const char* last = eol;
+        if (last > p && *(last - 1) == '\r') { --last; }
+
+        if (SkipBlanks(p, last) != last)
+        { // skip blank lines
+            if (!ParseLine(p, last, values)) { return row; }
+
+            batch.Add(OptionData(values[0], values[1], values[2], values[3], values[4]), values[5]);
+            ++row;
+        }
+
+        p = eol + 1;
+    }
+
+    return std::string::npos;
+}
+
+// a header starts with something that can't begin a number
+bool IsHeader(const char* p, const char* end)
+{
+    p = SkipBlanks(p, end);
+    if (p == end) { return false; }
+
+    char c = *p;
+    return !((c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.');
+}
+
+} // namespace
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// TradeBatch                                                                                                      //
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// default constructor
+TradeBatch::TradeBatch() : m_firstRow(0) { }
+
+// copy constructor
+TradeBatch::TradeBatch(const TradeBatch& other) : m_strikes(other.m_strikes), m_rates(other.m_rates), m_vols(other.m_vols), m_maturities(other.m_maturities), m_carry(other.m_carry), m_spots(other.m_spots), m_firstRow(other.m_firstRow) { }
+
+// destructor
+TradeBatch::~TradeBatch() = default;
+
+// assignment operator
+TradeBatch& TradeBatch::operator = (const TradeBatch& other)
+{
+    if (this == &other) { return *this; }
+
+    m_strikes = other.m_strikes;
+    m_rates = other.m_rates;
+    m_vols = other.m_vols;
+    m_maturities = other.m_maturities;
+    m_carry = other.m_carry;
+    m_spots = other.m_spots;
+    m_firstRow = other.m_firstRow;
+
+    return *this;
+}
+
+void TradeBatch::Clear()
+{
+    m_strikes.clear();
+    m_rates.clear();
+    m_vols.clear();
+    m_maturities.clear();
+    m_carry.clear();
+    m_spots.clear();
+    m_firstRow = 0;
+}
+
+void TradeBatch::Add(const OptionData& data, const double spot)
+{
+    m_strikes.push_back(data.K());
+    m_rates.push_back(data.R());
+    m_vols.push_back(data.Sig());
+    m_maturities.push_back(data.T());
+    m_carry.push_back(data.B());
+    m_spots.push_back(spot);
+}
+
+// getter functions
+size_t TradeBatch::Size() const
+{
+    return m_strikes.size();
+}
+
+size_t TradeBatch::FirstRow() const
+{
+    return m_firstRow;
+}
+
+OptionData TradeBatch::Contract(const size_t index) const
+{
+    if (index >= m_strikes.size())
+    {
+        throw OutOfBoundsException(static_cast<int>(index));
+    }
+
+    return OptionData(m_strikes[index], m_rates[index], m_vols[index], m_maturities[index], m_carry[index]);
+}
+
+double TradeBatch::Spot(const size_t index) const
+{
+    if (index >= m_spots.size())
+    {
+        throw OutOfBoundsException(static_cast<int>(index));
+    }
+
+    return m_spots[index];
+}
+
+GridColumns TradeBatch::Columns() const
+{
+    GridColumns grid = { m_strikes.data(), m_rates.data(), m_vols.data(), m_maturities.data(), m_carry.data(), m_spots.data(), m_strikes.size() };
+    return grid;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// CsvTradeReader                                                                                                  //
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// parameter constructor
+CsvTradeReader::CsvTradeReader(const std::string& path, const size_t chunkBytes, const unsigned threads)
+: m_file(path.c_str(), std::ios::in | std::ios::binary), m_path(path), m_buffer(), m_pending(0), m_chunkBytes(chunkBytes), m_threads(threads == 0 ? 1 : threads), m_rows(0), m_firstLine(true), m_eof(false)
+{
+    if (!m_file)
+    {
+        throw std::runtime_error("Failed to open trade file '" + path + "'");
+    }
+
+    if (m_chunkBytes == 0)
+    {
+        throw NegativeStepSizeException();
+    }
+}
+
+// destructor
+CsvTradeReader::~CsvTradeReader() { }
+
+bool CsvTradeReader::Next(TradeBatch& batch)
+{
+    batch.Clear();
+    batch.m_firstRow = m_rows;
+
+    while (batch.Size() == 0)
+    {
+        if (m_eof && m_pending == 0) { return false; }
+
+        // top up the buffer behind any partial line left from the last read
+        size_t total = m_pending;
+        if (!m_eof)
+        {
+            m_buffer.resize(m_pending + m_chunkBytes);
+            m_file.read(m_buffer.data() + m_pending, static_cast<std::streamsize>(m_chunkBytes));
+            total += static_cast<size_t>(m_file.gcount());
+
+            if (m_file.bad())
+            {
+                throw std::runtime_error("Failed to read trade file '" + m_path + "'");
+            }
+            if (!m_file) { m_eof = true; }
+        }
+
+        const char* begin = m_buffer.data();
+        const char* end = begin + total;
+
+        // parse up to the last complete line, the whole remainder once the file is exhausted
+        const char* cut = end;
+        if (!m_eof)
+        {
+            while (cut > begin && *(cut - 1) != '\n') { --cut; }
+
+            if (cut == begin)
+            { // a single line longer than the chunk, read more before parsing
+                m_pending = total;
+                m_chunkBytes *= 2;
+                continue;
+            }
+        }
+
+        if (m_firstLine && begin < cut)
+        { // skip a header line
+            const char* eol = static_cast<const char*>(std::memchr(begin, '\n', static_cast<size_t>(cut - begin)));
+            if (eol == nullptr) { eol = cut; }
+            if (IsHeader(begin, eol)) { begin = (eol < cut) ? eol + 1 : cut; }
+            m_firstLine = false;
+        }
+
+        // split the chunk at line boundaries, one piece per thread
+        unsigned pieces = m_threads;
+        if (static_cast<size_t>(cut - begin) < (size_t(1) << 16)) { pieces = 1; }     // not worth a thread
+
+        std::vector<const char*> bounds(pieces + 1, cut);
+        bounds[0] = begin;
+        for (unsigned t = 1; t < pieces; ++t)
+        {
+            const char* p = begin + (cut - begin) * t / pieces;
+            if (p < bounds[t - 1]) { p = bounds[t - 1]; }
+            while (p > begin && p < cut && *(p - 1) != '\n') { ++p; }
+            bounds[t] = p;
+        }
+
+        std::vector<size_t> bad(pieces, std::string::npos);
+        if (pieces == 1)
+        {
+            bad[0] = ParseRange(bounds[0], bounds[1], batch);
+        }
+        else
+        {
+            std::vector<TradeBatch> parts(pieces);
+            std::vector<std::thread> pool;
+            for (unsigned t = 0; t < pieces; ++t)
+            {
+                pool.push_back(std::thread([&, t]() { bad[t] = ParseRange(bounds[t], bounds[t + 1], parts[t]); }));
+            }
+            for (unsigned t = 0; t < pieces; ++t) { pool[t].join(); }
+
+            // stitch the pieces back together in file order
+            for (unsigned t = 0; t < pieces; ++t)
+            {
+                batch.m_strikes.insert(batch.m_strikes.end(), parts[t].m_strikes.begin(), parts[t].m_strikes.end());
+                batch.m_rates.insert(batch.m_rates.end(), parts[t].m_rates.begin(), parts[t].m_rates.end());
+                batch.m_vols.insert(batch.m_vols.end(), parts[t].m_vols.begin(), parts[t].m_vols.end());
+                batch.m_maturities.insert(batch.m_maturities.end(), parts[t].m_maturities.begin(), parts[t].m_maturities.end());
+                batch.m_carry.insert(batch.m_carry.end(), parts[t].m_carry.begin(), parts[t].m_carry.end());
+                batch.m_spots.insert(batch.m_spots.end(), parts[t].m_spots.begin(), parts[t].m_spots.end());
+
+                if (bad[t] != std::string::npos)
+                { // rows before the bad one in this piece are already in the batch
+                    bad[t] = parts[t].Size();
+                    break;
+                }
+            }
+        }
+
+        for (unsigned t = 0; t < pieces; ++t)
+        {
+            if (bad[t] != std::string::npos)
+            {
+                throw std::runtime_error("Malformed row " + std::to_string(m_rows + batch.Size() + 1) + " in trade file '" + m_path + "'");
+            }
+        }
+
+        // keep the partial last line for the next read
+        m_pending = static_cast<size_t>(end - cut);
+        std::memmove(m_buffer.data(), cut, m_pending);
+        m_rows += batch.Size();
+    }
+
+    return true;
+}
+
+size_t CsvTradeReader::RowsRead() const
+{
+    return m_rows;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// CsvResultWriter                                                                                                 //
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// parameter constructor
+CsvResultWriter::CsvResultWriter(const std::string& path, const size_t bufferBytes)
+: m_file(path.c_str(), std::ios::out | std::ios::binary | std::ios::trunc), m_path(path), m_buffer(bufferBytes < 256 ? 256 : bufferBytes), m_used(0)
+{
+    if (!m_file)
+    {
+        throw std::runtime_error("Failed to create result file '" + path + "'");
+    }
+}
+
+// destructor
+CsvResultWriter::~CsvResultWriter()
+{
+    if (m_file.is_open())
+    {
+        m_file.write(m_buffer.data(), static_cast<std::streamsize>(m_used));
+    }
+}
+
+void CsvResultWriter::Flush()
+{
+    m_file.write(m_buffer.data(), static_cast<std::streamsize>(m_used));
+    m_used = 0;
+
+    if (!m_file)
+    {
+        throw std::runtime_error("Failed to write result file '" + m_path + "'");
+    }
+}
+
+void CsvResultWriter::Append(const char* text, const size_t length)
+{
+    if (m_used + length > m_buffer.size()) { Flush(); }
+
+    std::memcpy(m_buffer.data() + m_used, text, length);
+    m_used += length;
+}
+
+void CsvResultWriter::Append(const double value)
+{ // shortest representation that round-trips to the same double
+    if (m_used + 32 > m_buffer.size()) { Flush(); }
+
+    std::to_chars_result result = std::to_chars(m_buffer.data() + m_used, m_buffer.data() + m_buffer.size(), value);
+    m_used = static_cast<size_t>(result.ptr - m_buffer.data());
+}
+
+void CsvResultWriter::WriteHeader(const bool prices, const bool deltas, const bool gammas)
+{
+    bool first = true;
+
+    if (prices) { Append("price", 5); first = false; }
+    if (deltas) { if (!first) { Append(",", 1); } Append("delta", 5); first = false; }
+    if (gammas) { if (!first) { Append(",", 1); } Append("gamma", 5); }
+
+    Append("\n", 1);
+}
+
+void CsvResultWriter::Write(const size_t n, const double* prices, const double* deltas, const double* gammas)
+{
+    if (!m_file.is_open())
+    {
+        throw std::runtime_error("Result file already closed");
+    }
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        bool first = true;
+
+        if (prices) { Append(prices[i]); first = false; }
+        if (deltas) { if (!first) { Append(",", 1); } Append(deltas[i]); first = false; }
+        if (gammas) { if (!first) { Append(",", 1); } Append(gammas[i]); }
+
+        Append("\n", 1);
+    }
+}
+
+void CsvResultWriter::Close()
+{
+    if (!m_file.is_open()) { return; }
+
+    Flush();
+    m_file.close();
+
+    if (!m_file)
+    {
+        throw std::runtime_error("Failed to close result file '" + m_path + "'");
+    }
+}
+
+} // namespace Engine
+} // namespace AidanRicher
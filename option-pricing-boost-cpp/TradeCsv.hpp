@@ -0,0 +1,125 @@
+#ifndef TradeCsv_HPP
+#define TradeCsv_HPP
+
+#include "BatchPricer.hpp"
+#include "OptionData.hpp"
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace AidanRicher {
+namespace Engine {
+
+// one batch of trades parsed from a CSV file, stored column-wise so it can go straight to the batch kernels
+class TradeBatch {
+    private:
+        std::vector<double> m_strikes;
+        std::vector<double> m_rates;
+        std::vector<double> m_vols;
+        std::vector<double> m_maturities;
+        std::vector<double> m_carry;
+        std::vector<double> m_spots;
+        size_t m_firstRow;                  // data row number of the first trade in the file (0 based, header excluded)
+
+        friend class CsvTradeReader;
+
+    public:
+        // default constructor
+        TradeBatch();
+
+        // copy constructor
+        TradeBatch(const TradeBatch& other);
+
+        // destructor
+        ~TradeBatch();
+
+        // assignment operator
+        TradeBatch& operator = (const TradeBatch& other);
+
+        // remove all trades, keeps the allocated capacity for the next batch
+        void Clear();
+
+        // append a trade
+        void Add(const OptionData& data, const double spot);
+
+        // getter functions
+        size_t Size() const;
+        size_t FirstRow() const;
+        OptionData Contract(const size_t index) const;     // contract params of one trade
+        double Spot(const size_t index) const;             // spot of one trade
+        GridColumns Columns() const;                        // view for PriceBatch/GreeksBatch, valid until the batch changes
+};
+
+// streaming, chunked reader for trade files with rows "K,r,sig,T,b,spot"
+// a leading header line is skipped, blank lines are ignored, \r\n line endings are accepted
+// fields are parsed in place with std::from_chars, no per-field strings are created
+class CsvTradeReader {
+    private:
+        std::ifstream m_file;
+        std::string m_path;
+        std::vector<char> m_buffer;         // read buffer, holds a partial trailing line between reads
+        size_t m_pending;                   // bytes of partial line at the start of m_buffer
+        size_t m_chunkBytes;                // bytes read from disk per chunk
+        unsigned m_threads;                 // threads used to parse a chunk
+        size_t m_rows;                      // data rows returned so far
+        bool m_firstLine;                   // header detection still pending
+        bool m_eof;
+
+    public:
+        // parameter constructor
+        // chunkBytes is the read size, each call to Next() parses at least one chunk
+        // threads > 1 splits each chunk at line boundaries and parses the pieces in parallel
+        CsvTradeReader(const std::string& path, const size_t chunkBytes = 8 << 20, const unsigned threads = 1);
+
+        // non-copyable, owns the file
+        CsvTradeReader(const CsvTradeReader& other) = delete;
+        CsvTradeReader& operator = (const CsvTradeReader& other) = delete;
+
+        // destructor
+        ~CsvTradeReader();
+
+        // fill batch with the next chunk of trades, returns false once the file is exhausted
+        // throws std::runtime_error with the row number for malformed rows
+        bool Next(TradeBatch& batch);
+
+        // data rows returned so far
+        size_t RowsRead() const;
+};
+
+// buffered CSV writer for prices and greeks, numbers are formatted with std::to_chars at full round-trip precision
+class CsvResultWriter {
+    private:
+        std::ofstream m_file;
+        std::string m_path;
+        std::vector<char> m_buffer;         // output buffer
+        size_t m_used;                      // bytes used in m_buffer
+
+        void Flush();
+        void Append(const char* text, const size_t length);
+        void Append(const double value);
+
+    public:
+        // parameter constructor, creates (or truncates) path
+        CsvResultWriter(const std::string& path, const size_t bufferBytes = 1 << 20);
+
+        // non-copyable, owns the file
+        CsvResultWriter(const CsvResultWriter& other) = delete;
+        CsvResultWriter& operator = (const CsvResultWriter& other) = delete;
+
+        // destructor, flushes remaining output
+        ~CsvResultWriter();
+
+        // write a header naming the columns that Write() will emit
+        void WriteHeader(const bool prices, const bool deltas, const bool gammas);
+
+        // write n rows, one column per non-null pointer in the order price, delta, gamma
+        void Write(const size_t n, const double* prices, const double* deltas, const double* gammas);
+
+        // flush and close, throws std::runtime_error if the data could not be written
+        void Close();
+};
+
+} // namespace Engine
+} // namespace AidanRicher
+
+#endif // TradeCsv_HPP
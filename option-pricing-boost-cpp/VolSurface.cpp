@@ -0,0 +1,215 @@
+#include "VolSurface.hpp"
+#include "ArrayException.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace AidanRicher::Containers;
+
+namespace AidanRicher {
+namespace Engine {
+
+// default constructor
+VolSurface::VolSurface() : m_axis(SURFACE_STRIKE), m_strikes(1, 1.0), m_expiries(1, 1.0), m_vols(1, 0.2), m_second(1, 0.0), m_uniform(false), m_invStep(0.0) { }
+
+// parameter constructor
+VolSurface::VolSurface(const std::vector<double>& strikes, const std::vector<double>& expiries, const std::vector<std::vector<double>>& vols, const SurfaceAxis axis)
+    : m_axis(axis), m_strikes(strikes), m_expiries(expiries), m_vols(), m_second(), m_uniform(false), m_invStep(0.0)
+{
+    if (strikes.empty() || expiries.empty())
+    {
+        throw EmptyArrayException();
+    }
+    if (vols.size() != expiries.size())
+    {
+        throw SizeMismatchException();
+    }
+
+    for (size_t i = 1; i < strikes.size(); ++i)
+    {
+        if (!(strikes[i] > strikes[i - 1])) { throw UnexpectedInputException(); }
+    }
+    for (size_t i = 0; i < expiries.size(); ++i)
+    {
+        if (!(expiries[i] > 0.0) || (i > 0 && !(expiries[i] > expiries[i - 1]))) { throw UnexpectedInputException(); }
+    }
+
+    const size_t n = strikes.size();
+    m_vols.reserve(n * expiries.size());
+    m_second.assign(n * expiries.size(), 0.0);
+
+    for (size_t i = 0; i < vols.size(); ++i)
+    {
+        if (vols[i].size() != n) { throw SizeMismatchException(); }
+        m_vols.insert(m_vols.end(), vols[i].begin(), vols[i].end());
+    }
+
+    // natural spline second derivatives per expiry, tridiagonal solve (Thomas algorithm)
+    if (n > 2)
+    {
+        std::vector<double> c(n, 0.0), d(n, 0.0);
+
+        for (size_t row = 0; row < expiries.size(); ++row)
+        {
+            const double* y = &m_vols[row * n];
+            double* M = &m_second[row * n];
+
+            for (size_t i = 1; i + 1 < n; ++i)
+            {
+                const double h0 = strikes[i] - strikes[i - 1];
+                const double h1 = strikes[i + 1] - strikes[i];
+                const double rhs = 6.0 * ((y[i + 1] - y[i]) / h1 - (y[i] - y[i - 1]) / h0);
+                const double diag = 2.0 * (h0 + h1) - h0 * c[i - 1];
+
+                c[i] = h1 / diag;
+                d[i] = (rhs - h0 * d[i - 1]) / diag;
+            }
+
+            for (size_t i = n - 2; i >= 1; --i)
+            {
+                M[i] = d[i] - c[i] * M[i + 1];
+            }
+        }
+    }
+
+    // evenly spaced strikes can be indexed directly
+    if (n > 2)
+    {
+        const double step = strikes[1] - strikes[0];
+        m_uniform = true;
+        for (size_t i = 2; i < n && m_uniform; ++i)
+        {
+            m_uniform = std::abs((strikes[i] - strikes[i - 1]) - step) <= 1e-12 * std::max(std::abs(strikes[i]), 1.0);
+        }
+        m_invStep = m_uniform ? 1.0 / step : 0.0;
+    }
+}
+
+// copy constructor
+VolSurface::VolSurface(const VolSurface& other) : m_axis(other.m_axis), m_strikes(other.m_strikes), m_expiries(other.m_expiries), m_vols(other.m_vols), m_second(other.m_second), m_uniform(other.m_uniform), m_invStep(other.m_invStep) { }
+
+// destructor
+VolSurface::~VolSurface() = default;
+
+// assignment operator
+VolSurface& VolSurface::operator = (const VolSurface& other)
+{
+    if (this == &other) { return *this; }
+
+    m_axis = other.m_axis;
+    m_strikes = other.m_strikes;
+    m_expiries = other.m_expiries;
+    m_vols = other.m_vols;
+    m_second = other.m_second;
+    m_uniform = other.m_uniform;
+    m_invStep = other.m_invStep;
+
+    return *this;
+}
+
+size_t VolSurface::Locate(const double x) const
+{ // index i with strikes[i] <= x <= strikes[i + 1]
+    const size_t last = m_strikes.size() - 2;
+
+    if (m_uniform)
+    {
+        size_t i = static_cast<size_t>((x - m_strikes[0]) * m_invStep);
+        return std::min(i, last);
+    }
+
+    size_t i = static_cast<size_t>(std::upper_bound(m_strikes.begin(), m_strikes.end(), x) - m_strikes.begin());
+    return std::min(i > 0 ? i - 1 : 0, last);
+}
+
+double VolSurface::RowVol(const size_t row, const double x) const
+{
+    const size_t n = m_strikes.size();
+    const double* y = &m_vols[row * n];
+
+    if (n == 1) { return y[0]; }
+
+    const double xc = std::min(std::max(x, m_strikes.front()), m_strikes.back());     // flat outside the strikes
+    const size_t i = Locate(xc);
+    const double* M = &m_second[row * n];
+
+    const double h = m_strikes[i + 1] - m_strikes[i];
+    const double a = (m_strikes[i + 1] - xc) / h;
+    const double b = 1.0 - a;
+
+    return a * y[i] + b * y[i + 1] + ((a * a * a - a) * M[i] + (b * b * b - b) * M[i + 1]) * h * h / 6.0;
+}
+
+double VolSurface::Vol(const double K, const double T, const double U) const
+{
+    const double x = (m_axis == SURFACE_MONEYNESS) ? K / U : K;
+    const size_t m = m_expiries.size();
+
+    if (std::isnan(x) || std::isnan(T))
+    { // would pass every bracketing test below, infinities are clamped like any other point off the grid
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+
+    if (m == 1 || T <= m_expiries.front()) { return RowVol(0, x); }
+    if (T >= m_expiries.back()) { return RowVol(m - 1, x); }
+
+    size_t j = static_cast<size_t>(std::upper_bound(m_expiries.begin(), m_expiries.end(), T) - m_expiries.begin()) - 1;
+
+    // linear in total variance between the bracketing expiries
+    const double T0 = m_expiries[j];
+    const double T1 = m_expiries[j + 1];
+    const double v0 = RowVol(j, x);
+    const double v1 = RowVol(j + 1, x);
+    const double w = v0 * v0 * T0 + (v1 * v1 * T1 - v0 * v0 * T0) * (T - T0) / (T1 - T0);
+
+    return std::sqrt(w / T);
+}
+
+OptionData VolSurface::Contract(const OptionData& data, const double U) const
+{
+    OptionData contract(data);
+    contract.Sig(Vol(data.K(), data.T(), U));
+    return contract;
+}
+
+void VolSurface::Vols(const double* strikes, const double* expiries, const double* spots, const size_t n, double* out) const
+{
+    if (m_axis == SURFACE_MONEYNESS && !spots)
+    {
+        throw UnexpectedInputException();
+    }
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        out[i] = Vol(strikes[i], expiries[i], spots ? spots[i] : 1.0);
+    }
+}
+
+void VolSurface::Apply(GridColumns& grid, double* vols) const
+{
+    Vols(grid.strikes, grid.maturities, grid.spots, grid.size, vols);
+    grid.vols = vols;
+}
+
+// getter functions
+SurfaceAxis VolSurface::Axis() const
+{
+    return m_axis;
+}
+
+const std::vector<double>& VolSurface::GetStrikes() const
+{
+    return m_strikes;
+}
+
+const std::vector<double>& VolSurface::GetExpiries() const
+{
+    return m_expiries;
+}
+
+bool VolSurface::IsUniform() const
+{
+    return m_uniform;
+}
+
+} // namespace Engine
+} // namespace AidanRicher
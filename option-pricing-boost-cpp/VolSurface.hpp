@@ -0,0 +1,74 @@
+#ifndef VolSurface_HPP
+#define VolSurface_HPP
+
+#include "BatchPricer.hpp"
+#include "OptionData.hpp"
+#include <vector>
+
+namespace AidanRicher {
+namespace Engine {
+
+// strike axis of the surface
+enum SurfaceAxis {
+    SURFACE_STRIKE = 0,         // absolute strike K
+    SURFACE_MONEYNESS           // K / U, needs the spot at lookup
+};
+
+// immutable implied volatility surface over a strike (or moneyness) x expiry grid
+// natural cubic spline in strike along each expiry, linear in total variance sig^2 * T between expiries,
+// flat extrapolation outside the grid
+// all spline coefficients are computed in the constructor and lookups are const with no caches,
+// so one surface can be shared by any number of pricing threads without locking
+class VolSurface {
+    private:
+        SurfaceAxis m_axis;
+        std::vector<double> m_strikes;      // strictly increasing
+        std::vector<double> m_expiries;     // strictly increasing, positive
+        std::vector<double> m_vols;         // expiry x strike, row major
+        std::vector<double> m_second;       // spline second derivatives, same layout as m_vols
+        bool m_uniform;                     // evenly spaced strikes, index found without a search
+        double m_invStep;                   // 1 / strike spacing when uniform
+
+        size_t Locate(const double x) const;                        // strike interval containing x, x already clamped
+        double RowVol(const size_t row, const double x) const;      // spline value along one expiry
+
+    public:
+        // default constructor, flat 20% surface
+        VolSurface();
+
+        // parameter constructor, vols[i][j] is the vol at expiries[i] and strikes[j]
+        VolSurface(const std::vector<double>& strikes, const std::vector<double>& expiries, const std::vector<std::vector<double>>& vols, const SurfaceAxis axis = SURFACE_STRIKE);
+
+        // copy constructor
+        VolSurface(const VolSurface& other);
+
+        // destructor
+        ~VolSurface();
+
+        // assignment operator
+        VolSurface& operator = (const VolSurface& other);
+
+        // single lookup, U is only used for a moneyness surface
+        // NaN for a NaN strike (or K / U) or maturity, so the row fails ValidateBatch instead of reading off the grid
+        double Vol(const double K, const double T, const double U = 1.0) const;
+
+        // contract params with sig taken from the surface
+        OptionData Contract(const OptionData& data, const double U) const;
+
+        // batch lookup, out[i] = Vol(strikes[i], expiries[i], spots[i]), spots may be nullptr for a strike surface
+        void Vols(const double* strikes, const double* expiries, const double* spots, const size_t n, double* out) const;
+
+        // fill vols from the strike, maturity and spot columns and point grid.vols at it, ready for GreeksBatch
+        void Apply(GridColumns& grid, double* vols) const;
+
+        // getter functions
+        SurfaceAxis Axis() const;
+        const std::vector<double>& GetStrikes() const;
+        const std::vector<double>& GetExpiries() const;
+        bool IsUniform() const;
+};
+
+} // namespace Engine
+} // namespace AidanRicher
+
+#endif // VolSurface_HPP
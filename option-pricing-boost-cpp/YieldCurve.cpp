@@ -0,0 +1,196 @@
+#include "YieldCurve.hpp"
+#include "ArrayException.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace AidanRicher::Containers;
+
+namespace AidanRicher {
+namespace Engine {
+
+// default constructor
+YieldCurve::YieldCurve() : m_times(1, 1.0), m_rates(1, 0.0), m_logDf(1, 0.0), m_tailForward(0.0) { }
+
+// parameter constructor for a flat curve
+YieldCurve::YieldCurve(const double rate) : m_times(1, 1.0), m_rates(1, rate), m_logDf(1, -rate), m_tailForward(rate) { }
+
+// parameter constructor from pillars
+YieldCurve::YieldCurve(const std::vector<double>& times, const std::vector<double>& rates) : m_times(times), m_rates(rates), m_logDf(times.size()), m_tailForward(0.0)
+{
+    if (times.empty())
+    {
+        throw EmptyArrayException();
+    }
+    if (times.size() != rates.size())
+    {
+        throw SizeMismatchException();
+    }
+
+    for (size_t i = 0; i < times.size(); ++i)
+    {
+        if (!(times[i] > 0.0) || (i > 0 && !(times[i] > times[i - 1]))) { throw UnexpectedInputException(); }
+        m_logDf[i] = -rates[i] * times[i];
+    }
+
+    const size_t n = times.size();
+    m_tailForward = (n == 1) ? rates[0] : (m_logDf[n - 2] - m_logDf[n - 1]) / (times[n - 1] - times[n - 2]);
+}
+
+// copy constructor
+YieldCurve::YieldCurve(const YieldCurve& other) : m_times(other.m_times), m_rates(other.m_rates), m_logDf(other.m_logDf), m_tailForward(other.m_tailForward) { }
+
+// destructor
+YieldCurve::~YieldCurve() = default;
+
+// assignment operator
+YieldCurve& YieldCurve::operator = (const YieldCurve& other)
+{
+    if (this == &other) { return *this; }
+
+    m_times = other.m_times;
+    m_rates = other.m_rates;
+    m_logDf = other.m_logDf;
+    m_tailForward = other.m_tailForward;
+
+    return *this;
+}
+
+double YieldCurve::LogDiscount(const double T) const
+{
+    const size_t n = m_times.size();
+
+    if (!std::isfinite(T))
+    { // NaN would pass both end checks and bracket past the last pillar
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+
+    if (T <= m_times.front()) { return -m_rates.front() * T; }
+    if (T >= m_times.back()) { return m_logDf[n - 1] - m_tailForward * (T - m_times[n - 1]); }
+
+    size_t i = static_cast<size_t>(std::upper_bound(m_times.begin(), m_times.end(), T) - m_times.begin()) - 1;
+    return m_logDf[i] + (m_logDf[i + 1] - m_logDf[i]) * (T - m_times[i]) / (m_times[i + 1] - m_times[i]);
+}
+
+double YieldCurve::DiscountFactor(const double T) const
+{
+    return std::exp(LogDiscount(T));
+}
+
+double YieldCurve::Growth(const double T) const
+{
+    return std::exp(-LogDiscount(T));
+}
+
+double YieldCurve::ZeroRate(const double T) const
+{
+    if (!std::isfinite(T)) { return std::numeric_limits<double>::quiet_NaN(); }
+    if (T <= m_times.front()) { return m_rates.front(); }
+    return -LogDiscount(T) / T;
+}
+
+// getter functions
+const std::vector<double>& YieldCurve::GetTimes() const
+{
+    return m_times;
+}
+
+const std::vector<double>& YieldCurve::GetRates() const
+{
+    return m_rates;
+}
+
+// parameter constructor
+CurveCache::CurveCache(const YieldCurve& rateCurve, const YieldCurve& carryCurve) : m_rateCurve(&rateCurve), m_carryCurve(&carryCurve), m_points(), m_hits(0), m_misses(0) { }
+
+// copy constructor
+CurveCache::CurveCache(const CurveCache& other) : m_rateCurve(other.m_rateCurve), m_carryCurve(other.m_carryCurve), m_points(other.m_points), m_hits(other.m_hits), m_misses(other.m_misses) { }
+
+// destructor
+CurveCache::~CurveCache() = default;
+
+// assignment operator
+CurveCache& CurveCache::operator = (const CurveCache& other)
+{
+    if (this == &other) { return *this; }
+
+    m_rateCurve = other.m_rateCurve;
+    m_carryCurve = other.m_carryCurve;
+    m_points = other.m_points;
+    m_hits = other.m_hits;
+    m_misses = other.m_misses;
+
+    return *this;
+}
+
+const CurvePoint& CurveCache::At(const double T)
+{
+    if (!std::isfinite(T))
+    { // not cached, NaN keys never compare equal and would add an entry per lookup
+        static const CurvePoint invalid = { std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::quiet_NaN(),
+                                            std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::quiet_NaN() };
+        return invalid;
+    }
+
+    std::unordered_map<double, CurvePoint>::const_iterator itr = m_points.find(T);
+    if (itr != m_points.end())
+    {
+        ++m_hits;
+        return itr->second;
+    }
+
+    // two exponentials per distinct expiry
+    CurvePoint point;
+    point.rate = m_rateCurve->ZeroRate(T);
+    point.carry = m_carryCurve->ZeroRate(T);
+    point.discount = std::exp(-point.rate * T);
+    point.carryFactor = std::exp((point.carry - point.rate) * T);
+
+    ++m_misses;
+    return m_points.emplace(T, point).first->second;
+}
+
+OptionData CurveCache::Contract(const OptionData& data)
+{
+    const CurvePoint& point = At(data.T());
+
+    OptionData contract(data);
+    contract.R(point.rate);
+    contract.B(point.carry);
+
+    return contract;
+}
+
+void CurveCache::Apply(GridColumns& grid, double* rates, double* carry, double* discounts, double* carryFactors)
+{
+    for (size_t i = 0; i < grid.size; ++i)
+    {
+        const CurvePoint& point = At(grid.maturities[i]);
+
+        rates[i] = point.rate;
+        carry[i] = point.carry;
+        if (discounts) { discounts[i] = point.discount; }
+        if (carryFactors) { carryFactors[i] = point.carryFactor; }
+    }
+
+    grid.rates = rates;
+    grid.carry = carry;
+}
+
+void CurveCache::Clear()
+{
+    m_points.clear();
+}
+
+size_t CurveCache::Hits() const
+{
+    return m_hits;
+}
+
+size_t CurveCache::Misses() const
+{
+    return m_misses;
+}
+
+} // namespace Engine
+} // namespace AidanRicher
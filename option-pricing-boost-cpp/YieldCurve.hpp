@@ -0,0 +1,105 @@
+#ifndef YieldCurve_HPP
+#define YieldCurve_HPP
+
+#include "BatchPricer.hpp"
+#include "OptionData.hpp"
+#include <unordered_map>
+#include <vector>
+
+namespace AidanRicher {
+namespace Engine {
+
+// immutable continuously compounded zero curve on pillar times
+// discount factors are precomputed on the pillars and interpolated linearly in log discount factor
+// (piecewise flat forwards), flat zero rate before the first pillar and flat forward after the last
+// the same class serves as a carry curve b(T), with Growth(T) = exp(b(T) * T)
+class YieldCurve {
+    private:
+        std::vector<double> m_times;        // pillar times, strictly increasing and positive
+        std::vector<double> m_rates;        // zero rates on the pillars
+        std::vector<double> m_logDf;        // -r_i * T_i, precomputed
+        double m_tailForward;               // forward rate used past the last pillar
+
+        double LogDiscount(const double T) const;
+
+    public:
+        // default constructor, flat zero curve
+        YieldCurve();
+
+        // parameter constructor for a flat curve
+        YieldCurve(const double rate);
+
+        // parameter constructor from pillar times and zero rates
+        YieldCurve(const std::vector<double>& times, const std::vector<double>& rates);
+
+        // copy constructor
+        YieldCurve(const YieldCurve& other);
+
+        // destructor
+        ~YieldCurve();
+
+        // assignment operator
+        YieldCurve& operator = (const YieldCurve& other);
+
+        // all three give NaN for a non-finite T, so a bad row fails ValidateBatch rather than reading off the pillars
+        double DiscountFactor(const double T) const;    // exp(-r(T) * T)
+        double Growth(const double T) const;            // exp(r(T) * T), the carry factor when used as a b curve
+        double ZeroRate(const double T) const;          // r(T), the pillar rate in the limit T -> 0
+
+        // getter functions
+        const std::vector<double>& GetTimes() const;
+        const std::vector<double>& GetRates() const;
+};
+
+// rate and carry at one expiry, with the exponentials the european formulas need
+struct CurvePoint {
+    double rate;            // r(T)
+    double carry;           // b(T)
+    double discount;        // exp(-r(T) * T)
+    double carryFactor;     // exp((b(T) - r(T)) * T)
+};
+
+// per-expiry cache over a rate curve and a carry curve
+// all contracts sharing an expiry reuse one CurvePoint, so a batch pays two exponentials per distinct expiry
+// the curves are shared read-only, a cache belongs to a single thread
+class CurveCache {
+    private:
+        const YieldCurve* m_rateCurve;
+        const YieldCurve* m_carryCurve;
+        std::unordered_map<double, CurvePoint> m_points;   // expiry -> factors
+        size_t m_hits;
+        size_t m_misses;
+
+    public:
+        // parameter constructor, the curves must outlive the cache
+        CurveCache(const YieldCurve& rateCurve, const YieldCurve& carryCurve);
+
+        // copy constructor
+        CurveCache(const CurveCache& other);
+
+        // destructor
+        ~CurveCache();
+
+        // assignment operator
+        CurveCache& operator = (const CurveCache& other);
+
+        // factors at expiry T, computed on the first request for T
+        // a non-finite T gets all NaN factors and is neither cached nor counted
+        const CurvePoint& At(const double T);
+
+        // contract params with r and b read off the curves at data.T()
+        OptionData Contract(const OptionData& data);
+
+        // fill the rate and carry columns (and the factor columns if not nullptr) from grid.maturities,
+        // then point grid.rates and grid.carry at them, ready for GreeksBatch
+        void Apply(GridColumns& grid, double* rates, double* carry, double* discounts, double* carryFactors);
+
+        void Clear();               // drop the cached expiries
+        size_t Hits() const;        // lookups served from the cache
+        size_t Misses() const;      // distinct expiries computed
+};
+
+} // namespace Engine
+} // namespace AidanRicher
+
+#endif // YieldCurve_HPP
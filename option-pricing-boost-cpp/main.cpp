@@ -8,6 +8,23 @@ In this file we will test the following functionality of our program:
 - Computing option price, delta, and gamma matrices over matrices of option data.
 - Mesh array testing to analyze option prices over a monotonically increasing mesh of spot prices.
 - Validation of put-call parity for European options.
+- Incremental repricing of a book of positions on market data updates.
+- Scenario grids of spot and volatility shocks streamed in chunks.
+- Columnar binary parameter grids priced directly from a memory mapping.
+- Streaming CSV trade files through the batch kernels.
+- Closed form perpetual American greeks and the perpetual batch kernel.
+- Per-element validation status instead of exceptions for bad grid data.
+- Complex-step and automatic-step sensitivities with respect to any contract parameter.
+- Batch put-call parity scans over whole option chains.
+- Pricing against an interpolated volatility surface.
+- Pricing against rate and carry term structures with cached discount factors.
+- Lazy uniform, geometric, Chebyshev and concentrated mesh views.
+- Fourier (COS and Carr-Madan FFT) pricing of whole strike chains under Black-Scholes, Heston and Merton.
+- Finite maturity American options with the Barone-Adesi-Whaley and Bjerksund-Stensland approximations.
+- Chebyshev tensor proxies of slow pricers, saved to disk with an error bound.
+- A sharded concurrent price cache shared by pricing matrices and the incremental pricer.
+- Lock-free result snapshots read while a pricing matrix is being recomputed.
+- Asynchronous grid, book and repricing jobs with priorities, progress callbacks and cancellation.
 */
 
 #include "EuropeanCall.hpp"
@@ -18,7 +35,29 @@ In this file we will test the following functionality of our program:
 #include "PricingMatrix.hpp"
 #include "MatrixParameters.hpp"
 #include "ArrayException.hpp"
+#include "IncrementalPricer.hpp"
+#include "ScenarioEngine.hpp"
+#include "BinaryGrid.hpp"
+#include "BatchPricer.hpp"
+#include "TradeCsv.hpp"
+#include "SensitivityEngine.hpp"
+#include "ParityScanner.hpp"
+#include "VolSurface.hpp"
+#include "YieldCurve.hpp"
+#include "MeshView.hpp"
+#include "FourierPricer.hpp"
+#include "BaroneAdesiWhaley.hpp"
+#include "BjerksundStensland.hpp"
+#include "ChebyshevProxy.hpp"
+#include "PriceCache.hpp"
+#include "PricingJobs.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
 #include <iostream>
+#include <thread>
 #include <vector>
 
 using namespace std;
@@ -335,19 +374,19 @@ try
     perp_put_matrix.ComputePriceMatrix();
     perp_put_matrix.PrintPriceMatrix();
 
-    cout << "\nApproximating Perpetual American Call Deltas Using the Divided Difference Method (h = 1e-4):" << endl;
+    cout << "\nComputing Perpetual American Call Deltas (closed form):" << endl;
     perp_call_matrix.ComputeDeltaMatrix();
     perp_call_matrix.PrintDeltaMatrix();
 
-    cout << "\nApproximating Perpetual American Call Gammas Using the Divided Difference Method (h = 1e-4):" << endl;
+    cout << "\nComputing Perpetual American Call Gammas (closed form):" << endl;
     perp_call_matrix.ComputeGammaMatrix();
     perp_call_matrix.PrintGammaMatrix();
 
-    cout << "\nApproximating Perpetual American Put Deltas Using the Divided Difference Method (h = 1e-4):" << endl;
+    cout << "\nComputing Perpetual American Put Deltas (closed form):" << endl;
     perp_put_matrix.ComputeDeltaMatrix();
     perp_put_matrix.PrintDeltaMatrix();
 
-    cout << "\nApproximating Perpetual American Put Gammas Using the Divided Difference Method (h = 1e-4):" << endl;
+    cout << "\nComputing Perpetual American Put Gammas (closed form):" << endl;
     perp_put_matrix.ComputeGammaMatrix();
     perp_put_matrix.PrintGammaMatrix();
 
@@ -356,6 +395,801 @@ try
 } catch (...) {
     cout << "Unexpected error." << endl;
 }
+cout << "-----------------------------------------------------------------------------------------------------------------" << endl;
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Group C: Extensions                                                                                             //
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Incremental Repricing
+cout << "\n===== Group C, Incremental Repricing =====" << endl;
+
+try
+{
+    // small tolerance so a 0.1% spot move uses the delta-gamma shortcut
+    IncrementalPricer book(0.005);
+    size_t abc_call = book.AddPosition("ABC", "EuropeanCall", OptionData(100.0, 0.1, 0.36, 0.5, 0.0), 105.0);
+    size_t abc_put = book.AddPosition("ABC", "EuropeanPut", OptionData(100.0, 0.1, 0.36, 0.5, 0.0), 105.0);
+    size_t xyz_perp = book.AddPosition("XYZ", "PerpAmericanCall", OptionData(100.0, 0.1, 0.1, 0.0, 0.02), 110.0);
+
+    cout << "Initial reprice updated " << book.Reprice() << " positions, book value: " << book.BookValue() << endl;
+
+    book.UpdateSpot("ABC", 105.1);     // only the ABC positions are dirty
+    cout << "Dirty positions after ABC spot move: " << book.DirtyCount() << endl;
+    book.Reprice();
+    cout << "Full evaluations: " << book.FullEvaluations() << ", Taylor updates: " << book.TaylorUpdates() << endl;
+    cout << "ABC call (Taylor): " << book.Price(abc_call) << ", exact: " << EuropeanCall(book.GetData(abc_call)).Price(105.1) << endl;
+
+    book.UpdateVol("ABC", 0.40);       // parameter change forces a full evaluation
+    book.Reprice();
+    cout << "ABC put after vol move: " << book.Price(abc_put) << ", XYZ perpetual call: " << book.Price(xyz_perp) << endl;
+
+} catch (const ArrayException& e) {
+    cout << "Error: " << e.GetMessage() << endl;
+} catch (...) {
+    cout << "Unexpected error." << endl;
+}
+cout << "-----------------------------------------------------------------------------------------------------------------" << endl;
+
+// Scenario Grid
+cout << "\n===== Group C, Scenario Grid =====" << endl;
+
+try
+{
+    // Group A, Section 1 batches under a 21 x 11 grid of spot (+/- 10%) and vol (+/- 5%) shocks
+    ScenarioEngine scenarios(batches, a_spots, "EuropeanCall");
+    ScenarioShocks shocks(-0.10, 0.10, 21, -0.05, 0.05, 11);
+
+    // keep the worst scenario per contract instead of storing the cube
+    vector<double> base_prices(batches.size());
+    vector<double> worst_pnl(batches.size(), 0.0);
+    for (size_t i = 0; i < batches.size(); ++i) { base_prices[i] = scenarios.Price(i, 0.0, 0.0); }
+
+    scenarios.Run(shocks, [&](const ScenarioChunk& chunk)
+    {
+        for (size_t c = 0; c < chunk.NumContracts; ++c)
+        {
+            for (size_t s = 0; s < chunk.NumSpotShocks; ++s)
+            {
+                size_t i = chunk.FirstContract + c;
+                worst_pnl[i] = std::min(worst_pnl[i], chunk.Value(c, s) - base_prices[i]);
+            }
+        }
+    }, 2);
+
+    cout << "Worst scenario P&L per batch over " << shocks.NumScenarios() << " scenarios:" << endl;
+    for (size_t i = 0; i < batches.size(); ++i)
+    {
+        cout << "Batch " << (i + 1) << ": " << worst_pnl[i] << " (check: " << scenarios.Price(i, -0.10, -0.05) - base_prices[i] << ")" << endl;
+    }
+
+} catch (const ArrayException& e) {
+    cout << "Error: " << e.GetMessage() << endl;
+} catch (...) {
+    cout << "Unexpected error." << endl;
+}
+cout << "-----------------------------------------------------------------------------------------------------------------" << endl;
+
+// Binary Grids
+cout << "\n===== Group C, Binary Grids =====" << endl;
+
+try
+{
+    // round trip the Group A, Section 2 parameter matrices through the binary format
+    WriteBinaryGrid("pricing_grid.bin", matrixParams);
+
+    vector<double> mapped_prices;
+    {
+        MappedGrid grid("pricing_grid.bin");
+        mapped_prices.resize(grid.Size());
+        PriceBatch("EuropeanCall", grid.Columns(), mapped_prices.data());     // priced straight out of the mapping
+        cout << "Mapped a " << grid.Rows() << " x " << grid.Cols() << " grid" << endl;
+    }
+
+    callMatrix.ComputePriceMatrix();
+    callMatrix.WriteBinary("pricing_results.bin");
+
+    MappedGrid results("pricing_results.bin");
+    double max_diff = 0.0;
+    for (size_t i = 0; i < mapped_prices.size(); ++i)
+    {
+        max_diff = std::max(max_diff, std::abs(mapped_prices[i] - results.Column(0)[i]));
+    }
+    cout << "Max difference between mapped batch prices and PricingMatrix: " << std::scientific << max_diff << std::fixed << endl;
+    cout << "Grid read back matches: " << (ReadBinaryGrid("pricing_grid.bin").GetStrikes() == strikes ? "yes" : "no") << endl;
+
+    std::remove("pricing_grid.bin");
+    std::remove("pricing_results.bin");
+
+} catch (const ArrayException& e) {
+    cout << "Error: " << e.GetMessage() << endl;
+} catch (const std::exception& e) {
+    cout << "Error: " << e.what() << endl;
+} catch (...) {
+    cout << "Unexpected error." << endl;
+}
+cout << "-----------------------------------------------------------------------------------------------------------------" << endl;
+
+// CSV Trade Files
+cout << "\n===== Group C, CSV Trade Files =====" << endl;
+
+try
+{
+    // write a trade file of 200,000 rows cycling through the Group A, Section 1 batches
+    {
+        ofstream trades("trades.csv");
+        trades << "K,r,sig,T,b,spot\n";
+        for (size_t i = 0; i < 200000; ++i)
+        {
+            const OptionData& d = batches[i % batches.size()];
+            trades << d.K() << "," << d.R() << "," << d.Sig() << "," << d.T() << "," << d.B() << "," << a_spots[i % batches.size()] << "\n";
+        }
+    }
+
+    CsvTradeReader reader("trades.csv", 1 << 20, 4);       // 1 MB chunks parsed on 4 threads
+    CsvResultWriter writer("trade_results.csv");
+    writer.WriteHeader(true, true, true);
+
+    TradeBatch trade_batch;
+    vector<double> csv_prices, csv_deltas, csv_gammas;
+    size_t csv_batches = 0;
+    double batch1_call = 0.0;
+
+    while (reader.Next(trade_batch))
+    {
+        csv_prices.resize(trade_batch.Size());
+        csv_deltas.resize(trade_batch.Size());
+        csv_gammas.resize(trade_batch.Size());
+        GreeksBatch("EuropeanCall", trade_batch.Columns(), csv_prices.data(), csv_deltas.data(), csv_gammas.data());
+        writer.Write(trade_batch.Size(), csv_prices.data(), csv_deltas.data(), csv_gammas.data());
+
+        if (trade_batch.FirstRow() == 0) { batch1_call = csv_prices[0]; }
+        ++csv_batches;
+    }
+    writer.Close();
+
+    cout << "Priced " << reader.RowsRead() << " trades in " << csv_batches << " batches" << endl;
+    cout << "Row 1 call price: " << batch1_call << " (expected 2.13337)" << endl;
+
+    std::remove("trades.csv");
+    std::remove("trade_results.csv");
+
+} catch (const ArrayException& e) {
+    cout << "Error: " << e.GetMessage() << endl;
+} catch (const std::exception& e) {
+    cout << "Error: " << e.what() << endl;
+} catch (...) {
+    cout << "Unexpected error." << endl;
+}
+cout << "-----------------------------------------------------------------------------------------------------------------" << endl;
+
+// Perpetual American Greeks
+cout << "\n===== Group C, Perpetual American Greeks =====" << endl;
+
+try
+{
+    // closed form greeks against divided differences, Group B, Section 1 data
+    cout << "Perpetual Call Delta: " << perp_call.Delta(110.0) << " (divided difference: " << perp_call.DividedDifferenceDelta(110.0, 1e-2) << ")" << endl;
+    cout << "Perpetual Call Gamma: " << perp_call.Gamma(110.0) << " (divided difference: " << perp_call.DividedDifferenceGamma(110.0, 1e-2) << ")" << endl;
+    cout << "Perpetual Put Delta: " << perp_put.Delta(110.0) << " (divided difference: " << perp_put.DividedDifferenceDelta(110.0, 1e-2) << ")" << endl;
+    cout << "Perpetual Put Gamma: " << perp_put.Gamma(110.0) << " (divided difference: " << perp_put.DividedDifferenceGamma(110.0, 1e-2) << ")" << endl;
+
+    // price, delta and gamma over the Group B, Section 1, Question C) mesh in one pass
+    vector<double> perp_batch_prices(perp_options_mesh.size()), perp_batch_deltas(perp_options_mesh.size()), perp_batch_gammas(perp_options_mesh.size());
+    perp_call.PriceBatch(perp_options_mesh.data(), perp_options_mesh.size(), perp_batch_prices.data(), perp_batch_deltas.data(), perp_batch_gammas.data());
+
+    cout << "Spot\t\tCall\t\tDelta\t\tGamma" << endl;
+    for (size_t i = 0; i < perp_options_mesh.size(); ++i)
+    {
+        cout << perp_options_mesh[i] << "\t" << perp_batch_prices[i] << "\t" << perp_batch_deltas[i] << "\t" << perp_batch_gammas[i] << endl;
+    }
+
+} catch (const std::exception& e) {
+    cout << "Error: " << e.what() << endl;
+} catch (...) {
+    cout << "Unexpected error." << endl;
+}
+cout << "-----------------------------------------------------------------------------------------------------------------" << endl;
+
+// Batch Validation
+cout << "\n===== Group C, Batch Validation =====" << endl;
+
+try
+{
+    // Group A, Section 2 matrices with a bad spot and a zero vol, the rest of the grid still prices
+    vector<vector<double>> bad_spots = spots;
+    vector<vector<double>> bad_vols = vols;
+    bad_spots[1][2] = -85.0;
+    bad_vols[3][4] = 0.0;
+
+    PricingMatrix bad_matrix(MatrixParameters(strikes, rates, bad_vols, maturities, carry, bad_spots), "EuropeanCall");
+    bad_matrix.ComputeAll();
+    bad_matrix.PrintPriceMatrix();
+
+    cout << "Invalid elements: " << bad_matrix.InvalidCount() << endl;
+    cout << "Status [1][2]: " << static_cast<int>(bad_matrix.GetStatusMatrix()[1][2]) << " (bad spot = " << static_cast<int>(BATCH_BAD_SPOT) << ")" << endl;
+    cout << "Status [3][4]: " << static_cast<int>(bad_matrix.GetStatusMatrix()[3][4]) << " (bad vol = " << static_cast<int>(BATCH_BAD_VOL) << ")" << endl;
+
+} catch (const ArrayException& e) {
+    cout << "Error: " << e.GetMessage() << endl;
+} catch (...) {
+    cout << "Unexpected error." << endl;
+}
+cout << "-----------------------------------------------------------------------------------------------------------------" << endl;
+
+// Sensitivities
+cout << "\n===== Group C, Sensitivities =====" << endl;
+
+try
+{
+    // Group A, Section 1 batch 1 at U = 60, no step size to choose
+    EuropeanCall sens_call(batches[0]);
+    SensitivityEngine call_sens(sens_call, 60.0);
+
+    cout << "Call Delta: " << sens_call.Delta(60.0) << " (complex step: " << call_sens.Delta() << ")" << endl;
+    cout << "Call Gamma: " << sens_call.Gamma(60.0) << " (automatic step: " << call_sens.Gamma() << ")" << endl;
+    cout << "Call Vega: " << call_sens.FirstDerivative(SENS_VOL) << ", Volga: " << call_sens.SecondDerivative(SENS_VOL) << endl;
+    cout << "Call Rho: " << call_sens.FirstDerivative(SENS_RATE) << endl;
+    cout << "Call Theta (dV/dT): " << call_sens.FirstDerivative(SENS_MATURITY) << endl;
+    cout << "Call Carry sensitivity: " << call_sens.FirstDerivative(SENS_CARRY) << endl;
+    cout << "Price evaluations: " << call_sens.Evaluations() << endl;
+
+    // same engine over the perpetual put through the Option interface
+    SensitivityEngine put_sens(perp_put, 110.0);
+    cout << "Perpetual Put Delta: " << perp_put.Delta(110.0) << " (complex step: " << put_sens.Delta() << ")" << endl;
+    cout << "Perpetual Put Gamma: " << perp_put.Gamma(110.0) << " (automatic step: " << put_sens.Gamma() << ")" << endl;
+    cout << "Perpetual Put Vega: " << put_sens.FirstDerivative(SENS_VOL) << endl;
+
+} catch (const std::exception& e) {
+    cout << "Error: " << e.what() << endl;
+} catch (...) {
+    cout << "Unexpected error." << endl;
+}
+cout << "-----------------------------------------------------------------------------------------------------------------" << endl;
+
+// Parity Scanner
+cout << "\n===== Group C, Parity Scanner =====" << endl;
+
+try
+{
+    // one chain per Group A, Section 1 batch, quotes from the closed form at 5 strikes around K and two expiries
+    vector<OptionChain> chains(batches.size());
+    for (size_t i = 0; i < batches.size(); ++i)
+    {
+        chains[i].spot = a_spots[i];
+        chains[i].rate = batches[i].R();
+        chains[i].carry = batches[i].B();
+
+        for (double t_scale : { 1.0, 2.0 })
+        {
+            for (double k_scale : { 0.8, 0.9, 1.0, 1.1, 1.2 })
+            {
+                OptionData quote_data(batches[i].K() * k_scale, batches[i].R(), batches[i].Sig(), batches[i].T() * t_scale, batches[i].B());
+                chains[i].calls.push_back({ quote_data.K(), quote_data.T(), EuropeanCall(quote_data).Price(a_spots[i]) });
+                chains[i].puts.push_back({ quote_data.K(), quote_data.T(), EuropeanPut(quote_data).Price(a_spots[i]) });
+            }
+        }
+    }
+
+    // stale put quote in batch 2 and a call with no matching put in batch 3
+    chains[1].puts[2].price += 0.05;
+    chains[2].calls.push_back({ 12.5, 1.0, 0.1 });
+
+    ParityScanner scanner(1e-3);
+    vector<ParityViolation> violations = scanner.Scan(chains);
+
+    cout << "Pairs checked: " << scanner.PairsChecked() << ", violations: " << violations.size() << endl;
+    for (size_t i = 0; i < violations.size(); ++i)
+    {
+        cout << "Chain " << (violations[i].chain + 1) << ": K = " << violations[i].strike << ", T = " << violations[i].expiry
+             << ", call = " << violations[i].call << ", put = " << violations[i].put << ", residual = " << violations[i].residual << endl;
+    }
+
+} catch (const std::exception& e) {
+    cout << "Error: " << e.what() << endl;
+} catch (...) {
+    cout << "Unexpected error." << endl;
+}
+cout << "-----------------------------------------------------------------------------------------------------------------" << endl;
+
+// Volatility Surface
+cout << "\n===== Group C, Volatility Surface =====" << endl;
+
+try
+{
+    // smile over strikes 80 to 120 at three expiries
+    vector<double> surface_strikes = MeshArray(80.0, 10.0, 5);
+    vector<double> surface_expiries = { 0.25, 0.5, 1.0 };
+    vector<vector<double>> surface_vols =
+    {
+        { 0.32, 0.27, 0.24, 0.25, 0.28 },
+        { 0.30, 0.26, 0.23, 0.24, 0.26 },
+        { 0.28, 0.25, 0.22, 0.23, 0.24 },
+    };
+    VolSurface surface(surface_strikes, surface_expiries, surface_vols);
+
+    cout << "Vol(100, 0.5): " << surface.Vol(100.0, 0.5) << ", Vol(95, 0.75): " << surface.Vol(95.0, 0.75) << ", Vol(130, 2.0): " << surface.Vol(130.0, 2.0) << endl;
+
+    // price a strip of 1y calls at U = 100 straight off the surface through the batch kernel
+    vector<double> strip_strikes = MeshArray(85.0, 5.0, 7);
+    vector<double> strip_rates(strip_strikes.size(), 0.05), strip_maturities(strip_strikes.size(), 0.75), strip_carry(strip_strikes.size(), 0.05), strip_spots(strip_strikes.size(), 100.0);
+    vector<double> strip_vols(strip_strikes.size()), strip_prices(strip_strikes.size());
+
+    GridColumns strip = { strip_strikes.data(), strip_rates.data(), nullptr, strip_maturities.data(), strip_carry.data(), strip_spots.data(), strip_strikes.size() };
+    surface.Apply(strip, strip_vols.data());
+    PriceBatch("EuropeanCall", strip, strip_prices.data());
+
+    cout << "Strike\t\tVol\t\tCall" << endl;
+    for (size_t i = 0; i < strip_strikes.size(); ++i)
+    {
+        cout << strip_strikes[i] << "\t" << strip_vols[i] << "\t\t" << strip_prices[i] << endl;
+    }
+
+    // single contract through the option classes
+    OptionData smile_contract = surface.Contract(OptionData(90.0, 0.05, 0.0, 0.75, 0.05), 100.0);
+    cout << "Put K = 90, T = 0.75 at surface vol " << smile_contract.Sig() << ": " << EuropeanPut(smile_contract).Price(100.0) << endl;
+
+} catch (const ArrayException& e) {
+    cout << "Error: " << e.GetMessage() << endl;
+} catch (const std::exception& e) {
+    cout << "Error: " << e.what() << endl;
+} catch (...) {
+    cout << "Unexpected error." << endl;
+}
+cout << "-----------------------------------------------------------------------------------------------------------------" << endl;
+
+// Yield Curves
+cout << "\n===== Group C, Yield Curves =====" << endl;
+
+try
+{
+    // upward sloping rate curve, carry curve 2% below it (continuous dividend yield of 2%)
+    YieldCurve rate_curve({ 0.25, 0.5, 1.0, 2.0, 5.0 }, { 0.040, 0.045, 0.050, 0.055, 0.060 });
+    YieldCurve carry_curve({ 0.25, 0.5, 1.0, 2.0, 5.0 }, { 0.020, 0.025, 0.030, 0.035, 0.040 });
+
+    cout << "r(0.75): " << rate_curve.ZeroRate(0.75) << ", DF(0.75): " << rate_curve.DiscountFactor(0.75) << ", DF(10): " << rate_curve.DiscountFactor(10.0) << endl;
+
+    // 10 strikes x 4 expiries of calls at U = 100 with vol 25%, one curve point per expiry
+    const size_t curve_strikes = 10;
+    vector<double> curve_expiry_list = { 0.25, 0.75, 1.5, 3.0 };
+    vector<double> curve_k, curve_t;
+    for (size_t j = 0; j < curve_expiry_list.size(); ++j)
+    {
+        for (size_t i = 0; i < curve_strikes; ++i)
+        {
+            curve_k.push_back(80.0 + 5.0 * i);
+            curve_t.push_back(curve_expiry_list[j]);
+        }
+    }
+
+    const size_t curve_n = curve_k.size();
+    vector<double> curve_vols(curve_n, 0.25), curve_spots(curve_n, 100.0), curve_rates(curve_n), curve_carry(curve_n), curve_discounts(curve_n), curve_factors(curve_n), curve_prices(curve_n);
+    GridColumns curve_grid = { curve_k.data(), nullptr, curve_vols.data(), curve_t.data(), nullptr, curve_spots.data(), curve_n };
+
+    CurveCache curve_cache(rate_curve, carry_curve);
+    curve_cache.Apply(curve_grid, curve_rates.data(), curve_carry.data(), curve_discounts.data(), curve_factors.data());
+    GreeksBatch("EuropeanCall", curve_grid, curve_prices.data(), nullptr, nullptr, curve_discounts.data(), curve_factors.data());
+
+    cout << "Contracts: " << curve_n << ", distinct expiries computed: " << curve_cache.Misses() << ", cache hits: " << curve_cache.Hits() << endl;
+    cout << "ATM calls (K = 100): ";
+    for (size_t j = 0; j < curve_expiry_list.size(); ++j)
+    {
+        cout << curve_prices[j * curve_strikes + 4] << " ";
+    }
+    cout << endl;
+
+    // same contract through the option classes
+    OptionData curve_contract = curve_cache.Contract(OptionData(100.0, 0.0, 0.25, 1.5, 0.0));
+    cout << "Call K = 100, T = 1.5 (r = " << curve_contract.R() << ", b = " << curve_contract.B() << "): " << EuropeanCall(curve_contract).Price(100.0) << endl;
+
+} catch (const ArrayException& e) {
+    cout << "Error: " << e.GetMessage() << endl;
+} catch (const std::exception& e) {
+    cout << "Error: " << e.what() << endl;
+} catch (...) {
+    cout << "Unexpected error." << endl;
+}
+cout << "-----------------------------------------------------------------------------------------------------------------" << endl;
+
+// Mesh Views
+cout << "\n===== Group C, Mesh Views =====" << endl;
+
+try
+{
+    // lazy meshes, no vector is built, points are computed on demand
+    UniformMesh<double> uniform_mesh = UniformMesh<double>::Between(0.0, 1.0, 11);
+    GeometricMesh<double> geometric_mesh(50.0, 200.0, 5);
+    ChebyshevMesh<double> chebyshev_mesh(60.0, 140.0, 5);
+    ConcentratedMesh<double> strike_mesh(60.0, 140.0, 9, 100.0, 5.0);       // packed around K = 100
+
+    cout << "Uniform [0, 1], 11 points, point 3: " << uniform_mesh[3] << ", last: " << uniform_mesh.back() << endl;
+    cout << "Geometric: ";
+    for (double x : geometric_mesh) { cout << x << " "; }
+    cout << endl << "Chebyshev: ";
+    for (double x : chebyshev_mesh) { cout << x << " "; }
+    cout << endl << "Concentrated at 100: ";
+    for (double x : strike_mesh) { cout << x << " "; }
+    cout << endl;
+
+    // price straight off a view, Group A, Section 1 batch 2 calls on the concentrated mesh
+    EuropeanCall mesh_call(batches[1]);
+    cout << "Calls on the concentrated mesh: ";
+    for (size_t i = 0; i < strike_mesh.size(); ++i)
+    {
+        cout << mesh_call.Price(strike_mesh[i]) << " ";
+    }
+    cout << endl;
+
+} catch (const ArrayException& e) {
+    cout << "Error: " << e.GetMessage() << endl;
+} catch (const std::exception& e) {
+    cout << "Error: " << e.what() << endl;
+} catch (...) {
+    cout << "Unexpected error." << endl;
+}
+cout << "-----------------------------------------------------------------------------------------------------------------" << endl;
+
+// Fourier Pricing
+cout << "\n===== Group C, Fourier Pricing =====" << endl;
+
+try
+{
+    // one expiry, a whole strike chain per call
+    std::vector<double> fourier_strikes;
+    for (double K = 80.0; K <= 120.0; K += 10.0) { fourier_strikes.push_back(K); }
+    std::vector<double> cos_calls(fourier_strikes.size()), fft_calls(fourier_strikes.size()), cos_puts(fourier_strikes.size());
+
+    // Black-Scholes first so both methods can be checked against the closed form
+    BlackScholesCF bs_cf(0.3, 0.08);
+    CosPrices(bs_cf, true, 100.0, 0.08, 0.25, fourier_strikes.data(), fourier_strikes.size(), cos_calls.data());
+    CosPrices(bs_cf, false, 100.0, 0.08, 0.25, fourier_strikes.data(), fourier_strikes.size(), cos_puts.data());
+    CarrMadanPrices(bs_cf, true, 100.0, 0.08, 0.25, fourier_strikes.data(), fourier_strikes.size(), fft_calls.data());
+
+    cout << "K, COS call, FFT call, closed form call, COS put, closed form put" << endl;
+    for (size_t i = 0; i < fourier_strikes.size(); ++i)
+    {
+        OptionData fourier_data(fourier_strikes[i], 0.08, 0.3, 0.25, 0.08);
+        cout << fourier_strikes[i] << ", " << cos_calls[i] << ", " << fft_calls[i] << ", " << EuropeanCall(fourier_data).Price(100.0)
+             << ", " << cos_puts[i] << ", " << EuropeanPut(fourier_data).Price(100.0) << endl;
+    }
+
+    // stochastic volatility and jumps, no closed form in the engine
+    HestonCF heston_cf(0.0, 1.5768, 0.0398, 0.5751, -0.5711, 0.0175);
+    MertonCF merton_cf(0.15, 0.05, 0.1, -0.9, 0.45);
+
+    CosPrices(heston_cf, true, 100.0, 0.0, 1.0, fourier_strikes.data(), fourier_strikes.size(), cos_calls.data(), 256, 20.0);
+    CarrMadanPrices(heston_cf, true, 100.0, 0.0, 1.0, fourier_strikes.data(), fourier_strikes.size(), fft_calls.data());
+    cout << "Heston calls (COS / FFT): ";
+    for (size_t i = 0; i < fourier_strikes.size(); ++i) { cout << cos_calls[i] << " / " << fft_calls[i] << "  "; }
+    cout << endl;
+
+    CosPrices(merton_cf, true, 100.0, 0.05, 1.0, fourier_strikes.data(), fourier_strikes.size(), cos_calls.data());
+    CarrMadanPrices(merton_cf, true, 100.0, 0.05, 1.0, fourier_strikes.data(), fourier_strikes.size(), fft_calls.data());
+    cout << "Merton calls (COS / FFT): ";
+    for (size_t i = 0; i < fourier_strikes.size(); ++i) { cout << cos_calls[i] << " / " << fft_calls[i] << "  "; }
+    cout << endl;
+
+} catch (const ArrayException& e) {
+    cout << "Error: " << e.GetMessage() << endl;
+} catch (const std::exception& e) {
+    cout << "Error: " << e.what() << endl;
+} catch (...) {
+    cout << "Unexpected error." << endl;
+}
+cout << "-----------------------------------------------------------------------------------------------------------------" << endl;
+
+// American Approximations
+cout << "\n===== Group C, American Approximations =====" << endl;
+
+try
+{
+    // b < r so early exercise of the call has value, compare with the perpetual and european prices
+    OptionData american_data(100.0, 0.08, 0.25, 1.0, -0.04);
+    BaroneAdesiWhaley baw_call(american_data, true);
+    BaroneAdesiWhaley baw_put(american_data, false);
+    BjerksundStensland bs_call(american_data, true);
+    BjerksundStensland bs_put(american_data, false);
+
+    cout << "Critical prices (BAW call / put): " << baw_call.CriticalPrice() << " / " << baw_put.CriticalPrice() << endl;
+    cout << "Exercise prices (BS call / put): " << bs_call.ExercisePrice() << " / " << bs_put.ExercisePrice() << endl;
+    cout << "S, BAW call, BS call, European call, BAW put, BS put, European put" << endl;
+    for (double S = 80.0; S <= 120.0; S += 10.0)
+    {
+        cout << S << ", " << baw_call.Price(S) << ", " << bs_call.Price(S) << ", " << EuropeanCall(american_data).Price(S)
+             << ", " << baw_put.Price(S) << ", " << bs_put.Price(S) << ", " << EuropeanPut(american_data).Price(S) << endl;
+    }
+    cout << "Delta and gamma at S = 100 (BAW call): " << baw_call.Delta(100.0) << ", " << baw_call.Gamma(100.0) << endl;
+
+    // a strike chain through the batch kernel, each critical price is warm started from its neighbour
+    std::vector<double> am_strikes, am_rates, am_vols, am_maturities, am_carry, am_spots;
+    for (double K = 80.0; K <= 120.0; K += 5.0)
+    {
+        am_strikes.push_back(K);
+        am_rates.push_back(0.08);
+        am_vols.push_back(0.25);
+        am_maturities.push_back(1.0);
+        am_carry.push_back(-0.04);
+        am_spots.push_back(100.0);
+    }
+    GridColumns am_grid = { am_strikes.data(), am_rates.data(), am_vols.data(), am_maturities.data(), am_carry.data(), am_spots.data(), am_strikes.size() };
+
+    std::vector<double> am_critical(am_grid.size), am_prices(am_grid.size), am_deltas(am_grid.size);
+    size_t am_iterations = CriticalPriceBatch("BAWAmericanCall", am_grid, am_critical.data());
+    GreeksBatch("BAWAmericanCall", am_grid, am_prices.data(), am_deltas.data(), nullptr);
+
+    cout << "Newton iterations over " << am_grid.size << " strikes: " << am_iterations << endl;
+    cout << "BAW calls (K, S*, price, delta): ";
+    for (size_t i = 0; i < am_grid.size; ++i)
+    {
+        cout << "(" << am_strikes[i] << ", " << am_critical[i] << ", " << am_prices[i] << ", " << am_deltas[i] << ") ";
+    }
+    cout << endl;
+
+    PriceBatch("BSAmericanPut", am_grid, am_prices.data());
+    cout << "BS puts: ";
+    for (size_t i = 0; i < am_grid.size; ++i) { cout << am_prices[i] << " "; }
+    cout << endl;
+
+    // a bad row comes back as NaN, the rest of the grid is still priced
+    std::vector<double> bad_strikes = { 100.0, 100.0, 100.0 }, bad_rates(3, 0.08), bad_vols = { 0.25, 0.0, 0.25 }, bad_maturities = { 1.0, 1.0, 0.0 }, bad_carry(3, -0.04), bad_spots(3, 100.0);
+    GridColumns bad_grid = { bad_strikes.data(), bad_rates.data(), bad_vols.data(), bad_maturities.data(), bad_carry.data(), bad_spots.data(), 3 };
+    std::vector<double> bad_prices(3), bad_deltas(3), bad_gammas(3);
+    std::vector<uint8_t> bad_status(3);
+    const char* bad_types[] = { "BAWAmericanCall", "BAWAmericanPut", "BSAmericanCall", "BSAmericanPut" };
+
+    cout << "Rows (ok, sig = 0, T = 0):" << endl;
+    for (size_t j = 0; j < 4; ++j)
+    {
+        size_t bad_count = ValidateBatch(bad_types[j], bad_grid, bad_status.data());
+        GreeksBatch(bad_types[j], bad_grid, bad_prices.data(), bad_deltas.data(), bad_gammas.data(), bad_status.data());
+        cout << bad_types[j] << ": " << bad_prices[0] << " " << bad_prices[1] << " " << bad_prices[2] << " (" << bad_count << " invalid)" << endl;
+    }
+
+} catch (const ArrayException& e) {
+    cout << "Error: " << e.GetMessage() << endl;
+} catch (const std::exception& e) {
+    cout << "Error: " << e.what() << endl;
+} catch (...) {
+    cout << "Unexpected error." << endl;
+}
+cout << "-----------------------------------------------------------------------------------------------------------------" << endl;
+
+// Chebyshev Proxy
+cout << "\n===== Group C, Chebyshev Proxy =====" << endl;
+
+try
+{
+    // proxy of the Bjerksund-Stensland put over spot, vol and expiry, above the exercise boundary
+    BjerksundStensland proxy_model(OptionData(100.0, 0.05, 0.25, 1.0, 0.05), false);
+    std::vector<ProxyAxis> proxy_axes = { { SENS_SPOT, 100.0, 140.0, 24 }, { SENS_VOL, 0.15, 0.4, 10 }, { SENS_MATURITY, 0.25, 1.0, 10 } };
+    ChebyshevProxy proxy(proxy_model, 100.0, proxy_axes);
+
+    cout << "Coefficients: " << proxy.Size() << ", model evaluations: " << proxy.Evaluations() << endl;
+    cout << "Tail estimate: " << proxy.TailEstimate() << ", test error: " << proxy.TestError() << ", error bound: " << proxy.ErrorBound() << endl;
+
+    // round trip through a file, then compare with the model off the grid
+    proxy.Save("put_proxy.cheb");
+    ChebyshevProxy loaded("put_proxy.cheb");
+    std::remove("put_proxy.cheb");
+
+    cout << "S, vol, T, proxy, model" << endl;
+    const double proxy_points[3][3] = { { 105.0, 0.2, 0.3 }, { 118.0, 0.33, 0.75 }, { 137.0, 0.17, 0.9 } };
+    for (size_t i = 0; i < 3; ++i)
+    {
+        OptionData point_data(100.0, 0.05, proxy_points[i][1], proxy_points[i][2], 0.05);
+        cout << proxy_points[i][0] << ", " << proxy_points[i][1] << ", " << proxy_points[i][2] << ", " << loaded.Price(proxy_points[i][0], point_data)
+             << ", " << BjerksundStensland(point_data, false).Price(proxy_points[i][0]) << endl;
+    }
+
+    // a strike is never an axis, the proxy built for K = 100 refuses a K = 120 contract
+    try
+    {
+        loaded.Price(110.0, OptionData(120.0, 0.05, 0.25, 0.5, 0.05));
+        cout << "Proxy priced a K = 120 contract" << endl;
+    }
+    catch (const std::invalid_argument& e)
+    {
+        cout << "Error: " << e.what() << endl;
+    }
+
+    // outside the declared bounds the proxy refuses to extrapolate
+    loaded.Price(90.0, OptionData(100.0, 0.05, 0.25, 0.5, 0.05));
+
+} catch (const ArrayException& e) {
+    cout << "Error: " << e.GetMessage() << endl;
+} catch (const std::exception& e) {
+    cout << "Error: " << e.what() << endl;
+} catch (...) {
+    cout << "Unexpected error." << endl;
+}
+cout << "-----------------------------------------------------------------------------------------------------------------" << endl;
+
+// Price Cache
+cout << "\n===== Group C, Price Cache =====" << endl;
+
+try
+{
+    PriceCache price_cache(4096, 16);
+
+    // the Group A, Section 2 grid recomputed for three reports, only the first one prices anything
+    for (int report = 0; report < 3; ++report)
+    {
+        PricingMatrix report_matrix(matrixParams, "EuropeanCall");
+        report_matrix.SetCache(&price_cache);
+        report_matrix.ComputeAll();
+    }
+    cout << "Three reports: hits " << price_cache.Hits() << ", misses " << price_cache.Misses() << ", hit rate " << price_cache.HitRate() << endl;
+
+    // the same grid from four threads at once, every thread has its own matrix and shares the cache
+    price_cache.ResetCounters();
+    std::vector<std::thread> report_threads;
+    for (int t = 0; t < 4; ++t)
+    {
+        report_threads.emplace_back([&price_cache, &matrixParams]() {
+            PricingMatrix thread_matrix(matrixParams, "EuropeanPut");
+            thread_matrix.SetCache(&price_cache);
+            thread_matrix.ComputePriceMatrix();
+        });
+    }
+    for (size_t t = 0; t < report_threads.size(); ++t) { report_threads[t].join(); }
+    cout << "Four concurrent put reports: lookups " << price_cache.Hits() + price_cache.Misses() << ", entries " << price_cache.Size() << endl;
+
+    // the incremental pricer consults the same cache on full evaluations
+    IncrementalPricer cached_book;
+    cached_book.SetCache(&price_cache);
+    cached_book.AddPosition("SPX", "EuropeanCall", OptionData(matrixParams.GetStrikes()[0][0], matrixParams.GetRates()[0][0], matrixParams.GetVols()[0][0], matrixParams.GetMaturities()[0][0], matrixParams.GetCarry()[0][0]), matrixParams.GetSpots()[0][0]);
+    price_cache.ResetCounters();
+    cached_book.Reprice();
+    cout << "Incremental pricer full evaluation served from the cache: " << (price_cache.Hits() == 1 ? "yes" : "no") << endl;
+
+    // a small quantized cache, nearby spots share an entry and old entries are evicted
+    PriceCache small_cache(8, 2, 0.01);
+    CachedGreeks greeks = { 1.0, 0.5, 0.01 };
+    for (int i = 0; i < 12; ++i)
+    {
+        small_cache.Insert("EuropeanCall", OptionData(100.0 + i, 0.05, 0.2, 1.0, 0.05), 100.0, greeks);
+    }
+    bool near_hit = small_cache.Find("EuropeanCall", OptionData(111.0, 0.05, 0.2, 1.0, 0.05), 100.001, greeks);
+    cout << "Quantized lookup within tolerance: " << (near_hit ? "hit" : "miss") << ", evictions " << small_cache.Evictions() << ", entries " << small_cache.Size() << endl;
+
+    // only the spot is quantized, an 80bp rate difference is a different contract
+    bool rate_hit = small_cache.Find("EuropeanCall", OptionData(111.0, 0.054, 0.2, 1.0, 0.05), 100.0, greeks);
+    cout << "Lookup with the rate 5.4% instead of 5%: " << (rate_hit ? "hit" : "miss") << endl;
+
+} catch (const ArrayException& e) {
+    cout << "Error: " << e.GetMessage() << endl;
+} catch (const std::exception& e) {
+    cout << "Error: " << e.what() << endl;
+} catch (...) {
+    cout << "Unexpected error." << endl;
+}
+cout << "-----------------------------------------------------------------------------------------------------------------" << endl;
+
+// Result Snapshots
+cout << "\n===== Group C, Result Snapshots =====" << endl;
+
+try
+{
+    PricingMatrix live_matrix(matrixParams, "EuropeanCall");
+    live_matrix.ComputeAll();
+
+    // two dashboard threads read while the pricer recomputes, every snapshot must be a complete set
+    std::atomic<bool> pricing(true);
+    std::atomic<size_t> torn(0);
+    std::vector<std::thread> dashboards;
+
+    for (int t = 0; t < 2; ++t)
+    {
+        dashboards.emplace_back([&]() {
+            uint64_t last = 0;
+            while (pricing.load())
+            {
+                const uint64_t published = live_matrix.Version();      // any thread, a snapshot acquired afterwards is at least this new
+                SnapshotHandle<PricingSnapshot> view = live_matrix.Snapshot();
+                bool complete = !view->prices.empty() && view->prices.size() == view->deltas.size() && view->prices.size() == view->gammas.size();
+                for (size_t i = 0; complete && i < view->prices.size(); ++i)
+                {
+                    complete = view->prices[i].size() == view->deltas[i].size() && view->prices[i].size() == view->gammas[i].size();
+                }
+                if (!complete || view.Version() < last || view.Version() < published) { ++torn; }
+                last = view.Version();
+            }
+        });
+    }
+
+    for (int i = 0; i < 500; ++i)
+    {
+        live_matrix.ComputeAll();
+    }
+    pricing.store(false);
+    for (size_t t = 0; t < dashboards.size(); ++t) { dashboards[t].join(); }
+
+    cout << "Published versions: " << live_matrix.Version() << ", torn or out of order reads: " << torn.load() << endl;
+
+    // a held snapshot stays valid while newer results are published
+    SnapshotHandle<PricingSnapshot> held = live_matrix.Snapshot();
+    live_matrix.ComputePriceMatrix();
+    cout << "Held version " << held.Version() << " still readable after version " << live_matrix.Version() << ", first price " << held->prices[0][0] << endl;
+
+} catch (const ArrayException& e) {
+    cout << "Error: " << e.GetMessage() << endl;
+} catch (const std::exception& e) {
+    cout << "Error: " << e.what() << endl;
+} catch (...) {
+    cout << "Unexpected error." << endl;
+}
+cout << "-----------------------------------------------------------------------------------------------------------------" << endl;
+
+// Pricing Jobs
+cout << "\n===== Group C, Pricing Jobs =====" << endl;
+
+try
+{
+    JobExecutor executor(2);
+
+    // a large report grid as a batch job, 200 rows of 2000 calls
+    std::vector<std::vector<double>> job_strikes(200), job_rates(200), job_vols(200), job_maturities(200), job_carry(200), job_spots(200);
+    for (size_t i = 0; i < 200; ++i)
+    {
+        for (size_t j = 0; j < 2000; ++j)
+        {
+            job_strikes[i].push_back(50.0 + 0.05 * j);
+            job_rates[i].push_back(0.05);
+            job_vols[i].push_back(0.1 + 0.002 * i);
+            job_maturities[i].push_back(1.0);
+            job_carry[i].push_back(0.05);
+            job_spots[i].push_back(100.0);
+        }
+    }
+    MatrixParameters job_params(job_strikes, job_rates, job_vols, job_maturities, job_carry, job_spots);
+
+    std::atomic<size_t> rows_reported(0);
+    CancellationToken report_token;
+    std::future<PricingSnapshot> report = SubmitGrid(executor, job_params, "EuropeanCall", PRIORITY_BATCH, report_token,
+                                                     [&rows_reported](size_t done, size_t total) { (void)total; rows_reported = done; });
+
+    // a tick on a live book arrives while the report is running and goes ahead of the remaining rows
+    IncrementalPricer tick_book;
+    tick_book.AddPosition("SPX", "EuropeanCall", OptionData(100.0, 0.05, 0.2, 1.0, 0.05), 100.0);
+    tick_book.AddPosition("SPX", "EuropeanPut", OptionData(100.0, 0.05, 0.2, 1.0, 0.05), 100.0);
+    std::future<size_t> tick = SubmitReprice(executor, tick_book);
+    tick.wait();
+    bool tick_first = (report.wait_for(std::chrono::seconds(0)) != std::future_status::ready);
+
+    PricingSnapshot report_result = report.get();
+    cout << "Tick repriced " << tick.get() << " positions before the batch grid finished: " << (tick_first ? "yes" : "no") << endl;
+    cout << "Batch grid rows reported: " << rows_reported.load() << ", ATM call in the last row: " << report_result.prices[199][1000] << endl;
+
+    // the book value as a job matches the synchronous call
+    CancellationToken book_token;
+    std::future<double> book_value = SubmitBookValue(executor, tick_book, PRIORITY_INTERACTIVE, book_token);
+    cout << "Book value (async / sync): " << book_value.get() << " / " << tick_book.BookValue() << endl;
+
+    // cancelled before it runs, the future reports it
+    CancellationToken cancel_token;
+    cancel_token.Cancel();
+    std::future<PricingSnapshot> cancelled = SubmitGrid(executor, job_params, "EuropeanPut", PRIORITY_BATCH, cancel_token);
+    try
+    {
+        cancelled.get();
+        cout << "Cancelled grid: completed" << endl;
+    }
+    catch (const JobCancelledException& e)
+    {
+        cout << "Cancelled grid: " << e.what() << endl;
+    }
+
+    // errors raised inside a job arrive through its future
+    std::future<PricingSnapshot> bad_type = SubmitGrid(executor, job_params, "BermudanCall", PRIORITY_BATCH, CancellationToken());
+    bad_type.get();
+
+} catch (const ArrayException& e) {
+    cout << "Error: " << e.GetMessage() << endl;
+} catch (const std::exception& e) {
+    cout << "Error: " << e.what() << endl;
+} catch (...) {
+    cout << "Unexpected error." << endl;
+}
 cout << "-----------------------------------------------------------------------------------------------------------------" << endl;
 
     return 0;
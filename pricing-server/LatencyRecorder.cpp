@@ -0,0 +1,127 @@
+#include "LatencyRecorder.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace AidanRicher {
+namespace Server {
+
+namespace {
+
+const double LOWEST_MICROS = 0.1;           // lower edge of the first log-spaced bucket
+const size_t BUCKETS_PER_DECADE = 32;       // bucket width 10^(1/32), about 7.5%
+const size_t DECADES = 9;                   // 0.1 us to 100 s
+const size_t LOG_BUCKETS = BUCKETS_PER_DECADE * DECADES;
+const size_t BUCKETS = LOG_BUCKETS + 2;     // plus underflow and overflow
+
+} // namespace
+
+// default constructor
+LatencyRecorder::LatencyRecorder() : m_buckets(BUCKETS, 0), m_count(0), m_sum(0.0), m_min(0.0), m_max(0.0) { }
+
+// destructor
+LatencyRecorder::~LatencyRecorder() { }
+
+size_t LatencyRecorder::Bucket(const double micros)
+{ // 0 is the underflow bucket, BUCKETS - 1 the overflow bucket
+    if (!(micros >= LOWEST_MICROS)) { return 0; }
+
+    double position = std::log10(micros / LOWEST_MICROS) * static_cast<double>(BUCKETS_PER_DECADE);
+    if (position >= static_cast<double>(LOG_BUCKETS)) { return BUCKETS - 1; }
+
+    return 1 + static_cast<size_t>(position);
+}
+
+void LatencyRecorder::Record(const double micros)
+{
+    size_t bucket = Bucket(micros);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ++m_buckets[bucket];
+    m_min = (m_count == 0) ? micros : std::min(m_min, micros);
+    m_max = (m_count == 0) ? micros : std::max(m_max, micros);
+    m_sum += micros;
+    ++m_count;
+}
+
+void LatencyRecorder::Merge(const LatencyRecorder& other)
+{
+    if (this == &other) { return; }
+
+    std::vector<size_t> buckets;
+    size_t count;
+    double sum, lowest, highest;
+    {
+        std::lock_guard<std::mutex> lock(other.m_mutex);
+        buckets = other.m_buckets;
+        count = other.m_count;
+        sum = other.m_sum;
+        lowest = other.m_min;
+        highest = other.m_max;
+    }
+
+    if (count == 0) { return; }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (size_t i = 0; i < BUCKETS; ++i)
+    {
+        m_buckets[i] += buckets[i];
+    }
+
+    m_min = (m_count == 0) ? lowest : std::min(m_min, lowest);
+    m_max = (m_count == 0) ? highest : std::max(m_max, highest);
+    m_sum += sum;
+    m_count += count;
+}
+
+void LatencyRecorder::Reset()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::fill(m_buckets.begin(), m_buckets.end(), 0);
+    m_count = 0;
+    m_sum = 0.0;
+    m_min = 0.0;
+    m_max = 0.0;
+}
+
+size_t LatencyRecorder::Count() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_count;
+}
+
+double LatencyRecorder::Percentile(const double p) const
+{ // walk the cumulative counts to the nearest rank, no copy of the samples
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_count == 0) { return 0.0; }
+
+    double clamped = std::min(100.0, std::max(0.0, p));
+    size_t rank = static_cast<size_t>(std::ceil(clamped / 100.0 * static_cast<double>(m_count)));
+    if (rank == 0) { rank = 1; }
+
+    size_t bucket = 0;
+    size_t seen = m_buckets[0];
+    while (seen < rank && bucket + 1 < BUCKETS)
+    {
+        seen += m_buckets[++bucket];
+    }
+
+    if (bucket == 0) { return m_min; }
+    if (bucket == BUCKETS - 1) { return m_max; }
+
+    // geometric centre of bucket [LOWEST * 10^((bucket - 1) / n), LOWEST * 10^(bucket / n))
+    double centre = LOWEST_MICROS * std::pow(10.0, (static_cast<double>(bucket) - 0.5) / static_cast<double>(BUCKETS_PER_DECADE));
+    return std::min(m_max, std::max(m_min, centre));
+}
+
+double LatencyRecorder::Mean() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_count == 0) { return 0.0; }
+
+    return m_sum / static_cast<double>(m_count);
+}
+
+} // namespace Server
+} // namespace AidanRicher
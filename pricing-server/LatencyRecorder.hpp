@@ -0,0 +1,59 @@
+#ifndef LatencyRecorder_HPP
+#define LatencyRecorder_HPP
+
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+namespace AidanRicher {
+namespace Server {
+
+// thread-safe latency histogram (microseconds) with percentile queries
+// samples land in log-spaced buckets, 32 per decade from 0.1 us to 100 s, so memory stays fixed
+// for the life of the service and percentiles are within about 4% of the exact sample value
+class LatencyRecorder {
+    private:
+        mutable std::mutex m_mutex;
+        std::vector<size_t> m_buckets;      // underflow, log-spaced buckets, overflow
+        size_t m_count;                     // samples recorded
+        double m_sum;                       // exact sum for the mean
+        double m_min;                       // smallest sample, bounds the lowest bucket
+        double m_max;                       // largest sample, bounds the highest bucket
+
+        static size_t Bucket(const double micros);      // bucket index of a sample
+
+    public:
+        // default constructor
+        LatencyRecorder();
+
+        // non-copyable, shared between threads
+        LatencyRecorder(const LatencyRecorder& other) = delete;
+        LatencyRecorder& operator = (const LatencyRecorder& other) = delete;
+
+        // destructor
+        ~LatencyRecorder();
+
+        // record one sample
+        void Record(const double micros);
+
+        // merge all samples from another recorder, bucket by bucket
+        void Merge(const LatencyRecorder& other);
+
+        // discard all samples
+        void Reset();
+
+        // number of samples recorded
+        size_t Count() const;
+
+        // p-th percentile for p in [0, 100], nearest rank bucket, 0 if empty
+        // returns the geometric centre of that bucket clamped to the observed min and max
+        double Percentile(const double p) const;
+
+        // mean of all samples, 0 if empty
+        double Mean() const;
+};
+
+} // namespace Server
+} // namespace AidanRicher
+
+#endif // LatencyRecorder_HPP
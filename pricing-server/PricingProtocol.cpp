@@ -0,0 +1,45 @@
+#include "PricingProtocol.hpp"
+#include <cerrno>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+namespace AidanRicher {
+namespace Server {
+
+bool ReadFull(const int fd, void* data, size_t bytes)
+{
+    char* p = static_cast<char*>(data);
+
+    while (bytes > 0)
+    {
+        ssize_t n = ::read(fd, p, bytes);
+        if (n < 0 && errno == EINTR) { continue; }
+        if (n <= 0) { return false; }       // error or peer closed
+
+        p += n;
+        bytes -= static_cast<size_t>(n);
+    }
+
+    return true;
+}
+
+bool WriteFull(const int fd, const void* data, size_t bytes)
+{
+    const char* p = static_cast<const char*>(data);
+
+    while (bytes > 0)
+    {
+        ssize_t n = ::send(fd, p, bytes, MSG_NOSIGNAL);     // no SIGPIPE if the peer went away
+        if (n < 0 && errno == EINTR) { continue; }
+        if (n <= 0) { return false; }
+
+        p += n;
+        bytes -= static_cast<size_t>(n);
+    }
+
+    return true;
+}
+
+} // namespace Server
+} // namespace AidanRicher
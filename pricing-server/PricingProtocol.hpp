@@ -0,0 +1,84 @@
+#ifndef PricingProtocol_HPP
+#define PricingProtocol_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace AidanRicher {
+namespace Server {
+
+// wire format between PricingClient and PricingServer over a unix domain socket (native byte order, same host only)
+//   request:   RequestHeader, then count ContractRecord
+//   response:  ResponseHeader, then count ResultRecord (none if status != STATUS_OK)
+
+const uint32_t REQUEST_MAGIC = 0x4F504652;      // "OPFR"
+const uint32_t RESPONSE_MAGIC = 0x4F504653;     // "OPFS"
+const uint64_t MAX_REQUEST_CONTRACTS = 1 << 20; // larger requests are rejected
+
+// option type codes, see OptionTypeName()
+enum OptionTypeCode : uint32_t {
+    EUROPEAN_CALL = 0,
+    EUROPEAN_PUT = 1,
+    PERP_AMERICAN_CALL = 2,
+    PERP_AMERICAN_PUT = 3,
+    OPTION_TYPE_COUNT = 4
+};
+
+// response status codes
+enum ResponseStatus : uint32_t {
+    STATUS_OK = 0,
+    STATUS_BAD_TYPE = 1,
+    STATUS_TOO_LARGE = 2,
+    STATUS_ERROR = 3
+};
+
+struct RequestHeader {
+    uint32_t magic;             // REQUEST_MAGIC
+    uint32_t optionType;        // OptionTypeCode
+    uint64_t requestId;         // echoed back in the response
+    uint64_t count;             // number of ContractRecord that follow
+};
+
+struct ContractRecord {
+    double k;                   // strike price
+    double r;                   // interest rate
+    double sig;                 // volatility
+    double t;                   // time to expiry
+    double b;                   // cost of carry
+    double spot;                // underlying spot price
+};
+
+struct ResponseHeader {
+    uint32_t magic;             // RESPONSE_MAGIC
+    uint32_t status;            // ResponseStatus
+    uint64_t requestId;         // id of the request being answered
+    uint64_t count;             // number of ResultRecord that follow
+};
+
+struct ResultRecord {
+    double price;
+    double delta;
+    double gamma;
+};
+
+// PricingMatrix style type names used by the batch kernels
+inline const char* OptionTypeName(const uint32_t code)
+{
+    switch (code)
+    {
+        case EUROPEAN_CALL: return "EuropeanCall";
+        case EUROPEAN_PUT: return "EuropeanPut";
+        case PERP_AMERICAN_CALL: return "PerpAmericanCall";
+        case PERP_AMERICAN_PUT: return "PerpAmericanPut";
+        default: return "";
+    }
+}
+
+// blocking socket helpers, retry on EINTR and short transfers, false on error or closed peer
+bool ReadFull(const int fd, void* data, size_t bytes);
+bool WriteFull(const int fd, const void* data, size_t bytes);
+
+} // namespace Server
+} // namespace AidanRicher
+
+#endif // PricingProtocol_HPP
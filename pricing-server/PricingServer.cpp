@@ -0,0 +1,411 @@
+#include "PricingServer.hpp"
+#include "../option-pricing-boost-cpp/BatchPricer.hpp"
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace AidanRicher::Engine;
+
+namespace AidanRicher {
+namespace Server {
+
+namespace {
+
+// fill a unix socket address, throws if the path does not fit
+sockaddr_un SocketAddress(const std::string& path)
+{
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+
+    if (path.size() >= sizeof(address.sun_path))
+    {
+        throw std::runtime_error("Socket path too long '" + path + "'");
+    }
+
+    std::memcpy(address.sun_path, path.c_str(), path.size());
+    return address;
+}
+
+double MicrosSince(const std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// PricingServer                                                                                                   //
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+PricingServer::Connection::~Connection()
+{
+    ::close(fd);
+}
+
+// parameter constructor
+PricingServer::PricingServer(const std::string& path, const unsigned workers, const size_t maxBatch, const unsigned lingerMicros)
+: m_path(path), m_workers(workers), m_maxBatch(maxBatch == 0 ? 1 : maxBatch), m_linger(lingerMicros), m_listenFd(-1), m_running(false), m_activeReaders(0), m_requests(0), m_contracts(0), m_batches(0)
+{
+    if (m_workers == 0) { m_workers = std::thread::hardware_concurrency(); }
+    if (m_workers == 0) { m_workers = 1; }
+}
+
+// destructor
+PricingServer::~PricingServer()
+{
+    Stop();
+}
+
+void PricingServer::Start()
+{
+    if (m_running) { return; }
+
+    sockaddr_un address = SocketAddress(m_path);
+
+    m_listenFd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (m_listenFd < 0)
+    {
+        throw std::runtime_error(std::string("Failed to create socket: ") + std::strerror(errno));
+    }
+
+    ::unlink(m_path.c_str());       // stale socket from a previous run
+    if (::bind(m_listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || ::listen(m_listenFd, 128) != 0)
+    {
+        int error = errno;
+        ::close(m_listenFd);
+        m_listenFd = -1;
+        throw std::runtime_error("Failed to listen on '" + m_path + "': " + std::strerror(error));
+    }
+
+    m_running = true;
+    m_acceptor = std::thread(&PricingServer::AcceptLoop, this);
+
+    for (unsigned i = 0; i < m_workers; ++i)
+    {
+        m_pool.push_back(std::thread(&PricingServer::WorkerLoop, this));
+    }
+}
+
+void PricingServer::Stop()
+{
+    if (!m_running.exchange(false)) { return; }
+
+    // unblock accept() and every blocked read()
+    ::shutdown(m_listenFd, SHUT_RDWR);
+    m_acceptor.join();
+    ::close(m_listenFd);
+    m_listenFd = -1;
+
+    {
+        std::unique_lock<std::mutex> lock(m_connectionMutex);
+        for (size_t i = 0; i < m_connections.size(); ++i)
+        {
+            std::shared_ptr<Connection> connection = m_connections[i].lock();
+            if (connection) { ::shutdown(connection->fd, SHUT_RDWR); }
+        }
+        m_readersDone.wait(lock, [this]() { return m_activeReaders == 0; });
+        m_connections.clear();
+    }
+
+    // workers drain what is already queued, then exit
+    m_queueReady.notify_all();
+    for (size_t i = 0; i < m_pool.size(); ++i)
+    {
+        m_pool[i].join();
+    }
+    m_pool.clear();
+
+    ::unlink(m_path.c_str());
+}
+
+void PricingServer::AcceptLoop()
+{
+    while (m_running)
+    {
+        int fd = ::accept(m_listenFd, nullptr, nullptr);
+        if (fd < 0)
+        {
+            if (errno == EINTR || errno == ECONNABORTED) { continue; }
+            break;      // listening socket closed by Stop()
+        }
+
+        std::shared_ptr<Connection> connection = std::make_shared<Connection>(fd);
+
+        std::lock_guard<std::mutex> lock(m_connectionMutex);
+        if (!m_running)
+        {
+            break;
+        }
+
+        // forget closed connections
+        for (size_t i = 0; i < m_connections.size(); )
+        {
+            if (m_connections[i].expired())
+            {
+                m_connections[i] = m_connections.back();
+                m_connections.pop_back();
+            }
+            else { ++i; }
+        }
+
+        m_connections.push_back(connection);
+        ++m_activeReaders;
+        std::thread(&PricingServer::ReadLoop, this, connection).detach();
+    }
+}
+
+void PricingServer::ReadLoop(std::shared_ptr<Connection> connection)
+{
+    RequestHeader header;
+
+    while (ReadFull(connection->fd, &header, sizeof(header)))
+    {
+        if (header.magic != REQUEST_MAGIC)
+        { // out of sync with the client, nothing sensible to reply
+            break;
+        }
+
+        PendingRequest request;
+        request.connection = connection;
+        request.header = header;
+
+        if (header.count > MAX_REQUEST_CONTRACTS)
+        { // payload can't be skipped safely, reject and drop the connection
+            Reply(request, STATUS_TOO_LARGE, nullptr);
+            break;
+        }
+
+        request.contracts.resize(static_cast<size_t>(header.count));
+        if (!ReadFull(connection->fd, request.contracts.data(), request.contracts.size() * sizeof(ContractRecord)))
+        {
+            break;
+        }
+        request.received = std::chrono::steady_clock::now();
+
+        if (header.optionType >= OPTION_TYPE_COUNT)
+        {
+            Reply(request, STATUS_BAD_TYPE, nullptr);
+            continue;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_queueMutex);
+            m_queue.push_back(std::move(request));
+        }
+        m_queueReady.notify_one();
+    }
+
+    connection.reset();
+
+    std::lock_guard<std::mutex> lock(m_connectionMutex);
+    --m_activeReaders;
+    m_readersDone.notify_all();
+}
+
+void PricingServer::WorkerLoop()
+{
+    std::vector<PendingRequest> batch;
+
+    while (true)
+    {
+        batch.clear();
+
+        {
+            std::unique_lock<std::mutex> lock(m_queueMutex);
+            m_queueReady.wait(lock, [this]() { return !m_queue.empty() || !m_running; });
+
+            if (m_queue.empty()) { return; }     // stopped and drained
+
+            // the oldest request decides the type, then same-type requests are pulled in queue order
+            const uint32_t type = m_queue.front().header.optionType;
+            size_t contracts = 0;
+            bool lingered = false;
+
+            while (true)
+            {
+                for (std::deque<PendingRequest>::iterator itr = m_queue.begin(); itr != m_queue.end() && contracts < m_maxBatch; )
+                {
+                    if (itr->header.optionType == type)
+                    {
+                        contracts += itr->contracts.size();
+                        batch.push_back(std::move(*itr));
+                        itr = m_queue.erase(itr);
+                    }
+                    else { ++itr; }
+                }
+
+                // a short wait lets requests that are in flight join a small batch
+                if (lingered || contracts >= m_maxBatch || m_linger.count() == 0 || !m_running) { break; }
+                lingered = true;
+                m_queueReady.wait_for(lock, m_linger);
+            }
+        }
+
+        PriceCoalesced(batch);
+    }
+}
+
+void PricingServer::PriceCoalesced(std::vector<PendingRequest>& batch)
+{
+    // columns are reused across batches on the same worker
+    thread_local std::vector<double> strikes, rates, vols, maturities, carry, spots;
+    thread_local std::vector<double> prices, deltas, gammas;
+    thread_local std::vector<ResultRecord> results;
+    thread_local std::vector<uint8_t> status;
+
+    size_t total = 0;
+    for (size_t i = 0; i < batch.size(); ++i) { total += batch[i].contracts.size(); }
+
+    strikes.resize(total); rates.resize(total); vols.resize(total); maturities.resize(total); carry.resize(total); spots.resize(total);
+    prices.resize(total); deltas.resize(total); gammas.resize(total); status.resize(total);
+
+    size_t n = 0;
+    for (size_t i = 0; i < batch.size(); ++i)
+    {
+        const std::vector<ContractRecord>& contracts = batch[i].contracts;
+        for (size_t j = 0; j < contracts.size(); ++j, ++n)
+        {
+            strikes[n] = contracts[j].k;
+            rates[n] = contracts[j].r;
+            vols[n] = contracts[j].sig;
+            maturities[n] = contracts[j].t;
+            carry[n] = contracts[j].b;
+            spots[n] = contracts[j].spot;
+        }
+    }
+
+    uint32_t reply = STATUS_OK;
+    try
+    { // invalid contracts come back as NaN rather than failing the whole coalesced batch
+        GridColumns grid = { strikes.data(), rates.data(), vols.data(), maturities.data(), carry.data(), spots.data(), total };
+        const char* type = OptionTypeName(batch[0].header.optionType);
+        ValidateBatch(type, grid, status.data());
+        GreeksBatch(type, grid, prices.data(), deltas.data(), gammas.data(), status.data());
+    }
+    catch (...)
+    {
+        reply = STATUS_ERROR;
+    }
+
+    ++m_batches;
+    m_contracts += total;
+
+    // split the results back out to each request
+    size_t offset = 0;
+    for (size_t i = 0; i < batch.size(); ++i)
+    {
+        size_t count = batch[i].contracts.size();
+        results.resize(count);
+
+        for (size_t j = 0; j < count; ++j)
+        {
+            results[j].price = prices[offset + j];
+            results[j].delta = deltas[offset + j];
+            results[j].gamma = gammas[offset + j];
+        }
+
+        Reply(batch[i], reply, results.data());
+        offset += count;
+    }
+}
+
+void PricingServer::Reply(PendingRequest& request, const uint32_t status, const ResultRecord* results)
+{
+    ResponseHeader header;
+    header.magic = RESPONSE_MAGIC;
+    header.status = status;
+    header.requestId = request.header.requestId;
+    header.count = (status == STATUS_OK) ? request.contracts.size() : 0;
+
+    {
+        std::lock_guard<std::mutex> lock(request.connection->writeMutex);
+        // a failed write means the client went away, its reader thread cleans up
+        if (WriteFull(request.connection->fd, &header, sizeof(header)) && header.count > 0)
+        {
+            WriteFull(request.connection->fd, results, static_cast<size_t>(header.count) * sizeof(ResultRecord));
+        }
+    }
+
+    m_latency.Record(MicrosSince(request.received));
+    ++m_requests;
+}
+
+ServerStats PricingServer::Stats() const
+{
+    ServerStats stats;
+    stats.requests = m_requests;
+    stats.contracts = m_contracts;
+    stats.batches = m_batches;
+    stats.meanBatchSize = (stats.batches > 0) ? static_cast<double>(stats.contracts) / static_cast<double>(stats.batches) : 0.0;
+    stats.p50Micros = m_latency.Percentile(50.0);
+    stats.p99Micros = m_latency.Percentile(99.0);
+
+    return stats;
+}
+
+void PricingServer::ResetStats()
+{
+    m_latency.Reset();
+    m_requests = 0;
+    m_contracts = 0;
+    m_batches = 0;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// PricingClient                                                                                                   //
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// parameter constructor
+PricingClient::PricingClient(const std::string& path) : m_fd(-1), m_nextId(1)
+{
+    sockaddr_un address = SocketAddress(path);
+
+    m_fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (m_fd < 0 || ::connect(m_fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0)
+    {
+        int error = errno;
+        if (m_fd >= 0) { ::close(m_fd); }
+        throw std::runtime_error("Failed to connect to '" + path + "': " + std::strerror(error));
+    }
+}
+
+// destructor
+PricingClient::~PricingClient()
+{
+    ::close(m_fd);
+}
+
+uint32_t PricingClient::Price(const OptionTypeCode type, const std::vector<ContractRecord>& contracts, std::vector<ResultRecord>& results)
+{
+    RequestHeader request;
+    request.magic = REQUEST_MAGIC;
+    request.optionType = type;
+    request.requestId = m_nextId++;
+    request.count = contracts.size();
+
+    if (!WriteFull(m_fd, &request, sizeof(request)) || !WriteFull(m_fd, contracts.data(), contracts.size() * sizeof(ContractRecord)))
+    {
+        throw std::runtime_error("Lost connection to pricing server");
+    }
+
+    ResponseHeader response;
+    if (!ReadFull(m_fd, &response, sizeof(response)) || response.magic != RESPONSE_MAGIC || response.requestId != request.requestId)
+    {
+        throw std::runtime_error("Invalid response from pricing server");
+    }
+
+    results.resize(static_cast<size_t>(response.count));
+    if (!ReadFull(m_fd, results.data(), results.size() * sizeof(ResultRecord)))
+    {
+        throw std::runtime_error("Lost connection to pricing server");
+    }
+
+    return response.status;
+}
+
+} // namespace Server
+} // namespace AidanRicher
@@ -0,0 +1,129 @@
+#ifndef PricingServer_HPP
+#define PricingServer_HPP
+
+#include "PricingProtocol.hpp"
+#include "LatencyRecorder.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace AidanRicher {
+namespace Server {
+
+// summary of server activity since start
+struct ServerStats {
+    uint64_t requests;          // requests answered
+    uint64_t contracts;         // contracts priced
+    uint64_t batches;           // kernel calls, each covering one or more coalesced requests
+    double meanBatchSize;       // contracts per kernel call
+    double p50Micros;           // request latency, receipt to reply sent
+    double p99Micros;
+};
+
+// long-lived local pricing service on a unix domain socket
+// connection threads read requests into a shared queue, pricing workers drain the queue and coalesce
+// queued requests of the same option type into one batch kernel call before replying to each client
+class PricingServer {
+    private:
+        struct Connection {
+            int fd;
+            std::mutex writeMutex;      // replies from different workers must not interleave
+
+            explicit Connection(const int socket) : fd(socket) { }
+            ~Connection();
+        };
+
+        struct PendingRequest {
+            std::shared_ptr<Connection> connection;
+            RequestHeader header;
+            std::vector<ContractRecord> contracts;
+            std::chrono::steady_clock::time_point received;
+        };
+
+        std::string m_path;                 // socket path
+        unsigned m_workers;                 // pricing worker threads
+        size_t m_maxBatch;                  // contracts per coalesced kernel call
+        std::chrono::microseconds m_linger; // time a worker waits for more requests to coalesce
+
+        int m_listenFd;
+        std::atomic<bool> m_running;
+        std::thread m_acceptor;
+        std::vector<std::thread> m_pool;
+
+        std::mutex m_connectionMutex;
+        std::condition_variable m_readersDone;
+        size_t m_activeReaders;                                 // detached connection threads still running
+        std::vector<std::weak_ptr<Connection>> m_connections;   // open connections, shut down on Stop()
+
+        std::mutex m_queueMutex;
+        std::condition_variable m_queueReady;
+        std::deque<PendingRequest> m_queue;
+
+        LatencyRecorder m_latency;
+        std::atomic<uint64_t> m_requests;
+        std::atomic<uint64_t> m_contracts;
+        std::atomic<uint64_t> m_batches;
+
+        void AcceptLoop();
+        void ReadLoop(std::shared_ptr<Connection> connection);
+        void WorkerLoop();
+        void PriceCoalesced(std::vector<PendingRequest>& batch);     // one kernel call for a group of same-type requests
+        void Reply(PendingRequest& request, const uint32_t status, const ResultRecord* results);
+
+    public:
+        // parameter constructor
+        // workers = 0 uses the hardware concurrency, maxBatch caps contracts per coalesced kernel call
+        PricingServer(const std::string& path, const unsigned workers = 0, const size_t maxBatch = 4096, const unsigned lingerMicros = 50);
+
+        // non-copyable, owns sockets and threads
+        PricingServer(const PricingServer& other) = delete;
+        PricingServer& operator = (const PricingServer& other) = delete;
+
+        // destructor, stops the server if running
+        ~PricingServer();
+
+        // bind the socket and start accepting, throws std::runtime_error if the socket can't be created
+        void Start();
+
+        // stop accepting, close all connections and join every thread
+        void Stop();
+
+        // activity since start
+        ServerStats Stats() const;
+
+        // reset the counters and latency samples, e.g. after a warm-up run
+        void ResetStats();
+};
+
+// blocking client for PricingServer, one outstanding request per client
+class PricingClient {
+    private:
+        int m_fd;
+        uint64_t m_nextId;
+
+    public:
+        // parameter constructor, connects to the server socket
+        explicit PricingClient(const std::string& path);
+
+        // non-copyable, owns the socket
+        PricingClient(const PricingClient& other) = delete;
+        PricingClient& operator = (const PricingClient& other) = delete;
+
+        // destructor, closes the connection
+        ~PricingClient();
+
+        // price contracts of one type, results[i] answers contracts[i]
+        // returns the response status, results are only filled on STATUS_OK
+        uint32_t Price(const OptionTypeCode type, const std::vector<ContractRecord>& contracts, std::vector<ResultRecord>& results);
+};
+
+} // namespace Server
+} // namespace AidanRicher
+
+#endif // PricingServer_HPP
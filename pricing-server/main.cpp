@@ -0,0 +1,143 @@
+/* 
+Title: Local Pricing Service
+Author: Aidan Richer (2025)
+
+Runs the batch pricing kernels behind a unix domain socket and measures throughput under concurrent load.
+
+Usage:
+- pricing_server serve <socket> [workers] [max batch] [linger us]     run the server until stdin closes
+- pricing_server load <socket> [clients] [requests] [contracts]       load generator against a running server
+- pricing_server                                                       in-process server and load generator on /tmp
+*/
+
+#include "PricingServer.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace AidanRicher::Server;
+
+void PrintServerStats(const ServerStats& stats)
+{
+    cout << "Requests: " << stats.requests << ", contracts: " << stats.contracts << ", kernel calls: " << stats.batches << endl;
+    cout << "Mean coalesced batch: " << stats.meanBatchSize << " contracts" << endl;
+    cout << "Server latency p50: " << stats.p50Micros << " us, p99: " << stats.p99Micros << " us" << endl;
+}
+
+void RunLoad(const string& path, const size_t clients, const size_t requests, const size_t contracts)
+{ // each client thread sends requests back to back and times the round trip
+    LatencyRecorder latency;
+    vector<thread> pool;
+    vector<string> errors(clients);
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+    for (size_t c = 0; c < clients; ++c)
+    {
+        pool.push_back(thread([&, c]()
+        {
+            try
+            {
+                PricingClient client(path);
+                vector<ContractRecord> batch(contracts);
+                vector<ResultRecord> results;
+
+                for (size_t i = 0; i < requests; ++i)
+                {
+                    for (size_t j = 0; j < contracts; ++j)
+                    { // strikes spread around the spot, Group A batch 1 otherwise
+                        batch[j] = { 60.0 + static_cast<double>((c + i + j) % 20), 0.08, 0.30, 0.25, 0.08, 60.0 };
+                    }
+
+                    OptionTypeCode type = ((c + i) % 2 == 0) ? EUROPEAN_CALL : EUROPEAN_PUT;
+                    chrono::steady_clock::time_point sent = chrono::steady_clock::now();
+                    if (client.Price(type, batch, results) != STATUS_OK)
+                    {
+                        errors[c] = "request rejected";
+                        return;
+                    }
+                    latency.Record(chrono::duration<double, micro>(chrono::steady_clock::now() - sent).count());
+                }
+            }
+            catch (const exception& e)
+            {
+                errors[c] = e.what();
+            }
+        }));
+    }
+
+    for (size_t c = 0; c < clients; ++c) { pool[c].join(); }
+
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    for (size_t c = 0; c < clients; ++c)
+    {
+        if (!errors[c].empty()) { cout << "Client " << c << " failed: " << errors[c] << endl; }
+    }
+
+    double total = static_cast<double>(latency.Count() * contracts);
+    cout << clients << " clients x " << requests << " requests x " << contracts << " contracts in " << seconds << " s" << endl;
+    cout << "Throughput: " << total / seconds << " contracts/s, " << static_cast<double>(latency.Count()) / seconds << " requests/s" << endl;
+    cout << "Round trip p50: " << latency.Percentile(50.0) << " us, p99: " << latency.Percentile(99.0) << " us" << endl;
+}
+
+int main(int argc, char* argv[])
+{
+    string mode = (argc > 1) ? argv[1] : "demo";
+
+    try
+    {
+        if (mode == "serve" && argc > 2)
+        {
+            PricingServer server(argv[2], (argc > 3) ? atoi(argv[3]) : 0, (argc > 4) ? atoi(argv[4]) : 4096, (argc > 5) ? atoi(argv[5]) : 50);
+            server.Start();
+            cout << "Serving on " << argv[2] << ", close stdin to stop." << endl;
+
+            string line;
+            while (getline(cin, line)) { PrintServerStats(server.Stats()); }     // any line prints the stats
+
+            server.Stop();
+            PrintServerStats(server.Stats());
+        }
+        else if (mode == "load" && argc > 2)
+        {
+            RunLoad(argv[2], (argc > 3) ? atoi(argv[3]) : 8, (argc > 4) ? atoi(argv[4]) : 10000, (argc > 5) ? atoi(argv[5]) : 16);
+        }
+        else if (mode == "demo")
+        {
+            string path = "/tmp/pricing_server_demo.sock";
+            PricingServer server(path, 2);
+            server.Start();
+
+            // sanity check against the Group A, Section 1 batch 1 values
+            {
+                PricingClient client(path);
+                vector<ContractRecord> batch = { { 65.0, 0.08, 0.30, 0.25, 0.08, 60.0 } };
+                vector<ResultRecord> call, put;
+                client.Price(EUROPEAN_CALL, batch, call);
+                client.Price(EUROPEAN_PUT, batch, put);
+                cout << "Call = " << call[0].price << " (2.13337), Put = " << put[0].price << " (5.84628)" << endl;
+            }
+
+            RunLoad(path, 8, 2000, 16);
+            server.Stop();
+            PrintServerStats(server.Stats());
+        }
+        else
+        {
+            cout << "Usage: " << argv[0] << " [serve <socket> [workers] [max batch] [linger us] | load <socket> [clients] [requests] [contracts]]" << endl;
+            return 1;
+        }
+    }
+    catch (const exception& e)
+    {
+        cout << "Error: " << e.what() << endl;
+        return 1;
+    }
+
+    return 0;
+}